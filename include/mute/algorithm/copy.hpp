@@ -40,6 +40,10 @@
 
 #include <mute/atom/copy_atom.hpp>
 
+#if defined(MUTE_ENABLE_HOST_COPY) && !defined(__MUSA_ARCH__)
+#include <mute/algorithm/host_copy.hpp>
+#endif
+
 namespace mute
 {
 
@@ -263,6 +267,14 @@ copy(AutoVectorizingCopyWithAssumedAlignment<MaxVecBits> const&,
      Tensor<SrcEngine, SrcLayout>                        const& src,
      Tensor<DstEngine, DstLayout>                             & dst)
 {
+#if defined(MUTE_ENABLE_HOST_COPY) && !defined(__MUSA_ARCH__)
+  if constexpr (detail::use_host_copy<SrcEngine, SrcLayout, DstEngine, DstLayout>) {
+    if (detail::host_copy(src, dst)) {
+      return;
+    }
+  }
+#endif
+
   constexpr int vec_elem = decltype(max_common_vector(src, dst))::value;
 
   constexpr int src_bits = sizeof_bits<typename SrcEngine::value_type>::value;
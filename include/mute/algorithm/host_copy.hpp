@@ -0,0 +1,317 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+#pragma once
+
+#include <mute/config.hpp>
+
+#include <mute/tensor.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//
+// Host execution path of mute::copy for tensors in host memory
+//
+// On the host, copies with dynamic layouts cannot be vectorized at compile time and would
+// otherwise evaluate both layouts element by element. Instead, the flattened modes of src and
+// dst are coalesced at runtime and the copy is split into
+//   * memcpy of the longest run that is contiguous in both tensors,
+//   * cache-blocked 2D tiles when src and dst are contiguous along different modes, or
+//   * a strided loop over the innermost mode otherwise,
+// with the remaining modes iterated around it and, for large tensors, distributed over threads.
+//
+// The host path is opt-in, as it pulls <thread> into every translation unit including
+// mute/algorithm/copy.hpp. Host code copying large tensors with dynamic layouts enables it by
+// defining MUTE_ENABLE_HOST_COPY before including any MuTe header.
+//
+
+namespace mute
+{
+
+namespace detail {
+
+// Bytes a host copy has to move before it is split across threads
+static constexpr int64_t host_copy_parallel_bytes = int64_t(1) << 22;
+
+// Edge length of the tiles of a transposing host copy
+static constexpr int64_t host_copy_block = 32;
+
+template <class Iterator>
+struct is_host_copy_iterator : false_type {};
+template <class T>
+struct is_host_copy_iterator<T*> : true_type {};
+template <class P>
+struct is_host_copy_iterator<gmem_ptr<P>> : is_host_copy_iterator<P> {};
+template <class P>
+struct is_host_copy_iterator<smem_ptr<P>> : is_host_copy_iterator<P> {};
+template <class P>
+struct is_host_copy_iterator<rmem_ptr<P>> : is_host_copy_iterator<P> {};
+
+// Whether a copy between the two tensors may take the host execution path: plain pointers to the
+// same trivially copyable, non-volatile, byte-addressable type, and a layout only known at runtime.
+// Fully static copies are left to the compile-time vectorization of mute::copy.
+template <class SrcEngine, class SrcLayout,
+          class DstEngine, class DstLayout>
+static constexpr bool use_host_copy =
+  not (is_static<SrcLayout>::value && is_static<DstLayout>::value) &&
+  is_host_copy_iterator<typename SrcEngine::iterator>::value &&
+  is_host_copy_iterator<typename DstEngine::iterator>::value &&
+  is_same<typename SrcEngine::value_type, typename DstEngine::value_type>::value &&
+  not is_volatile_v<typename SrcEngine::element_type> &&
+  not is_volatile_v<typename DstEngine::element_type> &&
+  std::is_trivially_copyable<typename DstEngine::value_type>::value &&
+  sizeof_bits_v<typename DstEngine::value_type> % 8 == 0;
+
+// Runtime shape and strides of both tensors after coalescing the modes they share
+template <int R>
+struct HostCopyPlan
+{
+  int     rank = 0;
+  int64_t shape[R + 1] = {};
+  int64_t src_stride[R + 1] = {};
+  int64_t dst_stride[R + 1] = {};
+
+  void append(int64_t s, int64_t src_d, int64_t dst_d) {
+    if (s == 1) {
+      return;
+    }
+    if (rank > 0 && src_d == shape[rank-1] * src_stride[rank-1]
+                 && dst_d == shape[rank-1] * dst_stride[rank-1]) {
+      shape[rank-1] *= s;
+      return;
+    }
+    shape[rank] = s;
+    src_stride[rank] = src_d;
+    dst_stride[rank] = dst_d;
+    ++rank;
+  }
+
+  // Moves mode m to position i, keeping the order of the others
+  void rotate_to(int m, int i) {
+    for (; m > i; --m) {
+      std::swap(shape[m], shape[m-1]);
+      std::swap(src_stride[m], src_stride[m-1]);
+      std::swap(dst_stride[m], dst_stride[m-1]);
+    }
+  }
+
+  // Extent in elements, relative to the tensor's pointer, of the memory a tensor touches
+  void extent(int64_t const* stride, int64_t& lo, int64_t& hi) const {
+    lo = 0;
+    hi = 1;
+    for (int i = 0; i < rank; ++i) {
+      int64_t span = (shape[i] - 1) * stride[i];
+      (span < 0 ? lo : hi) += span;
+    }
+  }
+};
+
+// Applies f(src_offset, dst_offset) to the outer indices [begin, end) of modes [first, rank)
+template <int R, class F>
+void
+host_copy_outer(HostCopyPlan<R> const& plan, int first, int64_t begin, int64_t end, F&& f)
+{
+  int64_t coord[R + 1];
+  int64_t src_offset = 0;
+  int64_t dst_offset = 0;
+  int64_t idx = begin;
+  for (int i = first; i < plan.rank; ++i) {
+    coord[i] = idx % plan.shape[i];
+    idx /= plan.shape[i];
+    src_offset += coord[i] * plan.src_stride[i];
+    dst_offset += coord[i] * plan.dst_stride[i];
+  }
+
+  for (int64_t n = begin; n < end; ++n) {
+    f(src_offset, dst_offset);
+    for (int i = first; i < plan.rank; ++i) {
+      src_offset += plan.src_stride[i];
+      dst_offset += plan.dst_stride[i];
+      if (++coord[i] < plan.shape[i]) {
+        break;
+      }
+      src_offset -= plan.shape[i] * plan.src_stride[i];
+      dst_offset -= plan.shape[i] * plan.dst_stride[i];
+      coord[i] = 0;
+    }
+  }
+}
+
+// Runs the outer loop of a host copy, on several threads if it moves enough bytes
+template <int R, class F>
+void
+host_copy_dispatch(HostCopyPlan<R> const& plan, int first, int64_t bytes, F const& f)
+{
+  int64_t outer = 1;
+  bool dst_broadcasts = false;
+  for (int i = first; i < plan.rank; ++i) {
+    outer *= plan.shape[i];
+  }
+  for (int i = 0; i < plan.rank; ++i) {
+    dst_broadcasts |= plan.dst_stride[i] == 0;
+  }
+
+  int64_t num_threads = 1;
+  // Repeated writes to a dst element must keep their order
+  if (bytes >= host_copy_parallel_bytes && not dst_broadcasts) {
+    num_threads = std::min<int64_t>({int64_t(std::thread::hardware_concurrency()),
+                                     outer,
+                                     bytes / (host_copy_parallel_bytes / 4)});
+  }
+
+  if (num_threads <= 1) {
+    host_copy_outer(plan, first, 0, outer, f);
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads - 1);
+  for (int64_t t = 1; t < num_threads; ++t) {
+    workers.emplace_back([&plan, first, outer, num_threads, t, &f]() {
+      host_copy_outer(plan, first, outer * t / num_threads, outer * (t + 1) / num_threads, f);
+    });
+  }
+  host_copy_outer(plan, first, 0, outer / num_threads, f);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+// Copies src to dst on the host. Returns false, without copying, if the flattened shapes of src
+// and dst differ or the tensors overlap, leaving the copy to the element-wise path.
+template <class SrcEngine, class SrcLayout,
+          class DstEngine, class DstLayout>
+bool
+host_copy(Tensor<SrcEngine, SrcLayout> const& src,
+          Tensor<DstEngine, DstLayout>      & dst)
+{
+  using T = typename DstEngine::value_type;
+
+  auto src_layout = flatten(src.layout());
+  auto dst_layout = flatten(dst.layout());
+  constexpr int R = decltype(rank(src_layout))::value;
+
+  if constexpr (R != decltype(rank(dst_layout))::value) {
+    return false;
+  } else {
+    HostCopyPlan<R> plan;
+    bool congruent = true;
+    for_each(make_seq<R>{}, [&](auto i) {
+      congruent &= int64_t(shape<i>(src_layout)) == int64_t(shape<i>(dst_layout));
+      plan.append(shape<i>(src_layout), stride<i>(src_layout), stride<i>(dst_layout));
+    });
+    if (not congruent) {
+      return false;
+    }
+    if (plan.rank == 0) {
+      plan.shape[0] = plan.src_stride[0] = plan.dst_stride[0] = 1;
+      plan.rank = 1;
+    }
+
+    int64_t const bytes = int64_t(size(src_layout)) * int64_t(sizeof(T));
+    if (bytes == 0) {
+      return true;
+    }
+
+    T const* src_ptr = raw_pointer_cast(src.data());
+    T      * dst_ptr = raw_pointer_cast(dst.data());
+
+    int64_t src_lo, src_hi, dst_lo, dst_hi;
+    plan.extent(plan.src_stride, src_lo, src_hi);
+    plan.extent(plan.dst_stride, dst_lo, dst_hi);
+    auto const src_addr = reinterpret_cast<std::uintptr_t>(src_ptr);
+    auto const dst_addr = reinterpret_cast<std::uintptr_t>(dst_ptr);
+    if (src_addr + src_lo * int64_t(sizeof(T)) < dst_addr + dst_hi * int64_t(sizeof(T)) &&
+        dst_addr + dst_lo * int64_t(sizeof(T)) < src_addr + src_hi * int64_t(sizeof(T))) {
+      return false;
+    }
+
+    // Mode contiguous in dst, then in src, preferring the innermost
+    int dst_unit = -1;
+    int src_unit = -1;
+    for (int i = plan.rank - 1; i >= 0; --i) {
+      if (plan.dst_stride[i] == 1) { dst_unit = i; }
+      if (plan.src_stride[i] == 1) { src_unit = i; }
+    }
+
+    if (dst_unit >= 0 && dst_unit == src_unit) {
+      // Contiguous runs in both tensors
+      plan.rotate_to(dst_unit, 0);
+      int64_t const run_bytes = plan.shape[0] * int64_t(sizeof(T));
+      host_copy_dispatch(plan, 1, bytes, [=](int64_t src_offset, int64_t dst_offset) {
+        std::memcpy(dst_ptr + dst_offset, src_ptr + src_offset, run_bytes);
+      });
+    }
+    else if (dst_unit >= 0 && src_unit >= 0) {
+      // Contiguous along different modes: copy tiles that fit in cache, writing dst in order
+      plan.rotate_to(dst_unit, 0);
+      plan.rotate_to(src_unit + (src_unit < dst_unit ? 1 : 0), 1);
+      int64_t const m = plan.shape[0];
+      int64_t const n = plan.shape[1];
+      int64_t const src_ld = plan.src_stride[0];
+      int64_t const dst_ld = plan.dst_stride[1];
+      host_copy_dispatch(plan, 2, bytes, [=](int64_t src_offset, int64_t dst_offset) {
+        for (int64_t jb = 0; jb < n; jb += host_copy_block) {
+          for (int64_t ib = 0; ib < m; ib += host_copy_block) {
+            int64_t const j_end = std::min(n, jb + host_copy_block);
+            int64_t const i_end = std::min(m, ib + host_copy_block);
+            for (int64_t j = jb; j < j_end; ++j) {
+              for (int64_t i = ib; i < i_end; ++i) {
+                dst_ptr[dst_offset + i + j * dst_ld] = src_ptr[src_offset + i * src_ld + j];
+              }
+            }
+          }
+        }
+      });
+    }
+    else {
+      int64_t const n = plan.shape[0];
+      int64_t const src_d = plan.src_stride[0];
+      int64_t const dst_d = plan.dst_stride[0];
+      host_copy_dispatch(plan, 1, bytes, [=](int64_t src_offset, int64_t dst_offset) {
+        for (int64_t i = 0; i < n; ++i) {
+          dst_ptr[dst_offset + i * dst_d] = src_ptr[src_offset + i * src_d];
+        }
+      });
+    }
+
+    return true;
+  }
+}
+
+} // end namespace detail
+
+} // end namespace mute
@@ -0,0 +1,163 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <mute/config.hpp>
+
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// Host emulation of warp execution
+//
+// Warp-collective instructions such as the MP22 MMAs read the registers of every lane of a warp.
+// On the host, each lane runs on its own std::thread and lanes of the same warp exchange
+// their operands through a HostWarp. A thread is bound to a lane of a warp for the duration of
+// launch_host_warps(), which is what the host paths of those instructions look up.
+//
+
+namespace mute
+{
+
+// Reusable barrier for a fixed number of host threads
+class HostBarrier
+{
+public:
+  explicit HostBarrier(int count) : count_(count) {}
+
+  HostBarrier(HostBarrier const&) = delete;
+  HostBarrier& operator=(HostBarrier const&) = delete;
+
+  int size() const { return count_; }
+
+  void arrive_and_wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t generation = generation_;
+    if (++arrived_ == count_) {
+      arrived_ = 0;
+      ++generation_;
+      cv_.notify_all();
+      return;
+    }
+    cv_.wait(lock, [&] { return generation != generation_; });
+  }
+
+private:
+  std::mutex              mutex_;
+  std::condition_variable cv_;
+  int                     count_;
+  int                     arrived_    = 0;
+  uint64_t                generation_ = 0;
+};
+
+// The lanes of one emulated warp
+class HostWarp
+{
+public:
+  static constexpr int NumLanes = 128;
+
+  // Bytes a lane can contribute to one exchange
+  static constexpr int MaxExchangeBytes = 64;
+
+  // A warp with fewer lanes stands for the partial last warp of a CTA
+  explicit HostWarp(int num_lanes = NumLanes)
+    : barrier_(num_lanes),
+      buffer_(2 * NumLanes * MaxExchangeBytes),
+      phase_(NumLanes, 0) {}
+
+  HostWarp(HostWarp const&) = delete;
+  HostWarp& operator=(HostWarp const&) = delete;
+
+  int size() const { return barrier_.size(); }
+
+  void sync() { barrier_.arrive_and_wait(); }
+
+  // Publishes the bytes of the calling lane and returns the contributions of all lanes, one
+  // MaxExchangeBytes slot per lane in lane order. Every lane of the warp has to take part.
+  // Exchanges alternate between two buffers, so the result stays valid until the lane's next
+  // exchange returns and a single barrier per exchange is enough.
+  void const* exchange(int lane, void const* src, size_t bytes) {
+    assert(bytes <= size_t(MaxExchangeBytes));
+    char* buffer = buffer_.data() + (phase_[lane]++ & 1) * NumLanes * MaxExchangeBytes;
+    std::memcpy(buffer + lane * MaxExchangeBytes, src, bytes);
+    sync();
+    return buffer;
+  }
+
+private:
+  HostBarrier           barrier_;
+  std::vector<char>     buffer_;
+  std::vector<uint64_t> phase_;   // Exchanges done by each lane, only touched by the lane itself
+};
+
+// Warp and lane the calling host thread executes as
+struct HostLane
+{
+  HostWarp* warp = nullptr;
+  int       lane = 0;
+};
+
+inline HostLane&
+host_lane()
+{
+  static thread_local HostLane lane;
+  return lane;
+}
+
+// Runs f(thread_idx) on num_warps * HostWarp::NumLanes host threads, grouped into warps of
+// consecutive thread indices, and returns once all of them have finished
+template <class F>
+void
+launch_host_warps(int num_warps, F&& f)
+{
+  std::vector<HostWarp> warps(num_warps);
+  std::vector<std::thread> threads;
+  threads.reserve(num_warps * HostWarp::NumLanes);
+  for (int thread_idx = 0; thread_idx < num_warps * HostWarp::NumLanes; ++thread_idx) {
+    threads.emplace_back([&, thread_idx] {
+      host_lane() = {&warps[thread_idx / HostWarp::NumLanes], thread_idx % HostWarp::NumLanes};
+      f(thread_idx);
+      host_lane() = {};
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+} // end namespace mute
@@ -40,6 +40,20 @@
 #define MUTE_ARCH_MMA_MP22_ENABLED
 #endif
 
+#if defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+namespace mute {
+namespace detail {
+
+// Host emulation of the MP22 MMAs, see <mute/arch/mma_mp22_host.hpp>
+template <class MMA_Op>
+MUTE_HOST
+void
+mp22_host_fma(int32_t* d, int32_t const* a, int32_t const* b, int32_t const* c);
+
+} // end namespace detail
+} // end namespace mute
+#endif
+
 
 namespace mute {
 
@@ -62,6 +76,8 @@ struct MP22_32x32x16_F32F16F16F32_TT
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_fmma_m32n32k16_mma(d, a, b, c, 0, 0, 0, 0, 1, 0); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x16_F32F16F16F32_TT>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x16_F32F16F16F32_TT without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -85,6 +101,8 @@ struct MP22_32x32x16_F32F16F16F32_TN
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_fmma_m32n32k16_mma(d, a, b, c, 0, 0, 0, 0, 1, 1); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x16_F32F16F16F32_TN>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x16_F32F16F16F32_TN without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -108,6 +126,8 @@ struct MP22_32x32x16_F32F16F16F32_NT
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_fmma_m32n32k16_mma(d, a, b, c, 0, 0, 0, 0, 1, 2); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x16_F32F16F16F32_NT>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x16_F32F16F16F32_NT without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -131,6 +151,8 @@ struct MP22_32x32x16_F32F16F16F32_NN
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_fmma_m32n32k16_mma(d, a, b, c, 0, 0, 0, 0, 1, 3); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x16_F32F16F16F32_NN>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x16_F32F16F16F32_NN without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -158,6 +180,8 @@ struct MP22_32x32x16_F32BF16BF16F32_TT
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_bfmma_m32n32k16_mma(d, a, b, c, 0, 0, 0, 0, 1, 0); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x16_F32BF16BF16F32_TT>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x16_F32BF16BF16F32_TT without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -181,6 +205,8 @@ struct MP22_32x32x16_F32BF16BF16F32_TN
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_bfmma_m32n32k16_mma(d, a, b, c, 0, 0, 0, 0, 1, 1); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x16_F32BF16BF16F32_TN>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x16_F32BF16BF16F32_TN without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -204,6 +230,8 @@ struct MP22_32x32x16_F32BF16BF16F32_NT
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_bfmma_m32n32k16_mma(d, a, b, c, 0, 0, 0, 0, 1, 2); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x16_F32BF16BF16F32_NT>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x16_F32BF16BF16F32_NT without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -227,6 +255,8 @@ struct MP22_32x32x16_F32BF16BF16F32_NN
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_bfmma_m32n32k16_mma(d, a, b, c, 0, 0, 0, 0, 1, 3); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x16_F32BF16BF16F32_NN>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x16_F32BF16BF16F32_NN without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -254,6 +284,8 @@ struct MP22_32x32x8_F32TF32TF32F32_TT
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_tfmma_m32n32k8_mma(d, a, b, c, 0, 0, 0, 0, 1, 0); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x8_F32TF32TF32F32_TT>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x8_F32TF32TF32F32_TT without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -277,6 +309,8 @@ struct MP22_32x32x8_F32TF32TF32F32_TN
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_tfmma_m32n32k8_mma(d, a, b, c, 0, 0, 0, 0, 1, 1); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x8_F32TF32TF32F32_TN>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x8_F32TF32TF32F32_TN without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -300,6 +334,8 @@ struct MP22_32x32x8_F32TF32TF32F32_NT
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_tfmma_m32n32k8_mma(d, a, b, c, 0, 0, 0, 0, 1, 2); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x8_F32TF32TF32F32_NT>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x8_F32TF32TF32F32_NT without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -323,6 +359,8 @@ struct MP22_32x32x8_F32TF32TF32F32_NN
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_tfmma_m32n32k8_mma(d, a, b, c, 0, 0, 0, 0, 1, 3); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x8_F32TF32TF32F32_NN>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x8_F32TF32TF32F32_NN without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -350,6 +388,8 @@ struct MP22_32x32x32_S32S8S8S32_TT
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_imma_m32n32k32_mma(d, a, b, c, 0, 0, 0, 0, 1, 0); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x32_S32S8S8S32_TT>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x32_S32S8S8S32_TT without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -373,6 +413,8 @@ struct MP22_32x32x32_S32S8S8S32_TN
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_imma_m32n32k32_mma(d, a, b, c, 0, 0, 0, 0, 1, 1); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x32_S32S8S8S32_TN>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x32_S32S8S8S32_TN without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -396,6 +438,8 @@ struct MP22_32x32x32_S32S8S8S32_NT
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_imma_m32n32k32_mma(d, a, b, c, 0, 0, 0, 0, 1, 2); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x32_S32S8S8S32_NT>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x32_S32S8S8S32_NT without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
@@ -419,6 +463,8 @@ struct MP22_32x32x32_S32S8S8S32_NN
   {
 #if defined(MUTE_ARCH_MMA_MP22_ENABLED)
     __musa_imma_m32n32k32_mma(d, a, b, c, 0, 0, 0, 0, 1, 3); 
+#elif defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+    detail::mp22_host_fma<MP22_32x32x32_S32S8S8S32_NN>(d, a, b, c);
 #else
     MUTE_INVALID_CONTROL_PATH("Attempting to use MP22_32x32x32_S32S8S8S32_NN without MUTE_ARCH_MMA_MP22_ENABLED");
 #endif
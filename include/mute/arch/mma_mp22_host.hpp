@@ -0,0 +1,186 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <mute/config.hpp>
+
+#include <mute/arch/host_warp.hpp>
+#include <mute/arch/mma_mp22.hpp>
+#include <mute/atom/mma_traits_mp22.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+//
+// Host emulation of the MP22 MMA instructions
+//
+// Each lane of a host warp (see <mute/arch/host_warp.hpp>) publishes its A and B registers, and
+// the A(m,k) and B(n,k) tiles of the instruction are rebuilt from all lanes through the ALayout and
+// BLayout of the MMA_Traits, the same thread-value layouts the device fragments follow. Every lane
+// then computes the elements of D its CLayout assigns to it from its own C registers.
+//
+// Each element of D is accumulated as
+//   d = c;  for k = 0 .. K-1:  d = d + a(m,k) * b(n,k)
+// in the precision of the accumulator, rounding after every addition. The products of f16, bf16
+// and tf32 operands are exact in fp32, so fused and unfused evaluation give the same bits. tf32
+// operands only use the upper 19 bits of their registers, which the conversion to float keeps.
+// Integer accumulation wraps around on overflow.
+//
+// The emulation is opt-in, as it brings <thread> and <condition_variable> into the host pass of
+// every translation unit using MP22 MMAs. Host code enables it by defining
+// MUTE_ENABLE_HOST_MMA_EMULATION before including any MuTe header; otherwise the MMAs remain an
+// invalid control path on the host.
+//
+
+#if !defined(MUTE_ENABLE_HOST_MMA_EMULATION)
+#error "Define MUTE_ENABLE_HOST_MMA_EMULATION before including MuTe headers to emulate MP22 MMAs on the host"
+#endif
+
+namespace mute
+{
+
+namespace detail {
+
+template <class T>
+MUTE_HOST
+auto
+mp22_host_operand(T const& x)
+{
+  if constexpr (is_integral<T>::value) {
+    return int32_t(x);
+  } else {
+    return float(x);
+  }
+}
+
+template <class Acc>
+MUTE_HOST
+Acc
+mp22_host_accumulate(Acc d, Acc p)
+{
+  if constexpr (is_integral<Acc>::value) {
+    return Acc(uint32_t(d) + uint32_t(p));
+  } else {
+    return d + p;
+  }
+}
+
+template <class MMA_Op>
+MUTE_HOST
+void
+mp22_host_fma(int32_t      * d,
+              int32_t const* a,
+              int32_t const* b,
+              int32_t const* c)
+{
+  using Traits = MMA_Traits<MMA_Op>;
+  using ValTypeA = typename Traits::ValTypeA;
+  using ValTypeB = typename Traits::ValTypeB;
+  using ValTypeC = typename Traits::ValTypeC;
+  using ValTypeD = typename Traits::ValTypeD;
+  using Acc      = decltype(mp22_host_operand(ValTypeA{}));
+
+  constexpr int M = size<0>(typename Traits::Shape_MNK{});
+  constexpr int N = size<1>(typename Traits::Shape_MNK{});
+  constexpr int K = size<2>(typename Traits::Shape_MNK{});
+
+  constexpr int RegNumA = extent<typename MMA_Op::ARegisters>::value;
+  constexpr int RegNumB = extent<typename MMA_Op::BRegisters>::value;
+  constexpr int RegNumC = extent<typename MMA_Op::CRegisters>::value;
+  constexpr int RegNumD = extent<typename MMA_Op::DRegisters>::value;
+
+  constexpr int Threads = size(typename Traits::ThrID{});
+  constexpr int ValNumA = size<1>(typename Traits::ALayout{});
+  constexpr int ValNumB = size<1>(typename Traits::BLayout{});
+  constexpr int ValNumC = size<1>(typename Traits::CLayout{});
+
+  static_assert(Threads == HostWarp::NumLanes, "MMA expected to span one warp.");
+  static_assert(sizeof(ValTypeA) * ValNumA == sizeof(int32_t) * RegNumA, "A registers do not match ALayout.");
+  static_assert(sizeof(ValTypeB) * ValNumB == sizeof(int32_t) * RegNumB, "B registers do not match BLayout.");
+  static_assert(sizeof(ValTypeC) * ValNumC == sizeof(int32_t) * RegNumC, "C registers do not match CLayout.");
+  static_assert(sizeof(ValTypeD) * ValNumC == sizeof(int32_t) * RegNumD, "D registers do not match CLayout.");
+  static_assert(is_same<Acc, decltype(mp22_host_operand(ValTypeC{}))>::value, "Unexpected accumulator type.");
+
+  HostLane const& self = host_lane();
+  if (self.warp == nullptr || self.warp->size() != Threads) {
+    MUTE_INVALID_CONTROL_PATH("Attempting to emulate an MP22 MMA outside of a full host warp");
+    return;
+  }
+
+  struct Operands {
+    int32_t a[RegNumA];
+    int32_t b[RegNumB];
+  } operands;
+  static_assert(sizeof(Operands) <= HostWarp::MaxExchangeBytes);
+
+  std::memcpy(operands.a, a, sizeof(operands.a));
+  std::memcpy(operands.b, b, sizeof(operands.b));
+  char const* lanes = static_cast<char const*>(self.warp->exchange(self.lane, &operands, sizeof(operands)));
+
+  Acc tile_a[M * K];
+  Acc tile_b[N * K];
+  for (int t = 0; t < Threads; ++t) {
+    Operands lane;
+    std::memcpy(&lane, lanes + t * HostWarp::MaxExchangeBytes, sizeof(lane));
+
+    ValTypeA vals_a[ValNumA];
+    ValTypeB vals_b[ValNumB];
+    std::memcpy(vals_a, lane.a, sizeof(vals_a));
+    std::memcpy(vals_b, lane.b, sizeof(vals_b));
+    for (int v = 0; v < ValNumA; ++v) {
+      tile_a[typename Traits::ALayout{}(t, v)] = mp22_host_operand(vals_a[v]);
+    }
+    for (int v = 0; v < ValNumB; ++v) {
+      tile_b[typename Traits::BLayout{}(t, v)] = mp22_host_operand(vals_b[v]);
+    }
+  }
+
+  ValTypeC vals_c[ValNumC];
+  ValTypeD vals_d[ValNumC];
+  std::memcpy(vals_c, c, sizeof(vals_c));
+  for (int v = 0; v < ValNumC; ++v) {
+    int mn = typename Traits::CLayout{}(self.lane, v);
+    int m  = mn % M;
+    int n  = mn / M;
+    Acc acc = mp22_host_operand(vals_c[v]);
+    for (int k = 0; k < K; ++k) {
+      acc = mp22_host_accumulate(acc, Acc(tile_a[m + k * M] * tile_b[n + k * N]));
+    }
+    vals_d[v] = ValTypeD(acc);
+  }
+  std::memcpy(d, vals_d, sizeof(vals_d));
+}
+
+} // end namespace detail
+
+} // end namespace mute
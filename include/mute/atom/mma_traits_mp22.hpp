@@ -299,3 +299,7 @@ struct MMA_Traits<MP22_32x32x32_S32S8S8S32_NN>
 };
 
 } // namespace mute
+
+#if defined(MUTE_ENABLE_HOST_MMA_EMULATION) && !defined(__MUSA_ARCH__)
+#include <mute/arch/mma_mp22_host.hpp>
+#endif
@@ -56,4 +56,5 @@ class CollectiveEpilogue {
 #include "detail.hpp"
 #include "default_epilogue.hpp"
 #include "epilogue_tensor_broadcast.hpp"
+#include "epilogue_softmax_stats.hpp"
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,342 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+  \brief Epilogue writing D together with per-row softmax statistics of each N-tile of D.
+*/
+
+#pragma once
+
+#include "mutlass/mutlass.h"
+#include "mutlass/functional.h"
+#include "mutlass/gemm/dispatch_policy.hpp"
+#include "mutlass/epilogue/collective/detail.hpp"
+#include "mutlass/epilogue/thread/softmax_stats.h"
+
+#include "mute/tensor.hpp"
+#include "mute/numeric/numeric_types.hpp"
+#include "mutlass/musa_host_adapter.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace epilogue {
+namespace collective {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Applies an element wise operation to all elements within the fragment, writes them out to
+/// destination storage, and writes the maximum and the sum of exp(D - maximum) of each row of
+/// the CTA tile to a side buffer.
+//
+// The statistics of row m over the columns of N-tile n and batch l are stored at index
+// m + M * (n + tile_count_n(N) * l) of ptr_row_max and ptr_row_sum. They are combined into the
+// statistics of whole rows by device::SoftmaxStatsFinalize, so that a softmax of D needs no
+// further pass over D to find them.
+//
+template <
+  class StrideC_,
+  class StrideD_,
+  class ThreadEpilogueOp_,
+  class EpilogueSchedule_,
+  class CtaTileMNK_
+>
+class EpilogueSoftmaxStats {
+public:
+  //
+  // Type Aliases
+  //
+  using EpilogueSchedule = EpilogueSchedule_;
+  using DispatchPolicy = EpilogueSchedule_;
+
+  // derived types of output thread level operator
+  using ThreadEpilogueOp = ThreadEpilogueOp_;
+  using ElementOutput = typename ThreadEpilogueOp::ElementOutput;
+  using ElementAccumulator = typename ThreadEpilogueOp::ElementAccumulator;
+  using ElementCompute = typename ThreadEpilogueOp::ElementCompute;
+  using ElementScalar = ElementCompute;
+  using ElementC = typename ThreadEpilogueOp::ElementC;
+  using StrideC = StrideC_;
+  using ElementD = typename ThreadEpilogueOp::ElementD;
+  using StrideD = StrideD_;
+  using CtaTileMNK = CtaTileMNK_;
+
+  // Statistics are accumulated with shared memory atomics
+  using ElementStats = float;
+
+  using GmemTiledCopyC = void;
+  using GmemTiledCopyD = void;
+
+  static const int kOutputAlignment = ThreadEpilogueOp::kCount;
+  using AlignmentType = typename mute::uint_bit<sizeof_bits<ElementOutput>::value * kOutputAlignment>::type;
+
+  static_assert(mute::rank(StrideC{}) == 3, "StrideCD must be rank-3: [M, N, L]");
+  static_assert(mute::rank(StrideD{}) == 3, "StrideCD must be rank-3: [M, N, L]");
+  static_assert(mute::is_static<CtaTileMNK>::value, "CtaTileMNK must be static");
+
+  static constexpr int TileM = mute::size<0>(CtaTileMNK{});
+  static constexpr int TileN = mute::size<1>(CtaTileMNK{});
+
+  struct SharedStorage {
+    ElementStats row_max[TileM];
+    ElementStats row_sum[TileM];
+  };
+
+  using TensorStorage = SharedStorage;
+
+  // Host side epilogue arguments
+  struct Arguments {
+    typename ThreadEpilogueOp::Params thread{};
+    ElementC const* ptr_C = nullptr;
+    StrideC dC{};
+    ElementD* ptr_D = nullptr;
+    StrideD dD{};
+    ElementStats* ptr_row_max = nullptr;
+    ElementStats* ptr_row_sum = nullptr;
+  };
+
+  // Device side epilogue params
+  using Params = Arguments;
+
+  //
+  // Methods
+  //
+
+  /// Number of N-tiles of a problem, which is the number of partial statistics of each row
+  MUTLASS_HOST_DEVICE static int
+  tile_count_n(int N) {
+    return (N + TileN - 1) / TileN;
+  }
+
+  template <class ProblemShape>
+  static constexpr Params
+  to_underlying_arguments(
+      [[maybe_unused]] ProblemShape const& _,
+      Arguments const& args,
+      [[maybe_unused]] void* workspace) {
+    return args;
+  }
+
+  template <class ProblemShape>
+  static size_t
+  get_workspace_size(ProblemShape const& problem_shape, Arguments const& args) {
+    return 0;
+  }
+
+  template <class ProblemShape>
+  static mutlass::Status
+  initialize_workspace(ProblemShape const& problem_shape, Arguments const& args, void* workspace, musaStream_t stream,
+    MusaHostAdapter* musa_adapter = nullptr) {
+    return mutlass::Status::kSuccess;
+  }
+
+  template<class ProblemShape>
+  MUTLASS_HOST_DEVICE static bool
+  can_implement(
+      [[maybe_unused]] ProblemShape const& problem_shape,
+      Arguments const& args) {
+    return args.ptr_row_max != nullptr && args.ptr_row_sum != nullptr;
+  }
+
+  MUTLASS_HOST_DEVICE
+  EpilogueSoftmaxStats(Params const& params_, SharedStorage const& shared_storage = SharedStorage())
+      : params(params_), epilogue_op(params_.thread) { }
+
+  MUTLASS_DEVICE
+  bool
+  is_source_needed() {
+    return epilogue_op.is_source_needed();
+  }
+
+  template<
+    class ProblemShapeMNKL,
+    class BlockShapeMNK,
+    class BlockCoordMNKL,
+    class FrgEngine, class FrgLayout,
+    class TiledMma,
+    class ResidueMNK
+  >
+  MUTLASS_DEVICE void
+  operator()(
+      ProblemShapeMNKL problem_shape_mnkl,
+      BlockShapeMNK blk_shape_MNK,
+      BlockCoordMNKL blk_coord_mnkl,
+      mute::Tensor<FrgEngine, FrgLayout> const& accumulators,
+      TiledMma tiled_mma,
+      ResidueMNK residue_mnk,
+      int thread_idx,
+      char* smem_buf)
+  {
+    using namespace mute;
+    using X = Underscore;
+
+    static_assert(mute::rank(ProblemShapeMNKL{}) == 4, "ProblemShapeMNKL must be rank 4");
+    static_assert(is_static<BlockShapeMNK>::value, "ThreadBlock tile shape must be static");
+    static_assert(mute::rank(BlockShapeMNK{}) == 3, "BlockShapeMNK must be rank 3");
+    static_assert(mute::rank(BlockCoordMNKL{}) == 4, "BlockCoordMNKL must be rank 3");
+    static_assert(size<0>(BlockShapeMNK{}) == TileM && size<1>(BlockShapeMNK{}) == TileN,
+      "CtaTileMNK must match the tile shape of the kernel");
+
+    // Separate out problem shape for convenience
+    auto M = get<0>(problem_shape_mnkl);
+    auto N = get<1>(problem_shape_mnkl);
+    auto L = get<3>(problem_shape_mnkl);
+
+    auto stride_c = detail::get_epilogue_stride<EpilogueSchedule>(params.dC);
+    auto stride_d = detail::get_epilogue_stride<EpilogueSchedule>(params.dD);
+
+    // Represent the full output tensor
+    Tensor mC_mnl = make_tensor(make_gmem_ptr(params.ptr_C), make_shape(M,N,L), stride_c);                 // (m,n,l)
+    Tensor mD_mnl = make_tensor(make_gmem_ptr(params.ptr_D), make_shape(M,N,L), stride_d);                 // (m,n,l)
+    Tensor gC_mnl = local_tile(mC_mnl, blk_shape_MNK, make_coord(_,_,_), Step<_1,_1, X>{});    // (BLK_M,BLK_N,m,n,l)
+    Tensor gD_mnl = local_tile(mD_mnl, blk_shape_MNK, make_coord(_,_,_), Step<_1,_1, X>{});    // (BLK_M,BLK_N,m,n,l)
+
+    // Slice to get the tile this CTA is responsible for
+    auto [m_coord, n_coord, k_coord, l_coord] = blk_coord_mnkl;
+    Tensor gC = gC_mnl(_,_,m_coord,n_coord,l_coord);                                                 // (BLK_M,BLK_N)
+    Tensor gD = gD_mnl(_,_,m_coord,n_coord,l_coord);                                                 // (BLK_M,BLK_N)
+
+    // Partition source and destination tiles to match the accumulator partitioning
+    auto thr_mma = tiled_mma.get_thread_slice(thread_idx);
+    Tensor tCgD = thr_mma.partition_C(gD);                                       // (VEC,THR_M,THR_N)
+    Tensor tCgC = thr_mma.partition_C(gC);                                       // (VEC,THR_M,THR_N)
+
+    static_assert(is_static<FrgLayout>::value, "Accumulator layout must be static");
+    MUTE_STATIC_ASSERT_V(size(tCgC) == size(tCgD),
+        "Source and destination must have the same number of elements.");
+    MUTE_STATIC_ASSERT_V(size(tCgD) == size(accumulators),
+        "Accumulator count must have the same destination element count.");
+
+    // Make an identity coordinate tensor for predicating our output MN tile
+    auto cD = make_identity_tensor(make_shape(unwrap(shape<0>(gD)), unwrap(shape<1>(gD))));
+    Tensor tCcD = thr_mma.partition_C(cD);
+    auto residue_mn = make_coord(get<0>(residue_mnk), get<1>(residue_mnk));
+
+    ElementStats const kNegativeInfinity = -platform::numeric_limits<ElementStats>::infinity();
+
+    SharedStorage& storage = *reinterpret_cast<SharedStorage*>(smem_buf);
+
+    // Shared memory may still be read by the mainloop
+    __syncthreads();
+
+    for (int i = thread_idx; i < TileM; i += int(size(tiled_mma))) {
+      storage.row_max[i] = kNegativeInfinity;
+      storage.row_sum[i] = ElementStats(0);
+    }
+
+    //
+    // Compute and store D, keeping the stored values for the statistics
+    //
+
+    Tensor tCrD = make_tensor<ElementStats>(shape(accumulators));                // (VEC,THR_M,THR_N)
+    bool source_needed = epilogue_op.is_source_needed();
+
+    MUTLASS_PRAGMA_UNROLL
+    for (int i = 0; i < size(accumulators); ++i) {
+      tCrD(i) = kNegativeInfinity;
+      if (elem_less(tCcD(i), residue_mn)) {
+        ElementD d = source_needed ? epilogue_op(accumulators(i), tCgC(i)) : epilogue_op(accumulators(i));
+        tCgD(i) = d;
+        tCrD(i) = static_cast<ElementStats>(d);
+      }
+    }
+
+    __syncthreads();
+
+    // The row of an element does not depend on its index along THR_N, so each thread reduces its
+    // elements of a row before combining them with those of other threads
+
+    atomic_maximum<ElementStats> atomic_max_op;
+    atomic_add<ElementStats> atomic_add_op;
+
+    MUTLASS_PRAGMA_UNROLL
+    for (int v = 0; v < size<0>(tCrD); ++v) {
+      MUTLASS_PRAGMA_UNROLL
+      for (int m = 0; m < size<1>(tCrD); ++m) {
+        ElementStats row_max = kNegativeInfinity;
+        MUTLASS_PRAGMA_UNROLL
+        for (int n = 0; n < size<2>(tCrD); ++n) {
+          row_max = tCrD(v,m,n) > row_max ? tCrD(v,m,n) : row_max;
+        }
+        if (row_max != kNegativeInfinity) {
+          atomic_max_op(&storage.row_max[get<0>(tCcD(v,m,0))], row_max);
+        }
+      }
+    }
+
+    __syncthreads();
+
+    MUTLASS_PRAGMA_UNROLL
+    for (int v = 0; v < size<0>(tCrD); ++v) {
+      MUTLASS_PRAGMA_UNROLL
+      for (int m = 0; m < size<1>(tCrD); ++m) {
+        int row = get<0>(tCcD(v,m,0));
+        ElementStats row_max = storage.row_max[row];
+        if (row_max != kNegativeInfinity) {
+          ElementStats row_sum = ElementStats(0);
+          MUTLASS_PRAGMA_UNROLL
+          for (int n = 0; n < size<2>(tCrD); ++n) {
+            row_sum += fast_exp(tCrD(v,m,n) - row_max);
+          }
+          atomic_add_op(&storage.row_sum[row], row_sum);
+        }
+      }
+    }
+
+    __syncthreads();
+
+    //
+    // Store the statistics of the rows of the tile
+    //
+
+    int64_t stats_offset = int64_t(M) * (n_coord + int64_t(tile_count_n(N)) * l_coord) + int64_t(m_coord) * TileM;
+
+    for (int i = thread_idx; i < TileM; i += int(size(tiled_mma))) {
+      if (i < get<0>(residue_mnk)) {
+        params.ptr_row_max[stats_offset + i] = storage.row_max[i];
+        params.ptr_row_sum[stats_offset + i] = storage.row_sum[i];
+      }
+    }
+  }
+
+private:
+  Params params;
+  ThreadEpilogueOp epilogue_op;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace collective
+} // namespace epilogue
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
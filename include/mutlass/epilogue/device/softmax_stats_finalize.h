@@ -0,0 +1,131 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+  \brief Combines the per N-tile row statistics written by EpilogueSoftmaxStats into the
+    statistics of whole rows.
+*/
+
+#pragma once
+
+#include "mutlass/mutlass.h"
+#include "mutlass/epilogue/thread/softmax_stats.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace epilogue {
+namespace device {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// One thread per row of each batch
+template <typename ElementStats>
+__global__ void softmax_stats_finalize(
+  ElementStats const *partial_max,
+  ElementStats const *partial_sum,
+  int M,
+  int tiles_n,
+  int L,
+  ElementStats *row_max,
+  ElementStats *row_sum) {
+
+  int64_t idx = int64_t(blockIdx.x) * blockDim.x + threadIdx.x;
+
+  if (idx >= int64_t(M) * L) {
+    return;
+  }
+
+  int64_t m = idx % M;
+  int64_t l = idx / M;
+
+  thread::SoftmaxStats<ElementStats> stats;
+
+  for (int n = 0; n < tiles_n; ++n) {
+    int64_t offset = m + int64_t(M) * (n + int64_t(tiles_n) * l);
+    stats = thread::SoftmaxStats<ElementStats>::combine(
+      stats, thread::SoftmaxStats<ElementStats>(partial_max[offset], partial_sum[offset]));
+  }
+
+  row_max[idx] = stats.max;
+  row_sum[idx] = stats.sum;
+}
+
+} // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Reduces the (M, tiles_n, L) partial statistics of EpilogueSoftmaxStats to (M, L) row
+/// statistics. Outputs may not alias the partials.
+template <typename ElementStats>
+struct SoftmaxStatsFinalize {
+
+  static int const kThreadsPerBlock = 256;
+
+  Status operator()(
+    ElementStats const *partial_max,
+    ElementStats const *partial_sum,
+    int M,
+    int tiles_n,
+    int L,
+    ElementStats *row_max,
+    ElementStats *row_sum,
+    musaStream_t stream = nullptr) const {
+
+    if (M <= 0 || tiles_n <= 0 || L <= 0) {
+      return Status::kErrorInvalidProblem;
+    }
+
+    if (!partial_max || !partial_sum || !row_max || !row_sum) {
+      return Status::kErrorInvalidProblem;
+    }
+
+    int64_t rows = int64_t(M) * L;
+    dim3 block(kThreadsPerBlock, 1, 1);
+    dim3 grid(int((rows + kThreadsPerBlock - 1) / kThreadsPerBlock), 1, 1);
+
+    detail::softmax_stats_finalize<ElementStats><<< grid, block, 0, stream >>>(
+      partial_max, partial_sum, M, tiles_n, L, row_max, row_sum);
+
+    return musaGetLastError() == musaSuccess ? Status::kSuccess : Status::kErrorInternal;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace device
+} // namespace epilogue
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,101 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+  \brief Running maximum and sum of exponentials of a row, as produced per N-tile by
+    EpilogueSoftmaxStats and combined across tiles to normalize a softmax.
+*/
+
+#pragma once
+
+#include "mutlass/mutlass.h"
+#include "mutlass/fast_math.h"
+#include "mutlass/platform/platform.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace epilogue {
+namespace thread {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Maximum and sum of exp(x - maximum) over a set of values x.
+//
+// Partials of disjoint sets combine as
+//   max = max(max_a, max_b)
+//   sum = sum_a * exp(max_a - max) + sum_b * exp(max_b - max)
+// The empty set is (-inf, 0).
+//
+template <typename Element_>
+struct SoftmaxStats {
+
+  using Element = Element_;
+
+  Element max;
+  Element sum;
+
+  MUTLASS_HOST_DEVICE
+  SoftmaxStats():
+    max(-platform::numeric_limits<Element>::infinity()), sum(Element(0)) { }
+
+  MUTLASS_HOST_DEVICE
+  SoftmaxStats(Element max_, Element sum_): max(max_), sum(sum_) { }
+
+  /// Returns the statistics of the union of two disjoint sets
+  MUTLASS_HOST_DEVICE
+  static SoftmaxStats combine(SoftmaxStats const &a, SoftmaxStats const &b) {
+    if (a.max == -platform::numeric_limits<Element>::infinity()) {
+      return b;
+    }
+    if (b.max == -platform::numeric_limits<Element>::infinity()) {
+      return a;
+    }
+
+    Element max = (a.max < b.max ? b.max : a.max);
+    return SoftmaxStats(max, a.sum * fast_exp(a.max - max) + b.sum * fast_exp(b.max - max));
+  }
+
+  /// Adds a value to the set
+  MUTLASS_HOST_DEVICE
+  void add(Element x) {
+    *this = combine(*this, SoftmaxStats(x, Element(1)));
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace thread
+} // namespace epilogue
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
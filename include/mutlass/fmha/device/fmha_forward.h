@@ -0,0 +1,220 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+  \brief Host side handle launching a fused multi-head attention forward kernel.
+*/
+
+#pragma once
+
+#include "mutlass/mutlass.h"
+#include "mutlass/device_kernel.h"
+
+#if !defined(__MUSACC_RTC__)
+#include "mutlass/trace.h"
+#include <atomic>
+#endif // !defined(__MUSACC_RTC__)
+
+#include "mutlass/fmha/kernel/mp22_fmha_fwd.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass::fmha::device {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  FmhaForward is a stateful, reusable handle built around an attention forward kernel such as
+  mutlass::fmha::kernel::Mp22FmhaForward, in the manner of gemm::device::GemmUniversalAdapter.
+*/
+template <class FmhaKernel_>
+class FmhaForward {
+public:
+  using FmhaKernel = FmhaKernel_;
+  using Element = typename FmhaKernel::Element;
+  using ElementAccumulator = typename FmhaKernel::ElementAccumulator;
+  using ArchTag = typename FmhaKernel::ArchTag;
+  using Arguments = typename FmhaKernel::Arguments;
+  using Params = typename FmhaKernel::Params;
+
+  static constexpr int HeadDim = FmhaKernel::HeadDim;
+  static constexpr int BlockM = FmhaKernel::BlockM;
+  static constexpr int BlockN = FmhaKernel::BlockN;
+  static constexpr int kAlignment = FmhaKernel::Alignment;
+
+private:
+
+  /// Kernel API parameters object
+  Params params_;
+
+public:
+
+  /// Access the Params structure
+  Params const& params() const {
+    return params_;
+  }
+
+  /// Determines whether the kernel can execute the given problem.
+  static Status
+  can_implement(Arguments const& args) {
+    if (FmhaKernel::can_implement(args)) {
+      return Status::kSuccess;
+    }
+    else {
+      return Status::kInvalid;
+    }
+  }
+
+  /// Gets the workspace size
+  static size_t
+  get_workspace_size(Arguments const& args) {
+    return 0;
+  }
+
+  /// Computes the grid shape
+  static dim3
+  get_grid_shape(Params const& params) {
+    return FmhaKernel::get_grid_shape(params);
+  }
+
+  /// Initializes the kernel state from arguments.
+  Status
+  initialize(
+    Arguments const& args,
+    void* workspace = nullptr,
+    musaStream_t stream = nullptr) {
+
+    MUTLASS_TRACE_HOST("FmhaForward::initialize() - workspace "
+      << workspace << ", stream: " << (stream ? "non-null" : "null"));
+
+    params_ = FmhaKernel::to_underlying_arguments(args, workspace);
+    return initialize_function_attributes();
+  }
+
+  /// Sets the dynamic shared memory capacity of the kernel on the current device, once per
+  /// device and kernel type.
+  static Status
+  initialize_function_attributes() {
+    int smem_size = FmhaKernel::SharedStorageSize;
+
+    if (smem_size < (48 << 10)) {
+      return Status::kSuccess;
+    }
+
+    int device_id = 0;
+    musaError_t result = musaGetDevice(&device_id);
+    if (musaSuccess != result) {
+      result = musaGetLastError(); // to clear the error bit
+      MUTLASS_TRACE_HOST("  musaGetDevice() returned error: " << musaGetErrorString(result));
+      return Status::kErrorInternal;
+    }
+
+    static std::atomic<uint64_t> initialized_devices{0};
+    uint64_t const device_mask = device_id < 64 ? (uint64_t(1) << device_id) : 0;
+
+    if (initialized_devices.load(std::memory_order_acquire) & device_mask) {
+      return Status::kSuccess;
+    }
+
+    MUTLASS_TRACE_HOST("  Setting smem size to " << smem_size);
+    result = musaFuncSetAttribute(
+        device_kernel<FmhaKernel>,
+        musaFuncAttributeMaxDynamicSharedMemorySize,
+        smem_size);
+    if (musaSuccess != result) {
+      result = musaGetLastError(); // to clear the error bit
+      MUTLASS_TRACE_HOST("  musaFuncSetAttribute() returned error: " << musaGetErrorString(result));
+      return Status::kErrorInternal;
+    }
+
+    initialized_devices.fetch_or(device_mask, std::memory_order_release);
+    return Status::kSuccess;
+  }
+
+  /// Primary run() entry point API that is static allowing users to create and manage their own params.
+  static Status
+  run(Params& params, musaStream_t stream = nullptr) {
+    MUTLASS_TRACE_HOST("FmhaForward::run()");
+    dim3 const block = FmhaKernel::get_block_shape();
+    dim3 const grid = get_grid_shape(params);
+    int smem_size = FmhaKernel::SharedStorageSize;
+
+    device_kernel<FmhaKernel><<<grid, block, smem_size, stream>>>(params);
+
+    musaError_t result = musaGetLastError();
+    if (musaSuccess == result) {
+      return Status::kSuccess;
+    }
+    else {
+      MUTLASS_TRACE_HOST("  Kernel launch failed. Reason: " << result);
+      return Status::kErrorInternal;
+    }
+  }
+
+  //
+  // Non-static launch overloads that first create and set the internal params struct of this kernel handle.
+  //
+
+  /// Launches the kernel after first constructing Params internal state from supplied arguments.
+  Status
+  run(Arguments const& args, void* workspace = nullptr, musaStream_t stream = nullptr) {
+    Status status = initialize(args, workspace, stream);
+    if (Status::kSuccess == status) {
+      status = run(params_, stream);
+    }
+    return status;
+  }
+
+  /// Launches the kernel after first constructing Params internal state from supplied arguments.
+  Status
+  operator()(Arguments const& args, void* workspace = nullptr, musaStream_t stream = nullptr) {
+    return run(args, workspace, stream);
+  }
+
+  /// Overload that allows a user to re-launch the same kernel without updating internal params struct.
+  Status
+  run(musaStream_t stream = nullptr) {
+    return run(params_, stream);
+  }
+
+  /// Overload that allows a user to re-launch the same kernel without updating internal params struct.
+  Status
+  operator()(musaStream_t stream = nullptr) {
+    return run(params_, stream);
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // namespace mutlass::fmha::device
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,565 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+  \brief Fused multi-head attention forward kernel for MP22.
+*/
+
+#pragma once
+
+#include "mutlass/mutlass.h"
+#include "mutlass/trace.h"
+#include "mutlass/functional.h"
+#include "mutlass/fast_math.h"
+#include "mutlass/numeric_types.h"
+#include "mutlass/platform/platform.h"
+
+#include "mute/tensor.hpp"
+#include "mute/atom/mma_atom.hpp"
+#include "mute/algorithm/gemm.hpp"
+#include "mute/tensor_predicate.hpp"
+
+#include "mutlass/gemm/collective/collective_builder.hpp"
+
+namespace mutlass::fmha::kernel {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// Computes O = softmax(scale * Q K^T) V for every batch and head in a single pass over K and V.
+//
+// Q, K, V and O hold one row of HeadDim elements per token and head, with the head dimension
+// contiguous. Each CTA owns BlockM queries of one head and streams BlockN keys at a time: S is
+// computed with MP22 tensor core atoms, the softmax is kept online by rescaling O and the row
+// sums whenever a row maximum grows, and P is staged through shared memory as Element to feed
+// the second MMA. The row maxima and sums are combined across threads with shared memory
+// atomics, so no thread needs to know which threads share its rows.
+//
+// Sequences either all have seqlen_q queries and seqlen_k keys, or, if cu_seqlens_q and
+// cu_seqlens_k are given, sequence b spans tokens [cu_seqlens[b], cu_seqlens[b + 1]) of the
+// packed tensors. Causal masking is aligned to the bottom right of S, so that query i of a
+// sequence sees key j iff j <= i + seqlen_k - seqlen_q. Heads of K and V are shared by
+// num_heads / num_heads_kv consecutive query heads.
+//
+template <
+  class Element_,
+  int HeadDim_,
+  int BlockM_ = 64,
+  int BlockN_ = 64
+>
+class Mp22FmhaForward {
+public:
+  //
+  // Type Aliases
+  //
+  using Element = Element_;
+  using ElementAccumulator = float;
+  using ArchTag = arch::Mp22;
+
+  static constexpr int HeadDim = HeadDim_;
+  static constexpr int BlockM = BlockM_;
+  static constexpr int BlockN = BlockN_;
+
+  static_assert(mute::is_same_v<Element, half_t> || mute::is_same_v<Element, bfloat16_t>,
+    "Mp22FmhaForward supports half_t and bfloat16_t operands.");
+  static_assert(BlockM % 32 == 0 && BlockN % 32 == 0 && HeadDim % 32 == 0,
+    "Tile sizes must be multiples of the 32x32 MMA atom.");
+
+  // Elements per 128-bit access of Q, K, V and O
+  static constexpr int Alignment = 128 / mute::sizeof_bits_v<Element>;
+
+  // (token, head) strides; the head dimension is contiguous
+  using StrideQKV = mute::Stride<int64_t, int64_t>;
+
+  using TileShapeS = mute::Shape<mute::Int<BlockM>, mute::Int<BlockN>>;
+  using TileShapeO = mute::Shape<mute::Int<BlockM>, mute::Int<HeadDim>>;
+  using TileShapeK = mute::Shape<mute::Int<BlockN>, mute::Int<HeadDim>>;
+  using TileShapeV = mute::Shape<mute::Int<HeadDim>, mute::Int<BlockN>>;
+
+  // One warp group of 32 rows per 32x32 atom along M
+  using AtomLayout = mute::Layout<mute::Shape<mute::Int<BlockM / 32>, mute::_1, mute::_1>>;
+
+  // S = Q K^T: Q (BlockM,HeadDim) and K (BlockN,HeadDim) are both K-major
+  using MmaOpQK = mute::conditional_t<mute::is_same_v<Element, half_t>,
+                                      mute::MP22_32x32x16_F32F16F16F32_TN,
+                                      mute::MP22_32x32x16_F32BF16BF16F32_TN>;
+  // O = P V: P (BlockM,BlockN) is K-major, V viewed as (HeadDim,BlockN) is N-major
+  using MmaOpPV = mute::conditional_t<mute::is_same_v<Element, half_t>,
+                                      mute::MP22_32x32x16_F32F16F16F32_TT,
+                                      mute::MP22_32x32x16_F32BF16BF16F32_TT>;
+
+  using TiledMmaQK = mute::TiledMMA<mute::MMA_Atom<MmaOpQK>, AtomLayout>;
+  using TiledMmaPV = mute::TiledMMA<mute::MMA_Atom<MmaOpPV>, AtomLayout>;
+
+  static constexpr uint32_t MaxThreadsPerBlock = MUTE_STATIC_V(mute::size(TiledMmaQK{}));
+  static constexpr uint32_t MinBlocksPerMultiprocessor = 1;
+  static_assert(MaxThreadsPerBlock == mute::size(TiledMmaPV{}), "Both MMAs must span the CTA.");
+
+  using StrideKMajor  = mute::Stride<int64_t, mute::_1, int64_t>;
+  using StrideMNMajor = mute::Stride<mute::_1, int64_t, int64_t>;
+
+  using SmemLayoutAtomKMajor = decltype(
+    gemm::collective::detail::make_mp22_smem_atom_layout<Element, StrideKMajor>());
+  using SmemLayoutAtomMNMajor = decltype(
+    gemm::collective::detail::make_mp22_smem_atom_layout<Element, StrideMNMajor>());
+
+  using SmemLayoutQ = decltype(mute::tile_to_shape(SmemLayoutAtomKMajor{}, TileShapeO{}));
+  using SmemLayoutK = decltype(mute::tile_to_shape(SmemLayoutAtomKMajor{}, TileShapeK{}));
+  using SmemLayoutV = decltype(mute::tile_to_shape(SmemLayoutAtomMNMajor{}, TileShapeV{}));
+  using SmemLayoutP = decltype(mute::tile_to_shape(SmemLayoutAtomKMajor{}, TileShapeS{}));
+
+  using SmemCopyAtom = mute::Copy_Atom<mute::DefaultCopy, Element>;
+
+  using GmemCopyOp = mute::UniversalCopy<mute::uint_bit_t<Alignment * mute::sizeof_bits_v<Element>>>;
+  using GmemTiledCopyQO = decltype(gemm::collective::detail::make_gmem_tiled_copy<
+    MaxThreadsPerBlock, Element, Alignment, StrideKMajor, BlockM, HeadDim, GmemCopyOp>());
+  using GmemTiledCopyK = decltype(gemm::collective::detail::make_gmem_tiled_copy<
+    MaxThreadsPerBlock, Element, Alignment, StrideKMajor, BlockN, HeadDim, GmemCopyOp>());
+  using GmemTiledCopyV = decltype(gemm::collective::detail::make_gmem_tiled_copy<
+    MaxThreadsPerBlock, Element, Alignment, StrideMNMajor, HeadDim, BlockN, GmemCopyOp>());
+
+  struct SharedStorage {
+    // Q is read into registers once, after which its buffer stages O for the store
+    mute::array_aligned<Element, mute::cosize_v<SmemLayoutQ>> smem_q;
+    mute::array_aligned<Element, mute::cosize_v<SmemLayoutK>> smem_k;
+    mute::array_aligned<Element, mute::cosize_v<SmemLayoutV>> smem_v;
+    mute::array_aligned<Element, mute::cosize_v<SmemLayoutP>> smem_p;
+    ElementAccumulator row_max[BlockM];
+    ElementAccumulator row_sum[BlockM];
+  };
+
+  static constexpr int SharedStorageSize = sizeof(SharedStorage);
+  static constexpr int SmemAlignmentBytes = alignof(SharedStorage);
+
+  // Host and device side arguments
+  struct Arguments {
+    int batch_count = 0;
+    // Queries and keys of every sequence, or their maxima if cu_seqlens_q and cu_seqlens_k are given
+    int seqlen_q = 0;
+    int seqlen_k = 0;
+    int num_heads = 0;
+    int num_heads_kv = 0;
+    Element const* ptr_Q = nullptr;
+    StrideQKV dQ{};
+    Element const* ptr_K = nullptr;
+    StrideQKV dK{};
+    Element const* ptr_V = nullptr;
+    StrideQKV dV{};
+    Element* ptr_O = nullptr;
+    StrideQKV dO{};
+    // batch_count + 1 token offsets of the sequences, or null for sequences of fixed length
+    int const* cu_seqlens_q = nullptr;
+    int const* cu_seqlens_k = nullptr;
+    // Scale of Q K^T before the softmax, 1 / sqrt(HeadDim) unless given
+    ElementAccumulator softmax_scale = ElementAccumulator(1) / ElementAccumulator(mutlass::fast_sqrt(float(HeadDim)));
+    bool causal = false;
+    // If not null, receives logsumexp(scale * Q K^T) of every query at [token * num_heads + head]
+    ElementAccumulator* ptr_LSE = nullptr;
+  };
+
+  // Kernel entry point API
+  using Params = Arguments;
+
+  //
+  // Methods
+  //
+
+  static
+  Params
+  to_underlying_arguments(Arguments const& args, void* workspace = nullptr) {
+    (void) workspace;
+    return args;
+  }
+
+  static bool
+  can_implement(Arguments const& args) {
+    auto is_aligned = [](void const* ptr) {
+      return reinterpret_cast<uintptr_t>(ptr) % (Alignment * sizeof(Element)) == 0;
+    };
+    auto is_aligned_stride = [](StrideQKV const& stride) {
+      return mute::get<0>(stride) % Alignment == 0 && mute::get<1>(stride) % Alignment == 0;
+    };
+
+    bool implementable = args.batch_count > 0 && args.seqlen_q > 0 && args.seqlen_k > 0 &&
+                         args.num_heads > 0 && args.num_heads_kv > 0 &&
+                         args.num_heads % args.num_heads_kv == 0;
+    if (!implementable) {
+      MUTLASS_TRACE_HOST("  CAN IMPLEMENT: Problem size is not supported.\n");
+      return implementable;
+    }
+
+    implementable = args.softmax_scale != ElementAccumulator(0);
+    if (!implementable) {
+      MUTLASS_TRACE_HOST("  CAN IMPLEMENT: softmax_scale must be nonzero.\n");
+      return implementable;
+    }
+
+    implementable = (args.cu_seqlens_q == nullptr) == (args.cu_seqlens_k == nullptr);
+    if (!implementable) {
+      MUTLASS_TRACE_HOST("  CAN IMPLEMENT: cu_seqlens_q and cu_seqlens_k must be given together.\n");
+      return implementable;
+    }
+
+    implementable = is_aligned(args.ptr_Q) && is_aligned(args.ptr_K) &&
+                    is_aligned(args.ptr_V) && is_aligned(args.ptr_O) &&
+                    is_aligned_stride(args.dQ) && is_aligned_stride(args.dK) &&
+                    is_aligned_stride(args.dV) && is_aligned_stride(args.dO);
+    if (!implementable) {
+      MUTLASS_TRACE_HOST("  CAN IMPLEMENT: Q, K, V and O must be aligned to 128 bits.\n");
+    }
+    return implementable;
+  }
+
+  static dim3
+  get_grid_shape(Params const& params) {
+    return dim3(
+      mute::ceil_div(params.seqlen_q, BlockM),
+      params.num_heads,
+      params.batch_count
+    );
+  }
+
+  static dim3
+  get_block_shape() {
+    return dim3(MaxThreadsPerBlock, 1, 1);
+  }
+
+  MUTLASS_DEVICE
+  void
+  operator()(Params const& params, char* smem_buf) {
+    using namespace mute;
+
+    int thread_idx = int(threadIdx.x);
+    int m_block = int(blockIdx.x);
+    int head = int(blockIdx.y);
+    int batch = int(blockIdx.z);
+    int head_kv = head / (params.num_heads / params.num_heads_kv);
+
+    // Tokens of this sequence
+    int64_t offset_q = int64_t(batch) * params.seqlen_q;
+    int64_t offset_k = int64_t(batch) * params.seqlen_k;
+    int seqlen_q = params.seqlen_q;
+    int seqlen_k = params.seqlen_k;
+    if (params.cu_seqlens_q != nullptr) {
+      offset_q = params.cu_seqlens_q[batch];
+      offset_k = params.cu_seqlens_k[batch];
+      seqlen_q = params.cu_seqlens_q[batch + 1] - int(offset_q);
+      seqlen_k = params.cu_seqlens_k[batch + 1] - int(offset_k);
+    }
+
+    // The grid covers the longest sequence
+    if (m_block * BlockM >= seqlen_q) {
+      return;
+    }
+
+    int residue_m = seqlen_q - m_block * BlockM;
+
+    // Key blocks visible to any query of this block
+    int n_block_max = ceil_div(seqlen_k, BlockN);
+    if (params.causal) {
+      int key_limit = (m_block + 1) * BlockM + seqlen_k - seqlen_q;
+      n_block_max = key_limit > 0 ? mute::min(n_block_max, ceil_div(key_limit, BlockN)) : 0;
+    }
+
+    // Represent the tensors of this sequence and head
+    Tensor mQ = make_tensor(
+      make_gmem_ptr(params.ptr_Q + offset_q * get<0>(params.dQ) + head * get<1>(params.dQ)),
+      make_shape(seqlen_q, Int<HeadDim>{}), make_stride(get<0>(params.dQ), _1{}));      // (q,d)
+    Tensor mK = make_tensor(
+      make_gmem_ptr(params.ptr_K + offset_k * get<0>(params.dK) + head_kv * get<1>(params.dK)),
+      make_shape(seqlen_k, Int<HeadDim>{}), make_stride(get<0>(params.dK), _1{}));      // (k,d)
+    Tensor mV = make_tensor(
+      make_gmem_ptr(params.ptr_V + offset_k * get<0>(params.dV) + head_kv * get<1>(params.dV)),
+      make_shape(Int<HeadDim>{}, seqlen_k), make_stride(_1{}, get<0>(params.dV)));      // (d,k)
+    Tensor mO = make_tensor(
+      make_gmem_ptr(params.ptr_O + offset_q * get<0>(params.dO) + head * get<1>(params.dO)),
+      make_shape(seqlen_q, Int<HeadDim>{}), make_stride(get<0>(params.dO), _1{}));      // (q,d)
+
+    Tensor gQ = local_tile(mQ, TileShapeO{}, make_coord(m_block, 0));               // (BLK_M,D)
+    Tensor gO = local_tile(mO, TileShapeO{}, make_coord(m_block, 0));               // (BLK_M,D)
+    Tensor gK = local_tile(mK, TileShapeK{}, make_coord(_, 0));               // (BLK_N,D,n)
+    Tensor gV = local_tile(mV, TileShapeV{}, make_coord(0, _));               // (D,BLK_N,n)
+
+    // Construct shared memory tiles
+    SharedStorage& storage = *reinterpret_cast<SharedStorage*>(smem_buf);
+    Tensor sQ = make_tensor(make_smem_ptr(storage.smem_q.data()), SmemLayoutQ{});  // (BLK_M,D)
+    Tensor sK = make_tensor(make_smem_ptr(storage.smem_k.data()), SmemLayoutK{});  // (BLK_N,D)
+    Tensor sV = make_tensor(make_smem_ptr(storage.smem_v.data()), SmemLayoutV{});  // (D,BLK_N)
+    Tensor sP = make_tensor(make_smem_ptr(storage.smem_p.data()), SmemLayoutP{});  // (BLK_M,BLK_N)
+
+    //
+    // Global memory copies
+    //
+
+    GmemTiledCopyQO gmem_tiled_copy_qo;
+    GmemTiledCopyK gmem_tiled_copy_k;
+    GmemTiledCopyV gmem_tiled_copy_v;
+    auto gmem_thr_copy_qo = gmem_tiled_copy_qo.get_slice(thread_idx);
+    auto gmem_thr_copy_k = gmem_tiled_copy_k.get_slice(thread_idx);
+    auto gmem_thr_copy_v = gmem_tiled_copy_v.get_slice(thread_idx);
+
+    Tensor tQgQ = gmem_thr_copy_qo.partition_S(gQ);                            // (QCPY,QCPY_M,QCPY_D)
+    Tensor tQsQ = gmem_thr_copy_qo.partition_D(sQ);                            // (QCPY,QCPY_M,QCPY_D)
+    Tensor tKgK = gmem_thr_copy_k.partition_S(gK);                             // (KCPY,KCPY_N,KCPY_D,n)
+    Tensor tKsK = gmem_thr_copy_k.partition_D(sK);                             // (KCPY,KCPY_N,KCPY_D)
+    Tensor tVgV = gmem_thr_copy_v.partition_S(gV);                             // (VCPY,VCPY_D,VCPY_N,n)
+    Tensor tVsV = gmem_thr_copy_v.partition_D(sV);                             // (VCPY,VCPY_D,VCPY_N)
+
+    // K and V of the next block are loaded into registers while the current block is computed
+    Tensor tQrQ = make_fragment_like(tQsQ);
+    Tensor tKrK = make_fragment_like(tKsK);
+    Tensor tVrV = make_fragment_like(tVsV);
+
+    // Predicates on the token modes
+    Tensor tQpQ = make_tensor<bool>(make_shape(size<1>(tQsQ), size<2>(tQsQ)), Stride<_1,_0>{});
+    Tensor tKpK = make_tensor<bool>(make_shape(size<1>(tKsK), size<2>(tKsK)), Stride<_1,_0>{});
+    Tensor tVpV = make_tensor<bool>(make_shape(size<1>(tVsV), size<2>(tVsV)), Stride<_0,_1>{});
+
+    Tensor tQcQ = gmem_thr_copy_qo.partition_S(make_identity_tensor(TileShapeO{}));   // -> (blk_m,d)
+    Tensor tKcK = gmem_thr_copy_k.partition_S(make_identity_tensor(TileShapeK{}));    // -> (blk_n,d)
+    Tensor tVcV = gmem_thr_copy_v.partition_S(make_identity_tensor(TileShapeV{}));    // -> (d,blk_n)
+
+    auto load_kv = [&](int n_block) {
+      int residue_n = seqlen_k - n_block * BlockN;
+      MUTLASS_PRAGMA_UNROLL
+      for (int n = 0; n < size<0>(tKpK); ++n) {
+        tKpK(n,0) = get<0>(tKcK(0,n,0)) < residue_n;
+      }
+      MUTLASS_PRAGMA_UNROLL
+      for (int n = 0; n < size<1>(tVpV); ++n) {
+        tVpV(0,n) = get<1>(tVcV(0,0,n)) < residue_n;
+      }
+      // Keys past the sequence read as zero so that they contribute nothing to O
+      clear(tKrK);
+      clear(tVrV);
+      copy_if(gmem_tiled_copy_k, tKpK, tKgK(_,_,_,n_block), tKrK);
+      copy_if(gmem_tiled_copy_v, tVpV, tVgV(_,_,_,n_block), tVrV);
+    };
+
+    MUTLASS_PRAGMA_UNROLL
+    for (int m = 0; m < size<0>(tQpQ); ++m) {
+      tQpQ(m,0) = get<0>(tQcQ(0,m,0)) < residue_m;
+    }
+    clear(tQrQ);
+    copy_if(gmem_tiled_copy_qo, tQpQ, tQgQ, tQrQ);
+    if (n_block_max > 0) {
+      load_kv(0);
+    }
+
+    //
+    // MMA partitions
+    //
+
+    TiledMmaQK tiled_mma_qk;
+    TiledMmaPV tiled_mma_pv;
+    auto thr_mma_qk = tiled_mma_qk.get_thread_slice(thread_idx);
+    auto thr_mma_pv = tiled_mma_pv.get_thread_slice(thread_idx);
+
+    Tensor tSrQ = thr_mma_qk.partition_fragment_A(sQ);                         // (MMA,MMA_M,MMA_D)
+    Tensor tSrK = thr_mma_qk.partition_fragment_B(sK);                         // (MMA,MMA_N,MMA_D)
+    Tensor tOrP = thr_mma_pv.partition_fragment_A(sP);                         // (MMA,MMA_M,MMA_N)
+    Tensor tOrV = thr_mma_pv.partition_fragment_B(sV);                         // (MMA,MMA_D,MMA_N)
+
+    auto smem_thr_copy_q = make_tiled_copy_A(SmemCopyAtom{}, tiled_mma_qk).get_thread_slice(thread_idx);
+    auto smem_thr_copy_k = make_tiled_copy_B(SmemCopyAtom{}, tiled_mma_qk).get_thread_slice(thread_idx);
+    auto smem_thr_copy_p = make_tiled_copy_A(SmemCopyAtom{}, tiled_mma_pv).get_thread_slice(thread_idx);
+    auto smem_thr_copy_v = make_tiled_copy_B(SmemCopyAtom{}, tiled_mma_pv).get_thread_slice(thread_idx);
+
+    Tensor tSsQ = smem_thr_copy_q.partition_S(sQ);
+    Tensor tSrQ_copy_view = smem_thr_copy_q.retile_D(tSrQ);
+    Tensor tSsK = smem_thr_copy_k.partition_S(sK);
+    Tensor tSrK_copy_view = smem_thr_copy_k.retile_D(tSrK);
+    Tensor tOsP = smem_thr_copy_p.partition_S(sP);
+    Tensor tOrP_copy_view = smem_thr_copy_p.retile_D(tOrP);
+    Tensor tOsV = smem_thr_copy_v.partition_S(sV);
+    Tensor tOrV_copy_view = smem_thr_copy_v.retile_D(tOrV);
+
+    Tensor acc_s = partition_fragment_C(tiled_mma_qk, TileShapeS{});           // (MMA,MMA_M,MMA_N)
+    Tensor acc_o = partition_fragment_C(tiled_mma_pv, TileShapeO{});           // (MMA,MMA_M,MMA_D)
+    clear(acc_o);
+
+    // Both accumulators are partitioned by the same atom layout, so (MMA,MMA_M) names the same row
+    Tensor tScS = thr_mma_qk.partition_C(make_identity_tensor(TileShapeS{}));  // -> (blk_m,blk_n)
+    Tensor tSsP = thr_mma_qk.partition_C(sP);                                  // (MMA,MMA_M,MMA_N)
+    MUTE_STATIC_ASSERT_V(size<0>(acc_s) == size<0>(acc_o));                    // MMA
+    MUTE_STATIC_ASSERT_V(size<1>(acc_s) == size<1>(acc_o));                    // MMA_M
+
+    // Running maximum and partial sum of the rows of (MMA,MMA_M)
+    Tensor row_max = make_tensor<ElementAccumulator>(make_shape(size<0>(acc_s), size<1>(acc_s)));
+    Tensor row_sum = make_tensor<ElementAccumulator>(make_shape(size<0>(acc_s), size<1>(acc_s)));
+
+    ElementAccumulator const kNegativeInfinity = -platform::numeric_limits<ElementAccumulator>::infinity();
+    fill(row_max, kNegativeInfinity);
+    clear(row_sum);
+
+    for (int i = thread_idx; i < BlockM; i += MaxThreadsPerBlock) {
+      storage.row_max[i] = kNegativeInfinity;
+      storage.row_sum[i] = ElementAccumulator(0);
+    }
+
+    copy(tQrQ, tQsQ);
+    __syncthreads();
+    copy(tSsQ, tSrQ_copy_view);
+
+    atomic_maximum<ElementAccumulator> atomic_max_op;
+    atomic_add<ElementAccumulator> atomic_add_op;
+
+    //
+    // Mainloop over the key blocks
+    //
+
+    for (int n_block = 0; n_block < n_block_max; ++n_block) {
+      copy(tKrK, tKsK);
+      copy(tVrV, tVsV);
+      __syncthreads();
+
+      if (n_block + 1 < n_block_max) {
+        load_kv(n_block + 1);
+      }
+
+      // S = Q K^T
+      copy(tSsK, tSrK_copy_view);
+      clear(acc_s);
+      mute::gemm(tiled_mma_qk, acc_s, tSrQ, tSrK, acc_s);
+
+      // Scale, mask keys past the sequence and, if causal, keys after the query
+      int key_limit = seqlen_k - n_block * BlockN;
+      int causal_offset = m_block * BlockM - n_block * BlockN + seqlen_k - seqlen_q;
+      MUTLASS_PRAGMA_UNROLL
+      for (int i = 0; i < size(acc_s); ++i) {
+        int m = get<0>(tScS(i));
+        int n = get<1>(tScS(i));
+        bool masked = n >= key_limit || (params.causal && n > m + causal_offset);
+        acc_s(i) = masked ? kNegativeInfinity : acc_s(i) * params.softmax_scale;
+      }
+
+      // Grow the row maxima
+      MUTLASS_PRAGMA_UNROLL
+      for (int m = 0; m < size<1>(acc_s); ++m) {
+        MUTLASS_PRAGMA_UNROLL
+        for (int v = 0; v < size<0>(acc_s); ++v) {
+          ElementAccumulator local_max = kNegativeInfinity;
+          MUTLASS_PRAGMA_UNROLL
+          for (int n = 0; n < size<2>(acc_s); ++n) {
+            local_max = mutlass::fast_max(local_max, acc_s(v,m,n));
+          }
+          if (local_max > row_max(v,m)) {
+            atomic_max_op(&storage.row_max[get<0>(tScS(v,m,0))], local_max);
+          }
+        }
+      }
+      __syncthreads();
+
+      // Rescale O and the row sums to the new maxima and compute P
+      MUTLASS_PRAGMA_UNROLL
+      for (int m = 0; m < size<1>(acc_s); ++m) {
+        MUTLASS_PRAGMA_UNROLL
+        for (int v = 0; v < size<0>(acc_s); ++v) {
+          ElementAccumulator max_new = storage.row_max[get<0>(tScS(v,m,0))];
+          ElementAccumulator scale = row_max(v,m) == kNegativeInfinity ?
+            ElementAccumulator(0) : fast_exp(row_max(v,m) - max_new);
+          // Rows without any visible key so far keep P at zero
+          ElementAccumulator max_base = max_new == kNegativeInfinity ? ElementAccumulator(0) : max_new;
+          row_max(v,m) = max_new;
+          row_sum(v,m) *= scale;
+
+          MUTLASS_PRAGMA_UNROLL
+          for (int d = 0; d < size<2>(acc_o); ++d) {
+            acc_o(v,m,d) *= scale;
+          }
+          MUTLASS_PRAGMA_UNROLL
+          for (int n = 0; n < size<2>(acc_s); ++n) {
+            ElementAccumulator p = fast_exp(acc_s(v,m,n) - max_base);
+            row_sum(v,m) += p;
+            tSsP(v,m,n) = Element(p);
+          }
+        }
+      }
+      __syncthreads();
+
+      // O += P V
+      copy(tOsP, tOrP_copy_view);
+      copy(tOsV, tOrV_copy_view);
+      mute::gemm(tiled_mma_pv, acc_o, tOrP, tOrV, acc_o);
+      __syncthreads();
+    }
+
+    //
+    // Epilogue
+    //
+
+    // Combine the partial row sums of all threads
+    MUTLASS_PRAGMA_UNROLL
+    for (int m = 0; m < size<1>(acc_s); ++m) {
+      MUTLASS_PRAGMA_UNROLL
+      for (int v = 0; v < size<0>(acc_s); ++v) {
+        if (row_sum(v,m) != ElementAccumulator(0)) {
+          atomic_add_op(&storage.row_sum[get<0>(tScS(v,m,0))], row_sum(v,m));
+        }
+      }
+    }
+    __syncthreads();
+
+    // Normalize O and stage it through the buffer of Q for 128-bit stores
+    Tensor tOsO = thr_mma_pv.partition_C(sQ);                                  // (MMA,MMA_M,MMA_D)
+    MUTLASS_PRAGMA_UNROLL
+    for (int m = 0; m < size<1>(acc_o); ++m) {
+      MUTLASS_PRAGMA_UNROLL
+      for (int v = 0; v < size<0>(acc_o); ++v) {
+        ElementAccumulator sum = storage.row_sum[get<0>(tScS(v,m,0))];
+        ElementAccumulator inv_sum = sum > ElementAccumulator(0) ?
+          ElementAccumulator(1) / sum : ElementAccumulator(0);
+        MUTLASS_PRAGMA_UNROLL
+        for (int d = 0; d < size<2>(acc_o); ++d) {
+          tOsO(v,m,d) = Element(acc_o(v,m,d) * inv_sum);
+        }
+      }
+    }
+    __syncthreads();
+
+    copy(tQsQ, tQrQ);
+    Tensor tOgO = gmem_thr_copy_qo.partition_D(gO);                            // (QCPY,QCPY_M,QCPY_D)
+    copy_if(gmem_tiled_copy_qo, tQpQ, tQrQ, tOgO);
+
+    if (params.ptr_LSE != nullptr) {
+      for (int i = thread_idx; i < mute::min(BlockM, residue_m); i += MaxThreadsPerBlock) {
+        ElementAccumulator sum = storage.row_sum[i];
+        int64_t token = offset_q + m_block * BlockM + i;
+        params.ptr_LSE[token * params.num_heads + head] = sum > ElementAccumulator(0) ?
+          storage.row_max[i] + fast_log(sum) : kNegativeInfinity;
+      }
+    }
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace mutlass::fmha::kernel
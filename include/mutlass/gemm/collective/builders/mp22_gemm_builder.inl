@@ -64,6 +64,20 @@ constexpr auto make_mp22_smem_atom_layout() {
   }
 };
 
+// Composes the MP22 shared memory atom of an operand with the swizzle the user provides for it.
+template <class SmemSwizzleType, bool IsOperandA, class Element, class StrideAB>
+constexpr auto
+make_mp22_smem_atom_layout_or_override() {
+  if constexpr (mute::is_same_v<SmemSwizzleType, SmemSwizzleAuto>) {
+    return make_mp22_smem_atom_layout<Element, StrideAB>();
+  }
+  else {
+    using Swizzle = mute::conditional_t<IsOperandA, typename SmemSwizzleType::SwizzleA,
+                                                    typename SmemSwizzleType::SwizzleB>;
+    return composition(Swizzle{}, make_mp22_smem_atom_layout<Element, StrideAB>());
+  }
+}
+
 template <
   class ElementA, class StrideA,
   class ElementB, class StrideB>
@@ -347,7 +361,8 @@ template <
   class AtomLayout,
   class PermuteLayoutType,
   class StageCountType,
-  class KernelScheduleType
+  class KernelScheduleType,
+  class SmemSwizzleType
 >
 struct CollectiveBuilder<
   arch::Mp22,
@@ -364,7 +379,8 @@ struct CollectiveBuilder<
   AtomLayout,
   PermuteLayoutType,
   StageCountType,
-  KernelScheduleType
+  KernelScheduleType,
+  SmemSwizzleType
 > {
   static_assert(is_static<TileShape_MNK>::value, "TileShape must be static");
   static_assert(is_static<ClusterShape_MNK>::value, "ClusterShape must be static");
@@ -390,14 +406,16 @@ struct CollectiveBuilder<
   static constexpr int ThreadCount = size(TiledMma{});
 
   // A
-  using SmemLayoutAtomA = decltype(detail::make_mp22_smem_atom_layout<MmaElementA, StrideA>());
+  using SmemLayoutAtomA = decltype(detail::make_mp22_smem_atom_layout_or_override<
+                                    SmemSwizzleType, true, MmaElementA, StrideA>());
   using SmemCopyAtomA = Copy_Atom<DefaultCopy, MmaElementA>;
   using GmemTiledCopyA = decltype(detail::make_gmem_tiled_copy<
                                     ThreadCount, MmaElementA, AlignmentA, StrideA,
                                     BlockM, BlockK,
                                     UniversalCopy<uint_bit_t<AlignmentA*sizeof_bits_v<MmaElementA>>>>());
   // B
-  using SmemLayoutAtomB = decltype(detail::make_mp22_smem_atom_layout<MmaElementB, StrideB>());
+  using SmemLayoutAtomB = decltype(detail::make_mp22_smem_atom_layout_or_override<
+                                    SmemSwizzleType, false, MmaElementB, StrideB>());
   using SmemCopyAtomB = Copy_Atom<DefaultCopy, MmaElementB>;
   using GmemTiledCopyB = decltype(detail::make_gmem_tiled_copy<
                                     ThreadCount, MmaElementB, AlignmentB, StrideB,
@@ -55,6 +55,18 @@ struct KernelScheduleAuto {};
 // Can be overridden with mute::Tile
 struct PermuteLayoutAuto {};
 
+// Used to let the builder pick the shared memory layout atoms of A and B.
+// Can be overridden with SmemSwizzle
+struct SmemSwizzleAuto {};
+
+// Swizzles, e.g. mute::Swizzle<B,M,S>, the builder composes with its shared memory
+// layout atoms of A and B. mute::Swizzle<0,M,S> leaves the atom unswizzled.
+template <class SwizzleA_, class SwizzleB_>
+struct SmemSwizzle {
+  using SwizzleA = SwizzleA_;
+  using SwizzleB = SwizzleB_;
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <
@@ -73,6 +85,7 @@ template <
   class PermuteLayoutType,
   class StageCountType,
   class KernelScheduleType,
+  class SmemSwizzleType = SmemSwizzleAuto,
   class Enable = void
 >
 struct CollectiveBuilder {
@@ -48,6 +48,7 @@
 #if !defined(__MUSACC_RTC__)
 //#include "mutlass/cluster_launch.hpp"
 #include "mutlass/trace.h"
+#include <atomic>
 #endif // !defined(__MUSACC_RTC__)
 
 #include "mutlass/gemm/threadblock/threadblock_swizzle.h" // placeholder for thread block swizzle
@@ -235,24 +236,12 @@ public:
     int smem_size = GemmKernel::SharedStorageSize;
 
     // first, account for dynamic smem capacity if needed
-    musaError_t result;
-    if (smem_size >= (48 << 10)) {
-      MUTLASS_TRACE_HOST("  Setting smem size to " << smem_size);
-      result = musaFuncSetAttribute(
-          device_kernel<GemmKernel>,
-          musaFuncAttributeMaxDynamicSharedMemorySize,
-          smem_size);
-      if (musaSuccess != result) {
-        result = musaGetLastError(); // to clear the error bit
-        MUTLASS_TRACE_HOST(
-          "  musaFuncSetAttribute() returned error: "
-          << musaGetErrorString(result));
-        return -1;
-      }
+    if (initialize_function_attributes() != Status::kSuccess) {
+      return -1;
     }
 
     // query occupancy after setting smem size
-    result = musaOccupancyMaxActiveBlocksPerMultiprocessor(
+    musaError_t result = musaOccupancyMaxActiveBlocksPerMultiprocessor(
         &max_active_blocks,
         device_kernel<GemmKernel>,
         GemmKernel::MaxThreadsPerBlock,
@@ -294,26 +283,54 @@ public:
       return Status::kSuccess;
     }
     else {
+      MUTLASS_ASSERT(musa_adapter == nullptr);
+
       //
       // Account for dynamic smem capacity if needed
       //
-      int smem_size = GemmKernel::SharedStorageSize;
+      return initialize_function_attributes();
+    }
+  }
 
-      MUTLASS_ASSERT(musa_adapter == nullptr);
+  /// Sets the function attributes the kernel needs to launch on the current device, i.e. its
+  /// dynamic shared memory capacity. The attributes are set once per device and kernel type;
+  /// later calls return without reaching the runtime.
+  static Status
+  initialize_function_attributes() {
+    int smem_size = GemmKernel::SharedStorageSize;
 
-      if (smem_size >= (48 << 10)) {
-        MUTLASS_TRACE_HOST("  Setting smem size to " << smem_size);
-        musaError_t result = musaFuncSetAttribute(
-            device_kernel<GemmKernel>,
-            musaFuncAttributeMaxDynamicSharedMemorySize,
-            smem_size);
-        if (musaSuccess != result) {
-          result = musaGetLastError(); // to clear the error bit
-          MUTLASS_TRACE_HOST("  musaFuncSetAttribute() returned error: " << musaGetErrorString(result));
-          return Status::kErrorInternal;
-        }
-      }
+    if (smem_size < (48 << 10)) {
+      return Status::kSuccess;
+    }
+
+    int device_id = 0;
+    musaError_t result = musaGetDevice(&device_id);
+    if (musaSuccess != result) {
+      result = musaGetLastError(); // to clear the error bit
+      MUTLASS_TRACE_HOST("  musaGetDevice() returned error: " << musaGetErrorString(result));
+      return Status::kErrorInternal;
+    }
+
+    // Devices beyond the width of the mask are not cached and set the attribute on every call
+    static std::atomic<uint64_t> initialized_devices{0};
+    uint64_t const device_mask = device_id < 64 ? (uint64_t(1) << device_id) : 0;
+
+    if (initialized_devices.load(std::memory_order_acquire) & device_mask) {
+      return Status::kSuccess;
     }
+
+    MUTLASS_TRACE_HOST("  Setting smem size to " << smem_size);
+    result = musaFuncSetAttribute(
+        device_kernel<GemmKernel>,
+        musaFuncAttributeMaxDynamicSharedMemorySize,
+        smem_size);
+    if (musaSuccess != result) {
+      result = musaGetLastError(); // to clear the error bit
+      MUTLASS_TRACE_HOST("  musaFuncSetAttribute() returned error: " << musaGetErrorString(result));
+      return Status::kErrorInternal;
+    }
+
+    initialized_devices.fetch_or(device_mask, std::memory_order_release);
     return Status::kSuccess;
   }
 
@@ -331,6 +348,22 @@ public:
     return Status::kSuccess;
   }
 
+  /// Replaces the operand pointers of a params struct, leaving the problem shape, strides and
+  /// epilogue scalars as they were lowered by GemmKernel::to_underlying_arguments(). The new
+  /// pointers must satisfy the alignment the params were validated with.
+  static void
+  update_pointers(
+    Params& params,
+    ElementA const* ptr_A,
+    ElementB const* ptr_B,
+    ElementC const* ptr_C,
+    ElementD* ptr_D) {
+    params.mainloop.ptr_A = ptr_A;
+    params.mainloop.ptr_B = ptr_B;
+    params.epilogue.ptr_C = ptr_C;
+    params.epilogue.ptr_D = ptr_D;
+  }
+
   /// Primary run() entry point API that is static allowing users to create and manage their own params.
   /// Supplied params struct must be construct by calling GemmKernel::to_underling_arguments()
   static Status
@@ -376,6 +409,66 @@ public:
     }
   }
 
+  /// Adds a launch of the kernel with the supplied params to a user-owned graph.
+  ///
+  /// Like the static run(), which may equally be recorded by stream capture, this performs no
+  /// host synchronization. initialize() must have been called once beforehand so that the
+  /// kernel's function attributes are set. The params are copied into the node.
+  static Status
+  add_graph_node(
+    Params const& params,
+    musaGraph_t graph,
+    musaGraphNode_t* node,
+    musaGraphNode_t const* dependencies = nullptr,
+    size_t num_dependencies = 0) {
+    MUTLASS_TRACE_HOST("GemmUniversal::add_graph_node()");
+
+    // Launches through the host adapter are opaque and cannot be added as kernel nodes
+    if constexpr (kEnableMusaHostAdapter) {
+      return Status::kErrorNotSupported;
+    }
+    else {
+      musaKernelNodeParams node_params = make_kernel_node_params(params);
+      void* kernel_params[] = {const_cast<Params*>(&params)};
+      node_params.kernelParams = kernel_params;
+
+      musaError_t result = musaGraphAddKernelNode(node, graph, dependencies, num_dependencies, &node_params);
+      if (musaSuccess != result) {
+        result = musaGetLastError(); // to clear the error bit
+        MUTLASS_TRACE_HOST("  musaGraphAddKernelNode() returned error: " << musaGetErrorString(result));
+        return Status::kErrorInternal;
+      }
+      return Status::kSuccess;
+    }
+  }
+
+  /// Replaces the params of a node added by add_graph_node() in an instantiated graph, e.g. to
+  /// point it at new operands before the next replay. The grid shape must not change.
+  static Status
+  update_graph_node(
+    Params const& params,
+    musaGraphExec_t graph_exec,
+    musaGraphNode_t node) {
+    MUTLASS_TRACE_HOST("GemmUniversal::update_graph_node()");
+
+    if constexpr (kEnableMusaHostAdapter) {
+      return Status::kErrorNotSupported;
+    }
+    else {
+      musaKernelNodeParams node_params = make_kernel_node_params(params);
+      void* kernel_params[] = {const_cast<Params*>(&params)};
+      node_params.kernelParams = kernel_params;
+
+      musaError_t result = musaGraphExecKernelNodeSetParams(graph_exec, node, &node_params);
+      if (musaSuccess != result) {
+        result = musaGetLastError(); // to clear the error bit
+        MUTLASS_TRACE_HOST("  musaGraphExecKernelNodeSetParams() returned error: " << musaGetErrorString(result));
+        return Status::kErrorInternal;
+      }
+      return Status::kSuccess;
+    }
+  }
+
   //
   // Non-static launch overloads that first create and set the internal params struct of this kernel handle.
   //
@@ -406,6 +499,18 @@ public:
     return run(args, workspace, stream, musa_adapter);
   }
 
+  /// Replaces the operand pointers of the internal params struct set by initialize(). Together with
+  /// the run() overload below, this relaunches the same GEMM on new operands without validating,
+  /// lowering the arguments or setting function attributes again.
+  void
+  update_pointers(
+    ElementA const* ptr_A,
+    ElementB const* ptr_B,
+    ElementC const* ptr_C,
+    ElementD* ptr_D) {
+    update_pointers(params_, ptr_A, ptr_B, ptr_C, ptr_D);
+  }
+
   /// Overload that allows a user to re-launch the same kernel without updating internal params struct.
   Status
   run(musaStream_t stream = nullptr, MusaHostAdapter *musa_adapter = nullptr) {
@@ -417,6 +522,31 @@ public:
   operator()(musaStream_t stream = nullptr, MusaHostAdapter *musa_adapter = nullptr) {
     return run(params_, stream, musa_adapter);
   }
+
+  /// Adds a launch of the kernel with the internal params struct to a user-owned graph.
+  Status
+  add_graph_node(
+    musaGraph_t graph,
+    musaGraphNode_t* node,
+    musaGraphNode_t const* dependencies = nullptr,
+    size_t num_dependencies = 0) const {
+    return add_graph_node(params_, graph, node, dependencies, num_dependencies);
+  }
+
+private:
+
+  /// Describes a launch of the kernel, leaving kernelParams to be set by the caller
+  static musaKernelNodeParams
+  make_kernel_node_params(Params const& params) {
+    musaKernelNodeParams node_params{};
+    node_params.func = reinterpret_cast<void*>(device_kernel<GemmKernel>);
+    node_params.gridDim = get_grid_shape(params);
+    node_params.blockDim = GemmKernel::get_block_shape();
+    node_params.sharedMemBytes = GemmKernel::SharedStorageSize;
+    node_params.kernelParams = nullptr;
+    node_params.extra = nullptr;
+    return node_params;
+  }
 };
 
 } // namespace mutlass::gemm::device
@@ -0,0 +1,98 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#pragma once
+
+/*! \file
+    \brief Problem descriptor read by a GEMM kernel from device memory, allowing the problem size
+      and operands of a launch to be produced on the device.
+*/
+
+#include "mutlass/mutlass.h"
+
+#include "mute/numeric/integral_constant.hpp"
+#include "mute/util/type_traits.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass::gemm::kernel {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Problem size and operands of a GEMM, written to device memory by a preceding kernel and read
+ * by each CTA of a kernel launched with Arguments::problem_descriptor.
+ *
+ * The problem shape of the arguments is an upper bound on the problem of the descriptor. It
+ * determines the grid, and CTAs outside the problem of the descriptor exit immediately. The
+ * strides of the arguments are used unchanged, so they must be valid for the problem of the
+ * descriptor. A null pointer in the descriptor selects the pointer of the arguments.
+**/
+template <
+  class ElementA_,
+  class ElementB_,
+  class ElementC_,
+  class ElementD_
+>
+struct GemmProblemDescriptor {
+  int M = 0;
+  int N = 0;
+  int K = 0;
+  int L = 1;
+
+  ElementA_ const* ptr_A = nullptr;
+  ElementB_ const* ptr_B = nullptr;
+  ElementC_ const* ptr_C = nullptr;
+  ElementD_* ptr_D = nullptr;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// Whether epilogue params name their source and destination pointers ptr_C and ptr_D
+template <class Params, class = void>
+struct has_epilogue_pointers : mute::false_type { };
+
+template <class Params>
+struct has_epilogue_pointers<Params, mute::void_t<
+    decltype(mute::declval<Params&>().ptr_C),
+    decltype(mute::declval<Params&>().ptr_D)>>
+  : mute::true_type { };
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // namespace mutlass::gemm::kernel
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,119 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#pragma once
+
+/*! \file
+    \brief Shared memory plan of a GEMM kernel made of a collective mainloop and epilogue.
+*/
+
+#include "mutlass/mutlass.h"
+#include "mutlass/smem_plan.hpp"
+
+#include "mute/numeric/integral_constant.hpp"
+#include "mute/util/type_traits.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass::gemm::kernel {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Phases of a GEMM kernel in which shared storage of the collectives can be live
+struct GemmSmemPhase {
+  static constexpr int Mainloop = 0;
+  static constexpr int Epilogue = 1;
+};
+
+// Tags of the shared memory regions of the collectives
+struct MainloopSmemRegion { };
+struct EpilogueSmemRegion { };
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// Whether the mainloop keeps its shared storage, e.g. operand tiles a fused epilogue reads, alive
+// through the epilogue
+template <class CollectiveMainloop, class = void>
+struct smem_live_in_epilogue : mute::false_type { };
+
+template <class CollectiveMainloop>
+struct smem_live_in_epilogue<CollectiveMainloop, mute::void_t<
+    decltype(CollectiveMainloop::SharedStorageLiveInEpilogue)>>
+  : mute::bool_constant<CollectiveMainloop::SharedStorageLiveInEpilogue> { };
+
+// Whether the epilogue needs its shared storage, e.g. bias or scale vectors loaded ahead of the
+// accumulators, to survive the mainloop
+template <class CollectiveEpilogue, class = void>
+struct smem_live_in_mainloop : mute::false_type { };
+
+template <class CollectiveEpilogue>
+struct smem_live_in_mainloop<CollectiveEpilogue, mute::void_t<
+    decltype(CollectiveEpilogue::SharedStorageLiveInMainloop)>>
+  : mute::bool_constant<CollectiveEpilogue::SharedStorageLiveInMainloop> { };
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Shared memory of a GEMM kernel: the SharedStorage of the mainloop, live in the mainloop, and
+ * the SharedStorage of the epilogue, live in the epilogue. The two alias each other like a union
+ * unless a collective declares its storage live in the other phase, by setting
+ * SharedStorageLiveInEpilogue or SharedStorageLiveInMainloop, in which case they are laid out
+ * side by side.
+**/
+template <
+  class CollectiveMainloop,
+  class CollectiveEpilogue,
+  int Alignment = 16
+>
+using GemmSmemPlan = SmemPlan<
+  SmemRegion<
+    MainloopSmemRegion,
+    typename CollectiveMainloop::SharedStorage,
+    GemmSmemPhase::Mainloop,
+    detail::smem_live_in_epilogue<CollectiveMainloop>::value ? GemmSmemPhase::Epilogue : GemmSmemPhase::Mainloop,
+    Alignment>,
+  SmemRegion<
+    EpilogueSmemRegion,
+    typename CollectiveEpilogue::SharedStorage,
+    detail::smem_live_in_mainloop<CollectiveEpilogue>::value ? GemmSmemPhase::Mainloop : GemmSmemPhase::Epilogue,
+    GemmSmemPhase::Epilogue>
+>;
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // namespace mutlass::gemm::kernel
+
+////////////////////////////////////////////////////////////////////////////////
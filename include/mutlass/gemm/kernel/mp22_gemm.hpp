@@ -35,6 +35,8 @@
 #include "mutlass/kernel_hardware_info.hpp"
 #include "mutlass/gemm/gemm.h"
 #include "mutlass/gemm/dispatch_policy.hpp"
+#include "mutlass/gemm/kernel/gemm_problem_descriptor.hpp"
+#include "mutlass/gemm/kernel/gemm_smem_plan.hpp"
 
 #include "mute/tensor.hpp"
 
@@ -90,15 +92,18 @@ public:
   static_assert(mute::is_same_v<ElementAccumulator, typename CollectiveEpilogue::ElementAccumulator>,
     "Mainloop and epilogue do not agree on accumulator value type.");
 
-  // MSVC requires the cast to fix a warning-as-error.
-  static constexpr int SharedStorageSize = static_cast<int>(mute::max(
-      sizeof(typename CollectiveMainloop::SharedStorage),
-      sizeof(typename CollectiveEpilogue::SharedStorage)));
+  // Mainloop and epilogue storage share their bytes unless a collective keeps its storage live
+  // through the phase of the other
+  using SmemPlan = GemmSmemPlan<CollectiveMainloop, CollectiveEpilogue, CollectiveMainloop::SmemAlignmentBytes>;
+  static constexpr int SharedStorageSize = SmemPlan::SharedStorageSize;
 
   static constexpr uint32_t MaxThreadsPerBlock = MUTE_STATIC_V(mute::size(TiledMma{}));
   static constexpr uint32_t MinBlocksPerMultiprocessor = 1;
 
-  static constexpr int SmemAlignmentBytes = CollectiveMainloop::SmemAlignmentBytes;
+  static constexpr int SmemAlignmentBytes = SmemPlan::Alignment;
+
+  // Problem size and operands read from device memory at launch
+  using ProblemDescriptor = GemmProblemDescriptor<ElementA, ElementB, ElementC, ElementD>;
 
   // Device side arguments
   struct Arguments {
@@ -107,6 +112,8 @@ public:
     MainloopArguments mainloop{};
     EpilogueArguments epilogue{};
     KernelHardwareInfo hw_info{};
+    // If not null, the problem is read from this device buffer and problem_shape is its upper bound
+    ProblemDescriptor const* problem_descriptor = nullptr;
   };
 
   // Kernel entry point API
@@ -115,6 +122,7 @@ public:
     ProblemShape problem_shape{};
     MainloopParams mainloop{};
     EpilogueParams epilogue{};
+    ProblemDescriptor const* problem_descriptor = nullptr;
   };
 
   //
@@ -134,7 +142,8 @@ public:
       args.mode,
       args.problem_shape,
       CollectiveMainloop::to_underlying_arguments(args.problem_shape, args.mainloop, workspace),
-      CollectiveEpilogue::to_underlying_arguments(args.problem_shape, args.epilogue, workspace)
+      CollectiveEpilogue::to_underlying_arguments(args.problem_shape, args.epilogue, workspace),
+      args.problem_descriptor
     };
   }
 
@@ -197,9 +206,50 @@ public:
     // Preconditions
     MUTE_STATIC_ASSERT(is_static<TileShape>::value);
 
+    // Operands, replaced by those of the problem descriptor if one is given
+    ProblemShape problem_shape = params.problem_shape;
+    auto ptr_A = params.mainloop.ptr_A;
+    auto ptr_B = params.mainloop.ptr_B;
+    EpilogueParams epilogue_params = params.epilogue;
+
+    if (params.problem_descriptor != nullptr) {
+      ProblemDescriptor const problem = *params.problem_descriptor;
+
+      int problem_L = 1;
+      get<0>(problem_shape) = problem.M;
+      get<1>(problem_shape) = problem.N;
+      get<2>(problem_shape) = problem.K;
+      if constexpr (mute::rank(ProblemShape{}) == 4) {
+        get<3>(problem_shape) = problem.L;
+        problem_L = problem.L;
+      }
+
+      // The grid covers the upper bound of the problem
+      if (int(blockIdx.x) * int(size<0>(TileShape{})) >= problem.M ||
+          int(blockIdx.y) * int(size<1>(TileShape{})) >= problem.N ||
+          int(blockIdx.z) >= problem_L) {
+        return;
+      }
+
+      if (problem.ptr_A != nullptr) {
+        ptr_A = problem.ptr_A;
+      }
+      if (problem.ptr_B != nullptr) {
+        ptr_B = problem.ptr_B;
+      }
+      if constexpr (detail::has_epilogue_pointers<EpilogueParams>::value) {
+        if (problem.ptr_C != nullptr) {
+          epilogue_params.ptr_C = problem.ptr_C;
+        }
+        if (problem.ptr_D != nullptr) {
+          epilogue_params.ptr_D = problem.ptr_D;
+        }
+      }
+    }
+
     // Separate out problem shape for convenience
     // Optionally append 1s until problem shape is rank-4 in case its is only rank-3 (MNK)
-    auto problem_shape_MNKL = append<4>(params.problem_shape, Int<1>{});
+    auto problem_shape_MNKL = append<4>(problem_shape, Int<1>{});
     auto M = get<0>(problem_shape_MNKL);
     auto N = get<1>(problem_shape_MNKL);
     auto K = get<2>(problem_shape_MNKL);
@@ -218,8 +268,8 @@ public:
     auto blk_coord_mnkl = make_coord(m_coord, n_coord, _, l_coord);                                        // (m,n,k,l)
 
     // Represent the full tensors
-    Tensor mA_mkl = make_tensor(make_gmem_ptr(params.mainloop.ptr_A), make_shape(M,K,L), params.mainloop.dA); //(m,k,l)
-    Tensor mB_nkl = make_tensor(make_gmem_ptr(params.mainloop.ptr_B), make_shape(N,K,L), params.mainloop.dB); //(n,k,l)
+    Tensor mA_mkl = make_tensor(make_gmem_ptr(ptr_A), make_shape(M,K,L), params.mainloop.dA); //(m,k,l)
+    Tensor mB_nkl = make_tensor(make_gmem_ptr(ptr_B), make_shape(N,K,L), params.mainloop.dB); //(n,k,l)
 
     // Get batch slice
     Tensor mA_mk = mA_mkl(_,_,l_coord);                                                                        // (m,k)
@@ -253,10 +303,10 @@ public:
       k_tile_iter, k_tile_count,
       residue_mnk,
       thread_idx,
-      smem_buf
+      smem_buf + SmemPlan::template offset<MainloopSmemRegion>
     );
     // Epilogue and write to gD
-    CollectiveEpilogue epilogue{params.epilogue};
+    CollectiveEpilogue epilogue{epilogue_params};
     epilogue(
       problem_shape_MNKL,
       blk_shape,
@@ -265,7 +315,7 @@ public:
       tiled_mma,
       residue_mnk,
       thread_idx,
-      smem_buf
+      smem_buf + SmemPlan::template offset<EpilogueSmemRegion>
     );
   }
 };
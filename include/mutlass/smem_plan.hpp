@@ -0,0 +1,217 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Layout of named shared memory regions with lifetimes, aliasing regions that are never
+      live at the same time.
+*/
+
+#pragma once
+
+#include "mutlass/mutlass.h"
+
+#include "mute/util/type_traits.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// A named region of shared memory holding a Storage. The region is live from phase FirstPhase
+/// through phase LastPhase of a kernel. Phases are defined by the kernel and number its steps in
+/// program order, e.g. the mainloop and the epilogue of a GEMM.
+template <
+  class Tag_,
+  class Storage_,
+  int FirstPhase_,
+  int LastPhase_ = FirstPhase_,
+  int Alignment_ = int(alignof(Storage_))
+>
+struct SmemRegion {
+  static_assert(FirstPhase_ <= LastPhase_, "A region must be live in at least one phase.");
+  static_assert(Alignment_ > 0 && (Alignment_ & (Alignment_ - 1)) == 0, "Alignment must be a power of two.");
+
+  using Tag = Tag_;
+  using Storage = Storage_;
+
+  static constexpr int FirstPhase = FirstPhase_;
+  static constexpr int LastPhase = LastPhase_;
+  static constexpr int Alignment = Alignment_ > int(alignof(Storage_)) ? Alignment_ : int(alignof(Storage_));
+
+  // Empty storage, such as that of an epilogue not staging through shared memory, takes no bytes
+  static constexpr int Bytes = mute::is_empty_v<Storage_> ? 0 : int(sizeof(Storage_));
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+struct SmemRegionExtent {
+  int bytes = 0;
+  int alignment = 1;
+  int first_phase = 0;
+  int last_phase = 0;
+};
+
+template <int N>
+struct SmemPlacement {
+  int offsets[N] = {};
+  int size = 0;
+  int alignment = 1;
+};
+
+/// Places each region, in order, at the lowest aligned offset not overlapping any earlier region
+/// it is live together with
+template <int N>
+constexpr SmemPlacement<N>
+place_smem_regions(SmemRegionExtent const (&regions)[N], int count) {
+  SmemPlacement<N> placement;
+  for (int i = 0; i < count; ++i) {
+    SmemRegionExtent const& region = regions[i];
+    int offset = 0;
+    bool moved = true;
+    while (moved) {
+      moved = false;
+      offset = (offset + region.alignment - 1) / region.alignment * region.alignment;
+      for (int j = 0; j < i && region.bytes > 0; ++j) {
+        SmemRegionExtent const& placed = regions[j];
+        bool const live_together = region.first_phase <= placed.last_phase &&
+                                   placed.first_phase <= region.last_phase;
+        bool const overlapping = offset < placement.offsets[j] + placed.bytes &&
+                                 placement.offsets[j] < offset + region.bytes;
+        if (live_together && placed.bytes > 0 && overlapping) {
+          offset = placement.offsets[j] + placed.bytes;
+          moved = true;
+        }
+      }
+    }
+    placement.offsets[i] = offset;
+    placement.size = offset + region.bytes > placement.size ? offset + region.bytes : placement.size;
+    placement.alignment = region.alignment > placement.alignment ? region.alignment : placement.alignment;
+  }
+  placement.size = (placement.size + placement.alignment - 1) / placement.alignment * placement.alignment;
+  return placement;
+}
+
+} // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Shared memory layout of a kernel made of SmemRegions. Regions are placed in declaration order,
+ * each at the lowest offset that keeps it apart from the earlier regions it is live together
+ * with. Regions with disjoint lifetimes therefore share bytes like the members of a union, while
+ * a region live across phases, e.g. a bias vector read by both the mainloop and the epilogue,
+ * keeps its bytes for its whole lifetime.
+ *
+ * The kernel allocates SharedStorageSize bytes and hands each collective get<Tag>(smem_buf), or
+ * smem_buf + offset<Tag>.
+**/
+template <class... Regions>
+struct SmemPlan {
+  static constexpr int NumRegions = int(sizeof...(Regions));
+
+private:
+
+  static constexpr detail::SmemRegionExtent Extents[NumRegions + 1] = {
+    {Regions::Bytes, Regions::Alignment, Regions::FirstPhase, Regions::LastPhase}..., {}
+  };
+
+  static constexpr detail::SmemPlacement<NumRegions + 1> Placement =
+    detail::place_smem_regions(Extents, NumRegions);
+
+  template <class Tag>
+  static constexpr int tag_count = (0 + ... + int(mute::is_same_v<Tag, typename Regions::Tag>));
+
+  static_assert(((tag_count<typename Regions::Tag> == 1) && ...), "Region tags must be unique.");
+
+  template <class Tag>
+  MUTLASS_HOST_DEVICE static constexpr int
+  index_of() {
+    static_assert(tag_count<Tag> == 1, "No region of the plan has this tag.");
+    int index = 0;
+    int found = 0;
+    ((mute::is_same_v<Tag, typename Regions::Tag> ? (found = index, ++index) : ++index), ...);
+    return found;
+  }
+
+  template <int I, class First, class... Rest>
+  struct region_at {
+    using type = typename region_at<I - 1, Rest...>::type;
+  };
+
+  template <class First, class... Rest>
+  struct region_at<0, First, Rest...> {
+    using type = First;
+  };
+
+public:
+
+  /// The region named by Tag
+  template <class Tag>
+  using Region = typename region_at<index_of<Tag>(), Regions..., void>::type;
+
+  /// Storage type of the region named by Tag
+  template <class Tag>
+  using Storage = typename Region<Tag>::Storage;
+
+  /// Bytes of shared memory the plan needs
+  static constexpr int SharedStorageSize = Placement.size;
+
+  /// Alignment the shared memory buffer needs for all regions to be aligned
+  static constexpr int Alignment = Placement.alignment;
+
+  /// Byte offset of the region named by Tag
+  template <class Tag>
+  static constexpr int offset = Placement.offsets[index_of<Tag>()];
+
+  /// True if the regions named by TagA and TagB share any bytes
+  template <class TagA, class TagB>
+  static constexpr bool aliases =
+    Region<TagA>::Bytes > 0 && Region<TagB>::Bytes > 0 &&
+    offset<TagA> < offset<TagB> + Region<TagB>::Bytes &&
+    offset<TagB> < offset<TagA> + Region<TagA>::Bytes;
+
+  /// The storage of the region named by Tag in the shared memory buffer smem_buf
+  template <class Tag>
+  MUTLASS_HOST_DEVICE static Storage<Tag>&
+  get(char* smem_buf) {
+    return *reinterpret_cast<Storage<Tag>*>(smem_buf + offset<Tag>);
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
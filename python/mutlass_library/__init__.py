@@ -41,6 +41,7 @@ if '-m' not in sys.argv:
     # avoid double-import warnings
     from . import generator
 
+from . import kernel_selection
 from . import library
 from . import manifest
 
@@ -73,6 +73,12 @@ class GemmOperation:
     self.arch = arch
     self.tile_description = tile_description
     self.gemm_kind = gemm_kind
+
+    # Only the tensor op collective builder composes its shared memory atoms with a given swizzle
+    if tile_description.smem_swizzle is not None and \
+        tile_description.math_instruction.opcode_class == OpcodeClass.Simt:
+      raise ValueError("smem_swizzle is only supported by tensor op kernels; SIMT kernels use the "
+                       "shared memory layout of their collective builder")
     self.A = A
     self.B = B
     self.C = C
@@ -210,7 +216,8 @@ class GemmOperation:
   def procedural_name(self):
     ''' The full procedural name indicates architecture, extended name, tile size, and layout. '''
     opcode_class_name = OpcodeClassNames[self.tile_description.math_instruction.opcode_class]
-    kernel_name_template = "mutlass{p}_mp{ar}_{op}_{ex}_{tbm}x{tbn}x{tbk}_{s}_align{al}"
+    kernel_name_template = "mutlass{p}_mp{ar}_{op}_{ex}_{tbm}x{tbn}x{tbk}_{s}_align{al}{swz}"
+    swizzle = self.tile_description.smem_swizzle
     return kernel_name_template.format(
         p = self.prefix,
         ar = self.arch,
@@ -221,6 +228,7 @@ class GemmOperation:
         tbk = self.tile_description.tile_shape[2],
         s = self.layout_name_3x(),
         al = str(max(self.A.alignment, self.B.alignment)),
+        swz = "" if swizzle is None else "_swz%d%d%d_%d%d%d" % (*swizzle[0], *swizzle[1]),
       )
 
   #
@@ -313,7 +321,7 @@ using ${operation_name}_mainloop =
                ${permute_n},
                ${permute_k}>,
     ${stages},
-    ${kernel_schedule}
+    ${kernel_schedule}${smem_swizzle}
   >::CollectiveOp;
 
 // Gemm operator ${operation_name}
@@ -334,7 +342,8 @@ struct ${operation_name} :
 ${compile_guard_start}
   using GemmKernel = mutlass::gemm::device::GemmUniversalAdapter<${operation_name}>;
   manifest.append(
-    new ${gemm_kind}<GemmKernel>("${operation_name}"));
+    ${gemm_kind}<GemmKernel>::functional_key(),
+    []() -> Operation * { return new ${gemm_kind}<GemmKernel>("${operation_name}"); });
 ${compile_guard_end}
 """
 
@@ -349,6 +358,14 @@ ${compile_guard_end}
       stage_count_string = f"mutlass::gemm::collective::StageCountAutoCarveout<sizeof(typename {str(operation.procedural_name())}_epilogue::SharedStorage)>"
 
     epi_tile_mn = "mutlass::epilogue::collective::EpilogueTileAuto"
+
+    # The builder picks the smem atoms unless the tile description names their swizzles
+    smem_swizzle = operation.tile_description.smem_swizzle
+    if smem_swizzle is None:
+      smem_swizzle_string = ""
+    else:
+      smem_swizzle_string = ",\n    mutlass::gemm::collective::SmemSwizzle<mute::Swizzle<%d,%d,%d>, mute::Swizzle<%d,%d,%d>>" % \
+        (*smem_swizzle[0], *smem_swizzle[1])
     opcode_class_main = operation.tile_description.math_instruction.opcode_class
     opcode_class_epi = opcode_class_main
 
@@ -405,6 +422,7 @@ ${compile_guard_end}
       'epi_tile_mn' : epi_tile_mn,
       'epilogue_functor': epilogue_functor,
       'stages': stage_count_string,
+      'smem_swizzle': smem_swizzle_string,
       'align_a': str(operation.A.alignment),
       'align_b': str(operation.B.alignment),
       'align_c': str(operation.C.alignment),
@@ -421,9 +439,15 @@ ${compile_guard_end}
 
 #
 class EmitGemmConfigurationLibrary:
-  def __init__(self, operation_path, configuration_name):
+  '''
+    Emits the instances and the initialize function of one configuration. By default they are written
+    to their own translation unit. If configuration_file is given, they are appended to it instead,
+    as when several configurations are sharded into one translation unit.
+  '''
+  def __init__(self, operation_path, configuration_name, configuration_file = None):
     self.configuration_name = configuration_name
     self.configuration_path = os.path.join(operation_path, "%s.mu" % configuration_name).replace('\\', '/')
+    self.shared_configuration_file = configuration_file
 
     self.instance_emitter = {
       GemmKind.Universal3x: EmitGemmUniversal3xInstance,
@@ -472,8 +496,11 @@ void initialize_${configuration_name}(Manifest &manifest) {
 """
 
   def __enter__(self):
-    self.configuration_file = open(self.configuration_path, "w")
-    self.configuration_file.write(self.header_template)
+    if self.shared_configuration_file is None:
+      self.configuration_file = open(self.configuration_path, "w")
+      self.configuration_file.write(self.header_template)
+    else:
+      self.configuration_file = self.shared_configuration_file
     self.configuration_file.write(self.separator)
 
     self.includes = collections.OrderedDict([
@@ -529,7 +556,8 @@ void initialize_${configuration_name}(Manifest &manifest) {
       self.configuration_file.write(instance_wrapper)
 
     self.configuration_file.write(self.epilogue_template)
-    self.configuration_file.close()
+    if self.shared_configuration_file is None:
+      self.configuration_file.close()
 
 ###################################################################################################
 ###################################################################################################
@@ -468,10 +468,24 @@ def define_parser():
   parser.add_argument("--kernels", default='', help='Comma delimited list to filter kernels by name.')
   parser.add_argument("--ignore-kernels", default='', help='Comma delimited list of kernels to exclude from build.')
   parser.add_argument("--filter-by-cc", default='True', type=str, help='If enabled, kernels whose compute capability range is not satisfied by the build target are excluded.')
+  parser.add_argument("--min-ctas-per-core", default=1, type=int, required=False,
+                      help='Kernels estimated to fit fewer CTAs per core, or to spill registers, are excluded.')
   parser.add_argument("--musa-version", default="3.0.0", help="Semantic version string of MUSA Toolkit")
   parser.add_argument('--kernel-filter-file',   type=str, default=None, required=False, help='Full path of filter file')
   parser.add_argument('--selected-kernel-list',   type=str, default=None, required=False,
                         help='Specify the output log file containing all enabled kernels in this build')
+  parser.add_argument("--kernel-selection-from", default='', required=False,
+                      help='Comma delimited list of profiler reports (CSV or JSON lines). If given, only the Pareto-best kernels of each GEMM functional key and alignment are built.')
+  parser.add_argument("--kernel-selection-shapes", default='', required=False,
+                      help='File listing the production problem shapes (one m,n,k per line) the kernel selection is made for. Defaults to all shapes in the reports.')
+  parser.add_argument("--kernel-selection-report", default='', required=False,
+                      help='Output path of the kernel selection decisions. Defaults to kernel_selection.csv in --curr-build-dir.')
+  parser.add_argument("--kernel-selection-cache-mode", default='cold', choices=['cold', 'warm'], required=False,
+                      help='Cache mode of the profiler results the kernel selection compares. Results without a cache mode were profiled cold.')
+  parser.add_argument("--kernel-selection-prune-unmeasured", action="store_true", required=False,
+                      help='Exclude kernels of a profiled functional key that were not profiled themselves. By default they are kept.')
+  parser.add_argument("--kernel-shards", default=0, type=int, required=False,
+                      help='If positive, emits the kernels of each architecture into this many translation units assigned by a stable hash of the kernel name, rather than one per configuration.')
   parser.add_argument("--disable-full-archs-compilation", action="store_true", required=False, help="Disable compilation for every archs in --architectures")
   parser.add_argument("--log-level", default='info', type=numeric_log_level, required=False,
                       help='Logging level to be used by the generator script')
@@ -487,6 +501,7 @@ if __name__ == "__main__":
 
   manifest = Manifest(args)
   GenerateMP22(manifest, args.musa_version)
+  manifest.select_kernels()
   if 'library' in args.generator_target.split(','):
     manifest.emit(GeneratorTarget.Library)
 
@@ -0,0 +1,271 @@
+#################################################################################################
+#
+# Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+# Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#################################################################################################
+
+
+"""
+Utilities for selecting the MUTLASS library kernels to build from profiler reports
+"""
+
+import csv
+import json
+import logging
+import math
+import os.path
+import re
+
+try:
+  import builtins
+  if hasattr(builtins, "MUTLASS_IGNORE_PACKAGE") and MUTLASS_IGNORE_PACKAGE == True:
+    raise ImportError("Disabling attempt to import mutlass_library")
+  from mutlass_library.library import *
+except ImportError:
+  from library import *
+
+###################################################################################################
+_LOGGER = logging.getLogger(__name__)
+
+#
+def GemmSelectionKey(operation):
+  '''
+    Returns the properties by which the library matches a GEMM operation against a problem: the
+    functional key (data types, layouts and GEMM kind) and the preference key (compute capability
+    and alignment). Kernels sharing a selection key are interchangeable, so only the fastest of them
+    need to be built. Kernels of lower alignment are kept apart since they serve problems the more
+    aligned kernels cannot.
+  '''
+  return (
+    operation.gemm_kind,
+    operation.accumulator_type(),
+    operation.element_epilogue,
+    operation.A.element, operation.A.layout,
+    operation.B.element, operation.B.layout,
+    operation.C.element, operation.C.layout,
+    operation.D.element, operation.D.layout,
+    operation.tile_description.minimum_compute_capability,
+    max(operation.A.alignment, operation.B.alignment, operation.C.alignment),
+  )
+
+#
+def GemmSelectionKeyName(key):
+  gemm_kind, accumulator, epilogue, element_a, layout_a, element_b, layout_b, \
+    element_c, layout_c, element_d, layout_d, cc, alignment = key
+
+  return "{kind}_{acc}_{epi}_{a}{la}_{b}{lb}_{c}{lc}_{d}{ld}_mp{cc}_align{alignment}".format(
+    kind = GemmKindNames[gemm_kind], acc = DataTypeNames[accumulator], epi = DataTypeNames[epilogue],
+    a = DataTypeNames[element_a], la = ShortLayoutTypeNames[layout_a],
+    b = DataTypeNames[element_b], lb = ShortLayoutTypeNames[layout_b],
+    c = DataTypeNames[element_c], lc = ShortLayoutTypeNames[layout_c],
+    d = DataTypeNames[element_d], ld = ShortLayoutTypeNames[layout_d],
+    cc = cc, alignment = alignment)
+
+###################################################################################################
+
+#
+def ParseProblemShape(text):
+  ''' Parses a problem shape given as "m,n,k" or "MxNxK". Returns None for blank lines. '''
+  text = text.split('#')[0].strip()
+  if not text:
+    return None
+
+  extents = [x for x in re.split(r'[,x\s]+', text.lower()) if x]
+  if len(extents) != 3:
+    raise ValueError(f"Invalid problem shape '{text}': expected m,n,k")
+
+  return tuple(int(x) for x in extents)
+
+#
+def LoadProblemShapes(path):
+  ''' Loads production problem shapes, one "m,n,k" per line '''
+  shapes = []
+  with open(path, 'r') as shape_file:
+    for line in shape_file:
+      shape = ParseProblemShape(line)
+      if shape is not None and shape not in shapes:
+        shapes.append(shape)
+  return shapes
+
+###################################################################################################
+
+#
+class KernelSelection:
+  '''
+    Keeps the Pareto-best kernels of each GEMM selection key given measured runtimes.
+
+    Each kernel is described by its runtime on every production problem shape. A kernel is pruned
+    if another kernel with the same selection key is no slower on every shape and faster on at
+    least one. Kernels with no measurement on a shape are treated as infinitely slow on it.
+
+    Only results profiled with the given cache mode are compared, since cold and warm runtimes of
+    the same kernel differ. Results without a cache mode were measured cold. Kernels that were not
+    profiled at all are kept unless keep_unmeasured is false, since there is no evidence to prune
+    them.
+  '''
+
+  #
+  def __init__(self, report_paths, shapes_path = None, cache_mode = 'cold', keep_unmeasured = True):
+    self.report_paths = report_paths
+    self.shapes_path = shapes_path
+    self.cache_mode = cache_mode.lower()
+    self.keep_unmeasured = keep_unmeasured
+
+    # procedural name -> {(m, n, k) -> best runtime in ms}
+    self.runtimes = {}
+
+    for path in report_paths:
+      self.load_report(path)
+
+    if shapes_path:
+      self.shapes = LoadProblemShapes(shapes_path)
+    else:
+      self.shapes = sorted(set(shape for measured in self.runtimes.values() for shape in measured))
+
+    _LOGGER.info("Kernel selection from {reports}: {kernels} profiled kernels, {shapes} problem shapes, {mode} cache".format(
+      reports = ", ".join(report_paths), kernels = len(self.runtimes), shapes = len(self.shapes), mode = self.cache_mode))
+
+    # procedural name -> (kept, selection key name, reason)
+    self.decisions = {}
+
+  #
+  def _record(self, operation_name, arguments, runtime, provider = 'mutlass', status = 'success', disposition = None,
+              cache_mode = None):
+    ''' Records one profiler result if it is a successful MUTLASS GEMM measurement in the selected cache mode '''
+    if provider.lower() != 'mutlass' or status.lower() != 'success':
+      return
+    if (cache_mode or 'cold').lower() != self.cache_mode:
+      return
+    if disposition is not None and disposition.lower() in ('failed', 'incorrect'):
+      return
+
+    try:
+      shape = (int(arguments['m']), int(arguments['n']), int(arguments['k']))
+      runtime = float(runtime)
+    except (KeyError, TypeError, ValueError):
+      return
+
+    if not math.isfinite(runtime) or runtime <= 0:
+      return
+
+    measured = self.runtimes.setdefault(operation_name, {})
+    measured[shape] = min(runtime, measured.get(shape, math.inf))
+
+  #
+  def load_report(self, path):
+    ''' Loads a profiler report written with --output (CSV) or --json-output (JSON lines) '''
+    with open(path, 'r') as report_file:
+      first_line = report_file.readline()
+      report_file.seek(0)
+
+      if first_line.lstrip().startswith('{'):
+        for line in report_file:
+          if not line.strip():
+            continue
+          result = json.loads(line)
+          self._record(result.get('operation', ''), result.get('arguments', {}), result.get('runtime', 0),
+            result.get('provider', 'mutlass'), result.get('status', 'success'), result.get('disposition'),
+            result.get('cache_mode'))
+      else:
+        for row in csv.DictReader(report_file):
+          self._record(row.get('Operation', ''), row, row.get('Runtime', 0),
+            row.get('Provider', 'mutlass'), row.get('Status', 'success'), row.get('Disposition'),
+            row.get('CacheMode'))
+
+  #
+  def runtime_vector(self, operation_name):
+    measured = self.runtimes.get(operation_name, {})
+    return tuple(measured.get(shape, math.inf) for shape in self.shapes)
+
+  #
+  @staticmethod
+  def dominates(lhs, rhs):
+    ''' Returns true if lhs is no slower than rhs on every shape and faster on at least one '''
+    return all(l <= r for l, r in zip(lhs, rhs)) and any(l < r for l, r in zip(lhs, rhs))
+
+  #
+  def select(self, operations):
+    '''
+      Returns the subset of operations to build. The decision for every operation is recorded in
+      self.decisions.
+    '''
+    by_key = {}
+    for operation in operations:
+      by_key.setdefault(GemmSelectionKey(operation), []).append(operation)
+
+    selected = []
+    for key, candidates in by_key.items():
+      key_name = GemmSelectionKeyName(key)
+      vectors = {op.procedural_name(): self.runtime_vector(op.procedural_name()) for op in candidates}
+
+      if all(all(math.isinf(t) for t in vector) for vector in vectors.values()):
+        for op in candidates:
+          self.decisions[op.procedural_name()] = (True, key_name, "no profiling data for selection key")
+        selected.extend(candidates)
+        continue
+
+      for op in candidates:
+        name = op.procedural_name()
+        vector = vectors[name]
+
+        if all(math.isinf(t) for t in vector):
+          self.decisions[name] = (self.keep_unmeasured, key_name, "not profiled on any problem shape")
+          if self.keep_unmeasured:
+            selected.append(op)
+          continue
+
+        dominator = next((other for other, other_vector in vectors.items()
+                          if other != name and self.dominates(other_vector, vector)), None)
+
+        if dominator is None:
+          self.decisions[name] = (True, key_name, "Pareto-optimal")
+          selected.append(op)
+        else:
+          self.decisions[name] = (False, key_name, f"dominated by {dominator}")
+
+    return selected
+
+  #
+  def write_report(self, path):
+    ''' Writes one row per kernel with its decision and its runtime on each problem shape '''
+    with open(path, 'w', newline='') as report_file:
+      writer = csv.writer(report_file)
+      writer.writerow(['SelectionKey', 'Operation', 'Decision', 'Reason'] +
+                      ['Runtime_{}x{}x{}'.format(*shape) for shape in self.shapes])
+
+      for name, (kept, key_name, reason) in sorted(self.decisions.items(), key = lambda x: (x[1][1], x[0])):
+        writer.writerow([key_name, name, 'keep' if kept else 'prune', reason] +
+                        ['' if math.isinf(t) else t for t in self.runtime_vector(name)])
+
+    kept_count = sum(1 for kept, _, _ in self.decisions.values() if kept)
+    _LOGGER.info("Kernel selection kept {kept} of {total} kernels. See {path} for the decision on each kernel.".format(
+      kept = kept_count, total = len(self.decisions), path = path))
+
+###################################################################################################
@@ -36,6 +36,8 @@ Data types and tags used for emitting MUTLASS C++ kernels
 """
 
 import enum
+import functools
+import operator
 import re
 
 # The following block implements enum.auto() for Python 3.5 variants that don't include it such
@@ -305,6 +307,26 @@ SharedMemPerCC = {
   22:  72,
 }
 
+#
+class OccupancyModel:
+  '''
+    Resources of one core the occupancy of a kernel is estimated against. Registers are counted in
+    32-bit words. Mirrors mutlass::analysis::OccupancyModel in mutlass/util/occupancy_estimate.hpp.
+  '''
+  def __init__(self, registers_per_core, max_registers_per_thread, register_allocation_unit,
+               reserved_registers, smem_per_core, max_threads_per_core, max_ctas_per_core):
+    self.registers_per_core = registers_per_core
+    self.max_registers_per_thread = max_registers_per_thread
+    self.register_allocation_unit = register_allocation_unit
+    self.reserved_registers = reserved_registers
+    self.smem_per_core = smem_per_core
+    self.max_threads_per_core = max_threads_per_core
+    self.max_ctas_per_core = max_ctas_per_core
+
+OccupancyModelPerCC = {
+  22: OccupancyModel(128 * 1024, 255, 8, 16, SharedMemPerCC[22] << 10, 2048, 16),
+}
+
 ###################################################################################################
 
 #
@@ -474,7 +496,7 @@ class MathInstruction:
 class TileDescription:
 
   def __init__(self, threadblock_shape, stages, math_instruction, min_compute, max_compute, atom_layout,
-                permute=[[Underscore()],[Underscore()],[Underscore()]], cluster_shape = [1,1,1]):
+                permute=[[Underscore()],[Underscore()],[Underscore()]], cluster_shape = [1,1,1], smem_swizzle = None):
     self.threadblock_shape = threadblock_shape
     self.tile_shape = threadblock_shape
     self.stages = stages
@@ -485,6 +507,9 @@ class TileDescription:
     self.cluster_shape = cluster_shape
     self.atom_layout = atom_layout
     self.permute = permute
+    # [[B, M, S], [B, M, S]] of the mute::Swizzle composed with the A and B smem atoms, e.g. as found
+    # by `mutlass_analyzer --analysis=swizzle`. None lets the builder pick.
+    self.smem_swizzle = smem_swizzle
 
   def procedural_name(self):
     if self.minimum_compute_capability >= 90:
@@ -522,6 +547,107 @@ def CalculateSmemUsage(operation):
   smem_usage = smem_per_stage * stages
   return (smem_usage >> 10)
 
+#
+class OccupancyEstimate:
+  def __init__(self, registers, registers_per_thread, threads_per_cta, smem_per_cta, ctas_per_core):
+    self.registers = registers                          # live registers per thread
+    self.registers_per_thread = registers_per_thread    # allocated registers per thread
+    self.threads_per_cta = threads_per_cta
+    self.smem_per_cta = smem_per_cta                    # bytes
+    self.ctas_per_core = ctas_per_core
+
+  def spills(self):
+    return self.registers > self.registers_per_thread
+
+#
+def RoundUp(value, unit):
+  return (value + unit - 1) // unit * unit
+
+#
+def EstimateSmemPerCta(operation):
+  '''
+    Returns the shared memory bytes per CTA of an MP22 GEMM, laid out as the kernel's GemmSmemPlan
+    lays out the SharedStorage of its mainloop and epilogue. The mainloop holds one stage of A and
+    B; the SIMT builder strides the smem tile of B by BlockM, so it spans BlockN + (BlockK-1) * BlockM
+    elements. The epilogue builder makes a DefaultEpilogue for every schedule, whose empty storage
+    takes no bytes and aliases the mainloop's.
+  '''
+  tile_m, tile_n, tile_k = operation.tile_description.threadblock_shape
+
+  cosize_b = tile_n * tile_k
+  if operation.tile_description.math_instruction.opcode_class == OpcodeClass.Simt:
+    cosize_b = tile_n + (tile_k - 1) * tile_m
+
+  # array_aligned<> members of the mainloop SharedStorage are 16B aligned
+  smem_a = RoundUp(DataTypeSize[operation.A.element] * tile_m * tile_k // 8, 16)
+  smem_b = RoundUp(DataTypeSize[operation.B.element] * cosize_b // 8, 16)
+  mainloop_smem = smem_a + smem_b
+  epilogue_smem = 0
+
+  # Neither collective keeps its storage live in the other's phase, so the regions alias like a
+  # union aligned to the SmemAlignmentBytes of the mainloop
+  return RoundUp(max(mainloop_smem, epilogue_smem), 128)
+
+#
+def EstimateOccupancy(operation, model = None):
+  '''
+    Estimates the registers per thread and the resident CTAs per core of an MP22 GEMM, as
+    mutlass::analysis::estimate_occupancy() does for the CollectiveMma the builder makes of it.
+    Every thread holds its share of the accumulators, the MMA operand fragments of one k-tile
+    (replicated across the atoms along the other mode) and the registers staging the next k-tile.
+    The two-stage mainloop keeps that second stage in registers, so shared memory holds one stage,
+    laid out together with the epilogue's as EstimateSmemPerCta() describes.
+  '''
+  tile_description = operation.tile_description
+  if model is None:
+    model = OccupancyModelPerCC[tile_description.minimum_compute_capability]
+
+  tile_m, tile_n, tile_k = tile_description.threadblock_shape
+  atom_m, atom_n, atom_k = tile_description.atom_layout[0]
+  threads_per_atom = 128 if tile_description.math_instruction.opcode_class == OpcodeClass.TensorOp else 1
+  threads = threads_per_atom * atom_m * atom_n * atom_k
+
+  def registers(elements, data_type):
+    elements_per_thread = (elements + threads - 1) // threads
+    return (elements_per_thread * DataTypeSize[data_type] + 31) // 32
+
+  element_a = operation.A.element
+  element_b = operation.B.element
+  live_registers = registers(tile_m * tile_n, operation.accumulator_type()) + \
+                   registers(tile_m * tile_k * atom_n, element_a) + \
+                   registers(tile_n * tile_k * atom_m, element_b) + \
+                   registers(tile_m * tile_k, element_a) + \
+                   registers(tile_n * tile_k, element_b) + \
+                   model.reserved_registers
+
+  unit = model.register_allocation_unit
+  registers_per_thread = min((live_registers + unit - 1) // unit * unit, model.max_registers_per_thread)
+  smem_per_cta = EstimateSmemPerCta(operation)
+
+  ctas_per_core = min(
+    model.registers_per_core // (registers_per_thread * threads),
+    model.smem_per_core // smem_per_cta,
+    model.max_threads_per_core // threads,
+    model.max_ctas_per_core)
+
+  return OccupancyEstimate(live_registers, registers_per_thread, threads, smem_per_cta, ctas_per_core)
+
+#
+def EstimateInstantiationCost(operation):
+  '''
+    Returns a relative estimate of the time to compile an operation. Each kernel pays a fixed cost
+    to instantiate its collectives, plus a cost that grows with the number of MMA atoms every thread
+    unrolls per tile and stage.
+  '''
+  tile_description = operation.tile_description
+
+  tile_size = functools.reduce(operator.mul, tile_description.threadblock_shape, 1)
+  instruction_size = functools.reduce(operator.mul, tile_description.math_instruction.instruction_shape, 1)
+  atom_count = functools.reduce(operator.mul, tile_description.atom_layout[0], 1)
+
+  mma_per_thread = tile_size / (instruction_size * atom_count)
+  return 1.0 + tile_description.stages * mma_per_thread / 64.0
+
 
 class LayoutToString:
   def __init__(self, layout):
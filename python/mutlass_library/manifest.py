@@ -37,9 +37,11 @@ and building code
 """
 
 import enum
+import io
 import logging
 import os.path
 import shutil
+import zlib
 
 try:
   import builtins
@@ -47,9 +49,11 @@ try:
     raise ImportError("Disabling attempt to import mutlass_library")
   from mutlass_library.library import *
   from mutlass_library.gemm_operation import *
+  from mutlass_library.kernel_selection import *
 except ImportError:
   from library import *
   from gemm_operation import *
+  from kernel_selection import *
 
 ###################################################################################################
 _LOGGER = logging.getLogger(__name__)
@@ -288,6 +292,124 @@ void initialize_all_mp${min_cc}_${operation_name}_operations(Manifest &manifest)
     self.top_level_file.write(self.epilogue_template)
     self.top_level_file.close()
 
+class EmitOperationKindShardedLibrary:
+  '''
+    Emits the configurations of one {operation_kind x cc} combination into a fixed number of
+    translation units, in place of one translation unit per configuration. The initialize function
+    of every configuration is emitted unchanged.
+
+    Each configuration is placed in the shard given by a stable hash of its procedural name, so
+    that adding or changing one kernel only rewrites its own shard. With hundreds of kernels per
+    shard the hash spreads the estimated compile time evenly enough; the cost of each shard is
+    logged. Shards are written to a directory outside of generated/ and only rewritten when their
+    content changes, so unchanged shards are not recompiled.
+  '''
+
+  # Name of the subclass under which shard source files are reported
+  subclass_name = 'shards'
+
+  def __init__(self, shard_path, min_cc, kind, shard_count, args):
+    self.shard_path = shard_path
+    self.min_cc = min_cc
+    self.kind = kind
+    self.shard_count = shard_count
+    self.args = args
+    self.emitters = {
+      OperationKind.Gemm: EmitGemmConfigurationLibrary,
+    }
+
+    self.header_template = """
+/*
+  Generated by manifest.py - Do not edit.
+
+  Shard ${shard_index} of ${shard_count} of the MP${min_cc} ${operation_name} operations. Estimated cost: ${cost}
+*/
+"""
+
+  #
+  def __enter__(self):
+    self.operation_path = os.path.join(self.shard_path, OperationKindNames[self.kind], str(self.min_cc))
+    os.makedirs(self.operation_path, exist_ok=True)
+
+    self.configurations = []
+    self.source_files = {}
+    return self
+
+  #
+  def emit(self, configuration_name, operations):
+    assert len(operations) > 0
+    cost = sum(EstimateInstantiationCost(operation) for operation in operations)
+    self.configurations.append((configuration_name, operations, cost))
+
+  #
+  def shard_file_name(self, shard_index):
+    return f"all_mp{self.min_cc}_{OperationKindNames[self.kind]}_operations_shard{shard_index}.mu"
+
+  #
+  def assign(self):
+    ''' Returns the configurations of each shard '''
+    shards = [[] for _ in range(self.shard_count)]
+    costs = [0.0] * self.shard_count
+
+    # The shard of a configuration depends on its name only, never on the other configurations
+    for configuration in sorted(self.configurations, key = lambda x: x[0]):
+      configuration_name, _, cost = configuration
+
+      shard_index = zlib.crc32(configuration_name.encode()) % self.shard_count
+
+      shards[shard_index].append(configuration)
+      costs[shard_index] += cost
+
+    return shards, costs
+
+  #
+  def __exit__(self, exception_type, exception_value, traceback):
+    shards, costs = self.assign()
+
+    shard_paths = []
+    for shard_index, configurations in enumerate(shards):
+      if not configurations:
+        continue
+
+      shard_file = io.StringIO()
+      shard_file.write(SubstituteTemplate(self.header_template, {
+        'shard_index': str(shard_index),
+        'shard_count': str(self.shard_count),
+        'min_cc': str(self.min_cc),
+        'operation_name': OperationKindNames[self.kind],
+        'cost': "%.1f" % costs[shard_index]
+      }))
+
+      for configuration_name, operations, _ in sorted(configurations, key = lambda x: x[0]):
+        with self.emitters[self.kind](self.operation_path, configuration_name, shard_file) as configuration_emitter:
+          for operation in operations:
+            configuration_emitter.emit(operation)
+
+      shard_path = os.path.join(self.operation_path, self.shard_file_name(shard_index)).replace('\\', '/')
+      self.write_if_changed(shard_path, shard_file.getvalue())
+      shard_paths.append(shard_path)
+
+      _LOGGER.info("Shard {path}: {count} configurations, estimated cost {cost:.1f}".format(
+        path = shard_path, count = len(configurations), cost = costs[shard_index]))
+
+    # Remove shards left over from a build with more shards
+    for file_name in os.listdir(self.operation_path):
+      file_path = os.path.join(self.operation_path, file_name).replace('\\', '/')
+      if file_path not in shard_paths:
+        os.remove(file_path)
+
+    self.source_files[self.subclass_name] = shard_paths
+
+  #
+  @staticmethod
+  def write_if_changed(path, content):
+    if os.path.isfile(path):
+      with open(path, 'r') as existing_file:
+        if existing_file.read() == content:
+          return
+    with open(path, 'w') as shard_file:
+      shard_file.write(content)
+
 class EmitInterfaceLibrary:
   def __init__(self, generated_path, operation_count, args):
     self.generated_path = generated_path
@@ -392,6 +514,7 @@ class Manifest:
     self.compute_capabilities = [10,]
     self.curr_build_dir = '.'
     self.filter_by_cc = True
+    self.min_ctas_per_core = 1
 
     if self.args:
       self.kernel_filter = self.args.kernels
@@ -404,6 +527,8 @@ class Manifest:
       if args.filter_by_cc in ['false', 'False', '0']:
         self.filter_by_cc = False
 
+      self.min_ctas_per_core = args.min_ctas_per_core
+
     if args.operations == 'all':
       self.operations_enabled = []
     else:
@@ -430,6 +555,13 @@ class Manifest:
     self.operation_count = 0
     self.operations_by_name = {}
     self.disable_full_archs_compilation = args.disable_full_archs_compilation
+    self.kernel_shards = args.kernel_shards
+
+    self.kernel_selection = None
+    kernel_selection_reports = [x for x in re.split('[,;]', args.kernel_selection_from or '') if x != '']
+    if len(kernel_selection_reports):
+      self.kernel_selection = KernelSelection(kernel_selection_reports, args.kernel_selection_shapes or None,
+        args.kernel_selection_cache_mode, not args.kernel_selection_prune_unmeasured)
 
 
   def get_kernel_filters (self, kernelListFile):
@@ -481,6 +613,16 @@ class Manifest:
     if not enabled:
       return False
 
+    # filter out kernels estimated to spill registers or to fit fewer CTAs per core than requested
+    if operation.tile_description.minimum_compute_capability in OccupancyModelPerCC:
+      occupancy = EstimateOccupancy(operation)
+      if occupancy.spills() or occupancy.ctas_per_core < self.min_ctas_per_core:
+        _LOGGER.debug("Kernel {kernel} culled by occupancy: {registers} registers, {ctas} CTAs per core.".format(
+          kernel = operation.procedural_name(),
+          registers = occupancy.registers,
+          ctas = occupancy.ctas_per_core))
+        return False
+
     if len(self.operations_enabled) and not operation.operation_kind in self.operations_enabled:
       return False
 
@@ -558,6 +700,40 @@ class Manifest:
     else:
       _LOGGER.debug("Culled {} from manifest".format(operation.procedural_name()))
   #
+  def select_kernels(self):
+    '''
+      Prunes the appended GEMM operations to the Pareto-best kernels of each selection key according
+      to the profiler reports given by --kernel-selection-from, and writes the decision for every
+      kernel to the kernel selection report.
+    '''
+    if self.kernel_selection is None:
+      return
+
+    gemm_operations = [op for op in self.operations_by_name.values() if op.operation_kind == OperationKind.Gemm]
+    selected_names = set(op.procedural_name() for op in self.kernel_selection.select(gemm_operations))
+    pruned_names = set(op.procedural_name() for op in gemm_operations) - selected_names
+
+    for min_cc, configurations in self.operations.get(OperationKind.Gemm, {}).items():
+      for configuration_name in list(configurations.keys()):
+        configurations[configuration_name] = [op for op in configurations[configuration_name]
+                                              if op.procedural_name() not in pruned_names]
+        if not configurations[configuration_name]:
+          del configurations[configuration_name]
+
+    for name in pruned_names:
+      _LOGGER.debug("Kernel {kernel} pruned by kernel selection: {reason}".format(
+        kernel = name, reason = self.kernel_selection.decisions[name][2]))
+      del self.operations_by_name[name]
+
+    self.selected_kernels = [name for name in self.selected_kernels if name not in pruned_names]
+    self.operation_count -= len(pruned_names)
+
+    report_path = self.args.kernel_selection_report
+    if not report_path:
+      report_path = os.path.join(self.curr_build_dir, 'kernel_selection.csv')
+    self.kernel_selection.write_report(report_path)
+
+  #
   def simt_manifest_cmake(self, manifest_file, source_files, kind, min_cc, subclass):
     target_text = SubstituteTemplate("""mutlass_add_mutlass_library(
       SUFFIX ${kind}_mp${min_cc}_${subclass}_simt
@@ -586,6 +762,20 @@ class Manifest:
 
     manifest_file.write(")\n")
 
+  def shard_manifest_cmake(self, manifest_file, source_files, kind, min_cc):
+    target_text = SubstituteTemplate("""mutlass_add_mutlass_library(
+      SUFFIX ${kind}_mp${min_cc}_shards
+""", { 'min_cc': str(min_cc), 'kind': OperationKindNames[kind] })
+    manifest_file.write(target_text + '\n\n')
+
+    for source_file in source_files:
+      manifest_file.write("    %s\n" % str(source_file.replace('\\', '/')))
+    compile_archs = ";".join([str(mp) for mp in self.compute_capabilities if mp >= min_cc])
+    if self.disable_full_archs_compilation:
+      manifest_file.write(f"    MP_ARCHS {compile_archs}\n")
+
+    manifest_file.write(")\n")
+
   def emit_manifest_cmake(self, manifest_path, top_level_path, source_files):
     with open(manifest_path, "w") as manifest_file:
 
@@ -605,6 +795,9 @@ class Manifest:
       for kind in self.operations.keys():
         for min_cc in sorted(self.operations[kind].keys()):
           for subclass in sorted(source_files[kind][min_cc].keys()):
+            if subclass == EmitOperationKindShardedLibrary.subclass_name:
+              self.shard_manifest_cmake(manifest_file, source_files[kind][min_cc][subclass], kind, min_cc)
+              continue
             simt_source_files = []
             tensorop_source_files = []
             for source_file in source_files[kind][min_cc][subclass]:
@@ -654,16 +847,23 @@ class Manifest:
 
     for operation_kind, ops in self.operations.items():
       for min_cc, configurations in sorted(ops.items()):
-        with operation_emitters[target](generated_path, min_cc, operation_kind, self.args) as operation_kind_emitter:
+        if self.kernel_shards > 0:
+          # Shards live outside generated/ so that unchanged shards keep their timestamps
+          shard_path = os.path.join(self.curr_build_dir, 'generated_shards')
+          operation_kind_emitter = EmitOperationKindShardedLibrary(shard_path, min_cc, operation_kind, self.kernel_shards, self.args)
+        else:
+          operation_kind_emitter = operation_emitters[target](generated_path, min_cc, operation_kind, self.args)
+
+        with operation_kind_emitter:
           for configuration_name, operations in configurations.items():
             _LOGGER.info("Emitting {config} with {num_ops} operations.".format(
                 config = configuration_name, num_ops = len(operations)))
             operation_kind_emitter.emit(configuration_name, operations)
 
-          for subclass, files in operation_kind_emitter.source_files.items():
-            if subclass not in source_files[operation_kind][min_cc]:
-              source_files[operation_kind][min_cc][subclass] = []
-            source_files[operation_kind][min_cc][subclass].extend(operation_kind_emitter.source_files[subclass])
+        for subclass, files in operation_kind_emitter.source_files.items():
+          if subclass not in source_files[operation_kind][min_cc]:
+            source_files[operation_kind][min_cc][subclass] = []
+          source_files[operation_kind][min_cc][subclass].extend(operation_kind_emitter.source_files[subclass])
 
       # Emit top level all_{gemm, conv2d, ...}_operations.mu files
       with kind_emitters[target](generated_path, operation_kind, self.args) as operation_kind_emitter:
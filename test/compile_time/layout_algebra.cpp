@@ -0,0 +1,83 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Compile-time benchmark: layout algebra over distinct static layouts.
+
+    MUTE_COMPILE_TIME_SCALE multiplies the number of distinct layouts instantiated.
+*/
+
+#include <utility>
+
+#include <mute/tensor.hpp>
+
+#ifndef MUTE_COMPILE_TIME_SCALE
+#define MUTE_COMPILE_TIME_SCALE 1
+#endif
+
+using namespace mute;
+
+namespace {
+
+template <int I>
+int layout_algebra() {
+  // Every I yields distinct static shapes, so no instantiation is shared between them
+  using M = Int<(8 << (I % 4))>;
+  using N = Int<(4 << (I / 4 % 4))>;
+  using K = Int<(1 << (I / 16))>;
+
+  auto layout = make_layout(make_shape (make_shape(M{}, _2{}), make_shape(N{}, K{})),
+                            make_stride(make_stride(_1{}, M{} * N{} * K{}), make_stride(M{}, M{} * N{})));
+
+  auto divided  = logical_divide(layout, make_tile(Layout<Shape<_4,_2>, Stride<_2,_1>>{}, Layout<_4>{}));
+  auto zipped   = zipped_divide(composition(layout, make_layout(make_shape(M{} * _2{}, N{} * K{}), LayoutRight{})),
+                                make_shape(_4{}, _4{}));
+  auto coalesced = coalesce(divided);
+  auto inverse  = right_inverse(coalesced);
+  auto comp     = complement(make_layout(M{}, _2{}), M{} * N{} * _2{});
+  auto product  = logical_product(make_layout(make_shape(M{}, N{})), make_layout(K{}));
+  auto blocked  = blocked_product(make_layout(make_shape(_2{}, _2{})), make_layout(make_shape(M{}, N{})));
+
+  return int(size(divided) + size(zipped) + cosize(coalesced) + size(inverse) +
+             cosize(comp) + size(product) + size(blocked));
+}
+
+template <int... Is>
+int instantiate(std::integer_sequence<int, Is...>) {
+  return (layout_algebra<Is>() + ...);
+}
+
+} // namespace
+
+int mute_compile_time_layout_algebra() {
+  return instantiate(std::make_integer_sequence<int, 16 * MUTE_COMPILE_TIME_SCALE>{});
+}
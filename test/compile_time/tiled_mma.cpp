@@ -0,0 +1,107 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Compile-time benchmark: MP22 TiledMMA and TiledCopy partitioning.
+
+    Mirrors what a mainloop instantiates per generated kernel. MUTE_COMPILE_TIME_SCALE multiplies
+    the number of distinct tile configurations.
+*/
+
+#include <utility>
+
+#include <mute/tensor.hpp>
+#include <mute/atom/mma_atom.hpp>
+#include <mute/atom/copy_atom.hpp>
+
+#ifndef MUTE_COMPILE_TIME_SCALE
+#define MUTE_COMPILE_TIME_SCALE 1
+#endif
+
+using namespace mute;
+
+namespace {
+
+template <int I>
+int tiled_mma() {
+  // Distinct atom layouts and tile sizes per I
+  using AtomM = Int<(1 << (I % 2))>;
+  using AtomN = Int<(1 << (I / 2 % 2))>;
+  using BlockM = Int<32 * AtomM::value * (1 << (I / 4 % 2))>;
+  using BlockN = Int<32 * AtomN::value * (1 << (I / 8 % 2))>;
+  using BlockK = Int<16 * (1 << (I / 16))>;
+
+  using TiledMma = TiledMMA<MMA_Atom<MP22_32x32x16_F32F16F16F32_TN>,
+                            Layout<Shape<AtomM, AtomN, _1>>,
+                            Tile<Layout<Shape<_32, AtomM, Int<BlockM::value / 32 / AtomM::value>>,
+                                        Stride<_1, Int<BlockM::value / AtomM::value>, _32>>,
+                                 Layout<Shape<_32, AtomN, Int<BlockN::value / 32 / AtomN::value>>,
+                                        Stride<_1, Int<BlockN::value / AtomN::value>, _32>>,
+                                 Underscore>>;
+
+  constexpr int Threads = size(TiledMma{});
+
+  auto sA = tile_to_shape(make_ordered_layout(Shape<_16, Shape<_8, _2>>{}, Step<_1, Step<_0, _2>>{}),
+                          make_shape(BlockM{}, BlockK{}));
+  auto sB = tile_to_shape(make_ordered_layout(Shape<_16, Shape<_8, _2>>{}, Step<_1, Step<_0, _2>>{}),
+                          make_shape(BlockN{}, BlockK{}));
+
+  auto gmem_copy = make_tiled_copy(Copy_Atom<UniversalCopy<uint128_t>, half_t>{},
+                                   Layout<Shape<Int<Threads / (BlockK::value / 8)>, Int<BlockK::value / 8>>,
+                                          Stride<Int<BlockK::value / 8>, _1>>{},
+                                   Layout<Shape<_1, _8>>{});
+
+  TiledMma tiled_mma;
+  auto thr_mma = tiled_mma.get_thread_slice(0);
+  auto tCsA = thr_mma.partition_A(make_counting_tensor(sA));
+  auto tCsB = thr_mma.partition_B(make_counting_tensor(sB));
+  auto tCcC = thr_mma.partition_C(make_identity_tensor(make_shape(BlockM{}, BlockN{})));
+
+  auto smem_copy_A = make_tiled_copy_A(Copy_Atom<DefaultCopy, half_t>{}, tiled_mma).get_thread_slice(0);
+  auto smem_copy_B = make_tiled_copy_B(Copy_Atom<DefaultCopy, half_t>{}, tiled_mma).get_thread_slice(0);
+  auto tAsA = gmem_copy.get_thread_slice(0).partition_D(make_counting_tensor(sA));
+
+  return int(size(tCsA) + size(tCsB) + size(tCcC) + size(tAsA) +
+             size(smem_copy_A.partition_S(make_counting_tensor(sA))) +
+             size(smem_copy_B.partition_S(make_counting_tensor(sB))));
+}
+
+template <int... Is>
+int instantiate(std::integer_sequence<int, Is...>) {
+  return (tiled_mma<Is>() + ...);
+}
+
+} // namespace
+
+int mute_compile_time_tiled_mma() {
+  return instantiate(std::make_integer_sequence<int, 8 * MUTE_COMPILE_TIME_SCALE>{});
+}
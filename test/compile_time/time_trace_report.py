@@ -0,0 +1,193 @@
+#################################################################################################
+#
+# Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+# Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+"""
+Summarizes the -ftime-trace output of the MuTe compile-time benchmark and checks it against a
+baseline.
+
+Each translation unit is given as NAME=OBJECT; its trace is the object path with the object
+extension replaced by .json, where clang writes it. For every unit the report records the total,
+frontend and backend time and the number and duration of class and function template
+instantiations, plus the most expensive instantiations.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+
+# Aggregate events clang emits at the end of a trace
+_TOTALS = {
+  "Total ExecuteCompiler": "total_ms",
+  "Total Frontend": "frontend_ms",
+  "Total Backend": "backend_ms",
+  "Total InstantiateClass": "instantiate_class_ms",
+  "Total InstantiateFunction": "instantiate_function_ms",
+}
+
+_COUNTS = {
+  "InstantiateClass": "instantiate_class_count",
+  "InstantiateFunction": "instantiate_function_count",
+}
+
+# Metrics compared against the baseline and the relative growth each tolerates by default
+_CHECKED_METRICS = {
+  "frontend_ms": 0.10,
+  "instantiate_class_count": 0.02,
+  "instantiate_function_count": 0.02,
+}
+
+
+def trace_path(object_path):
+  return os.path.splitext(object_path)[0] + ".json"
+
+
+def summarize(path, top):
+  with open(path) as trace_file:
+    events = json.load(trace_file)["traceEvents"]
+
+  metrics = {metric: 0.0 for metric in _TOTALS.values()}
+  metrics.update({metric: 0 for metric in _COUNTS.values()})
+  expensive = {}
+
+  for event in events:
+    name = event.get("name")
+    if event.get("ph") != "X" or name is None:
+      continue
+    if name in _TOTALS:
+      metrics[_TOTALS[name]] = event.get("dur", 0) / 1000.0
+    elif name in _COUNTS:
+      metrics[_COUNTS[name]] += 1
+      detail = event.get("args", {}).get("detail", "")
+      expensive[detail] = expensive.get(detail, 0) + event.get("dur", 0)
+
+  # Without -ftime-trace-granularity=0 only slow instantiations are traced individually, the
+  # totals still count all of them
+  for event in events:
+    name = event.get("name", "")
+    if name.startswith("Total ") and name[len("Total "):] in _COUNTS:
+      count = event.get("args", {}).get("count")
+      if count is not None:
+        metrics[_COUNTS[name[len("Total "):]]] = int(count)
+
+  metrics["top_instantiations"] = [
+    {"detail": detail, "ms": duration / 1000.0}
+    for detail, duration in sorted(expensive.items(), key=lambda item: -item[1])[:top]
+  ]
+  return metrics
+
+
+def compare(report, baseline, tolerances):
+  regressions = []
+  for name, metrics in report.items():
+    if name not in baseline:
+      continue
+    for metric, tolerance in tolerances.items():
+      reference = baseline[name].get(metric)
+      if not reference:
+        continue
+      growth = metrics[metric] / reference - 1.0
+      if growth > tolerance:
+        regressions.append((name, metric, reference, metrics[metric], growth))
+  return regressions
+
+
+def print_report(report):
+  columns = ["total_ms", "frontend_ms", "backend_ms", "instantiate_class_count",
+             "instantiate_function_count", "instantiate_class_ms", "instantiate_function_ms"]
+  width = max([len(name) for name in report] + [len("unit")])
+  print("unit".ljust(width) + "".join(column.rjust(28) for column in columns))
+  for name in sorted(report):
+    row = report[name]
+    print(name.ljust(width) + "".join(
+      (("%.1f" % row[column]) if isinstance(row[column], float) else str(row[column])).rjust(28)
+      for column in columns))
+
+
+def main(argv):
+  parser = argparse.ArgumentParser(description="Summarizes MuTe compile-time benchmark traces")
+  parser.add_argument("units", nargs="+", metavar="NAME=OBJECT",
+                      help="Benchmark translation units and the object files they compiled to")
+  parser.add_argument("--output", required=True, help="JSON file receiving the report")
+  parser.add_argument("--baseline", default="", help="Report of a previous run to compare against")
+  parser.add_argument("--update-baseline", action="store_true",
+                      help="Write the report to --baseline instead of comparing")
+  parser.add_argument("--time-tolerance", type=float, default=_CHECKED_METRICS["frontend_ms"],
+                      help="Relative frontend time growth tolerated before failing")
+  parser.add_argument("--count-tolerance", type=float, default=_CHECKED_METRICS["instantiate_class_count"],
+                      help="Relative instantiation count growth tolerated before failing")
+  parser.add_argument("--top", type=int, default=10, help="Most expensive instantiations listed per unit")
+  args = parser.parse_args(argv)
+
+  if args.update_baseline and not args.baseline:
+    parser.error("--update-baseline requires --baseline")
+
+  report = {}
+  for unit in args.units:
+    name, _, object_path = unit.partition("=")
+    path = trace_path(object_path)
+    if not os.path.exists(path):
+      print("Missing time trace %s; is the compiler clang-based and -ftime-trace enabled?" % path,
+            file=sys.stderr)
+      return 2
+    report[name] = summarize(path, args.top)
+
+  with open(args.output, "w") as output:
+    json.dump(report, output, indent=2, sort_keys=True)
+
+  print_report(report)
+
+  if args.update_baseline:
+    with open(args.baseline, "w") as baseline_file:
+      json.dump(report, baseline_file, indent=2, sort_keys=True)
+    print("Updated baseline %s" % args.baseline)
+  elif args.baseline:
+    with open(args.baseline) as baseline_file:
+      baseline = json.load(baseline_file)
+    tolerances = {
+      "frontend_ms": args.time_tolerance,
+      "instantiate_class_count": args.count_tolerance,
+      "instantiate_function_count": args.count_tolerance,
+    }
+    regressions = compare(report, baseline, tolerances)
+    for name, metric, reference, current, growth in regressions:
+      print("REGRESSION %s %s: %s -> %s (+%.1f%%)" % (name, metric, reference, current, 100.0 * growth),
+            file=sys.stderr)
+    if regressions:
+      return 1
+
+  return 0
+
+
+if __name__ == "__main__":
+  sys.exit(main(sys.argv[1:]))
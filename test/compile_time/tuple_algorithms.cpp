@@ -0,0 +1,88 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Compile-time benchmark: tuple algorithms over long static tuples.
+
+    MUTE_COMPILE_TIME_SCALE multiplies both the tuple length and the number of distinct tuples.
+*/
+
+#include <utility>
+
+#include <mute/int_tuple.hpp>
+#include <mute/algorithm/tuple_algorithms.hpp>
+
+#ifndef MUTE_COMPILE_TIME_SCALE
+#define MUTE_COMPILE_TIME_SCALE 1
+#endif
+
+using namespace mute;
+
+namespace {
+
+constexpr int Length = 8 * MUTE_COMPILE_TIME_SCALE;
+
+template <int Offset, int... Is>
+auto make_sequence_tuple(std::integer_sequence<int, Is...>) {
+  return make_tuple(Int<Offset + Is>{}...);
+}
+
+template <int I>
+int tuple_algorithms() {
+  auto t = make_sequence_tuple<I>(std::make_integer_sequence<int, Length>{});
+
+  auto doubled  = transform(t, [](auto x) { return x * _2{}; });
+  auto summed   = fold(doubled, _0{}, [](auto a, auto b) { return a + b; });
+  auto found    = find_if(t, [](auto x) { return x == Int<I + Length / 2>{}; });
+  auto evens    = filter_tuple(t, [](auto x) {
+                    if constexpr (decltype(x)::value % 2 == 0) { return make_tuple(x); }
+                    else { return tuple<>{}; } });
+  auto flat     = flatten(make_tuple(t, reverse(t), make_tuple(doubled, make_tuple(t))));
+  auto zipped   = zip(t, doubled);
+  auto scanned  = iscan(t, _0{}, [](auto a, auto b) { return a + b; });
+  auto appended = append<Length + 2>(t, _1{});
+  auto nested   = make_tuple(t, make_tuple(t, doubled));
+
+  return int(summed) + int(found) + int(rank(evens)) + int(rank(flat)) + int(rank(zipped)) +
+         int(back(scanned)) + int(rank(appended)) + int(depth(nested));
+}
+
+template <int... Is>
+int instantiate(std::integer_sequence<int, Is...>) {
+  return (tuple_algorithms<Is>() + ...);
+}
+
+} // namespace
+
+int mute_compile_time_tuple_algorithms() {
+  return instantiate(std::make_integer_sequence<int, 8 * MUTE_COMPILE_TIME_SCALE>{});
+}
@@ -0,0 +1,72 @@
+#################################################################################################
+#
+# Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+# Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+"""
+Unit tests of the checks GemmOperation makes on its tile description. Run with
+
+  python3 -m unittest discover -s test/python/mutlass_library
+"""
+
+import os
+import sys
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..', 'python'))
+
+from mutlass_library.library import *
+from mutlass_library.gemm_operation import GemmOperation
+
+###################################################################################################
+
+#
+def MakeOperation(opcode_class, smem_swizzle):
+  math_inst = MathInstruction([1, 1, 1], DataType.f32, DataType.f32, DataType.f32,
+                              opcode_class, MathOperation.multiply_add)
+  tile = TileDescription([128, 128, 8], 2, math_inst, 22, 22, [2, 2, 1], smem_swizzle = smem_swizzle)
+  tensor = TensorDescription(DataType.f32, LayoutType.ColumnMajor, 1)
+  return GemmOperation(GemmKind.Universal3x, 22, tile, tensor, tensor, tensor, DataType.f32)
+
+#
+class TestGemmOperation(unittest.TestCase):
+
+  def test_simt_default_smem_layout(self):
+    operation = MakeOperation(OpcodeClass.Simt, None)
+    self.assertIsNone(operation.tile_description.smem_swizzle)
+
+  def test_simt_rejects_smem_swizzle(self):
+    with self.assertRaises(ValueError):
+      MakeOperation(OpcodeClass.Simt, ((3, 3, 3), (3, 3, 3)))
+
+###################################################################################################
+
+if __name__ == '__main__':
+  unittest.main()
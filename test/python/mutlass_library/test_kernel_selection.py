@@ -0,0 +1,196 @@
+#################################################################################################
+#
+# Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+# Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+"""
+Unit tests of the kernel selection made from profiler reports. Run with
+
+  python3 -m unittest discover -s test/python/mutlass_library
+"""
+
+import math
+import os
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..', 'python'))
+
+from mutlass_library.library import DataType, GemmKind, LayoutType
+from mutlass_library.kernel_selection import KernelSelection, ParseProblemShape
+
+###################################################################################################
+
+#
+class TensorDesc:
+  def __init__(self, element, layout, alignment):
+    self.element = element
+    self.layout = layout
+    self.alignment = alignment
+
+#
+class FakeGemmOperation:
+  ''' Provides the properties of a GemmOperation the kernel selection reads '''
+  def __init__(self, name, alignment = 4):
+    self.name = name
+    self.gemm_kind = GemmKind.Universal3x
+    self.element_epilogue = DataType.f32
+    self.A = TensorDesc(DataType.f32, LayoutType.ColumnMajor, alignment)
+    self.B = TensorDesc(DataType.f32, LayoutType.RowMajor, alignment)
+    self.C = TensorDesc(DataType.f32, LayoutType.ColumnMajor, alignment)
+    self.D = TensorDesc(DataType.f32, LayoutType.ColumnMajor, alignment)
+    self.tile_description = type('TileDescription', (), {'minimum_compute_capability': 22})()
+
+  def accumulator_type(self):
+    return DataType.f32
+
+  def procedural_name(self):
+    return self.name
+
+###################################################################################################
+
+#
+class KernelSelectionTest(unittest.TestCase):
+
+  def setUp(self):
+    self.directory = tempfile.TemporaryDirectory()
+
+  def tearDown(self):
+    self.directory.cleanup()
+
+  def write(self, name, text):
+    path = os.path.join(self.directory.name, name)
+    with open(path, 'w') as f:
+      f.write(text)
+    return path
+
+  def csv_report(self, rows):
+    header = "Problem,Provider,OperationKind,Operation,Disposition,Status,m,n,k,Runtime,CacheMode\n"
+    return self.write('report.csv', header + "".join(
+      "1,mutlass,gemm,{0},passed,success,{2},{3},{4},{5},{1}\n".format(*row) for row in rows))
+
+  #
+  def test_parse_problem_shape(self):
+    self.assertEqual(ParseProblemShape("128, 256, 64"), (128, 256, 64))
+    self.assertEqual(ParseProblemShape("128x256x64 # decode"), (128, 256, 64))
+    self.assertIsNone(ParseProblemShape("  # comment only"))
+    with self.assertRaises(ValueError):
+      ParseProblemShape("128,256")
+
+  #
+  def test_csv_report_selects_cache_mode(self):
+    path = self.csv_report([
+      ('k0', 'cold', 64, 64, 64, 2.0),
+      ('k0', 'warm', 64, 64, 64, 1.0),
+      ('k0', 'cold', 64, 64, 64, 1.5),
+    ])
+
+    cold = KernelSelection([path])
+    self.assertEqual(cold.runtimes, {'k0': {(64, 64, 64): 1.5}})
+
+    warm = KernelSelection([path], cache_mode = 'warm')
+    self.assertEqual(warm.runtimes, {'k0': {(64, 64, 64): 1.0}})
+
+  #
+  def test_json_report(self):
+    path = self.write('report.json',
+      '{"provider":"mutlass","operation":"k0","status":"success","disposition":"passed",'
+      '"arguments":{"m":"64","n":"32","k":"16"},"runtime":1.0}\n'
+      '\n'
+      '{"provider":"mutlass","operation":"k1","status":"success","disposition":"incorrect",'
+      '"arguments":{"m":"64","n":"32","k":"16"},"runtime":0.5}\n'
+      '{"provider":"mublas","operation":"k2","status":"success",'
+      '"arguments":{"m":"64","n":"32","k":"16"},"runtime":0.5}\n'
+      '{"provider":"mutlass","operation":"k3","status":"success","cache_mode":"warm",'
+      '"arguments":{"m":"64","n":"32","k":"16"},"runtime":0.5}\n'
+      '{"provider":"mutlass","operation":"k4","status":"success",'
+      '"arguments":{"m":"64","n":"32","k":"16"},"runtime":null}\n')
+
+    selection = KernelSelection([path])
+
+    # Results without a cache mode are cold; incorrect, foreign and warm results are ignored
+    self.assertEqual(selection.runtimes, {'k0': {(64, 32, 16): 1.0}})
+    self.assertEqual(selection.shapes, [(64, 32, 16)])
+
+  #
+  def test_pareto_selection(self):
+    path = self.csv_report([
+      ('fast_small', 'cold', 64, 64, 64, 1.0),
+      ('fast_small', 'cold', 4096, 4096, 4096, 9.0),
+      ('fast_large', 'cold', 64, 64, 64, 2.0),
+      ('fast_large', 'cold', 4096, 4096, 4096, 5.0),
+      ('dominated', 'cold', 64, 64, 64, 2.0),
+      ('dominated', 'cold', 4096, 4096, 4096, 9.0),
+      ('partial', 'cold', 64, 64, 64, 0.5),
+    ])
+
+    operations = [FakeGemmOperation(name) for name in
+                  ('fast_small', 'fast_large', 'dominated', 'partial', 'unmeasured')]
+
+    selection = KernelSelection([path])
+    selected = set(op.procedural_name() for op in selection.select(operations))
+
+    # A kernel missing a shape is infinitely slow there, so it is dominated by no one either
+    self.assertEqual(selected, {'fast_small', 'fast_large', 'partial', 'unmeasured'})
+    self.assertFalse(selection.decisions['dominated'][0])
+    self.assertTrue(selection.decisions['unmeasured'][0])
+
+    pruning = KernelSelection([path], keep_unmeasured = False)
+    selected = set(op.procedural_name() for op in pruning.select(operations))
+    self.assertEqual(selected, {'fast_small', 'fast_large', 'partial'})
+
+  #
+  def test_selection_key_without_measurement(self):
+    path = self.csv_report([('k0', 'cold', 64, 64, 64, 1.0)])
+
+    # Kernels of another alignment have a separate selection key that was never profiled
+    operations = [FakeGemmOperation('k0'), FakeGemmOperation('a1_k0', 1), FakeGemmOperation('a1_k1', 1)]
+
+    selection = KernelSelection([path], keep_unmeasured = False)
+    selected = set(op.procedural_name() for op in selection.select(operations))
+    self.assertEqual(selected, {'k0', 'a1_k0', 'a1_k1'})
+
+  #
+  def test_shapes_file(self):
+    report = self.csv_report([
+      ('k0', 'cold', 64, 64, 64, 1.0),
+      ('k0', 'cold', 128, 128, 128, 2.0),
+    ])
+    shapes = self.write('shapes.txt', "# production shapes\n128,128,128\n256x256x256\n128,128,128\n")
+
+    selection = KernelSelection([report], shapes)
+    self.assertEqual(selection.shapes, [(128, 128, 128), (256, 256, 256)])
+    self.assertEqual(selection.runtime_vector('k0'), (2.0, math.inf))
+
+###################################################################################################
+
+if __name__ == '__main__':
+  unittest.main()
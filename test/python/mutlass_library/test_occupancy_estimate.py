@@ -0,0 +1,99 @@
+#################################################################################################
+#
+# Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+# Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+"""
+Unit tests of the occupancy estimate the generator culls kernels by. The expected values are those
+mutlass::analysis::estimate_occupancy() computes for the collectives of the same kernels, pinned in
+test/unit/util/occupancy_estimate.cpp. Run with
+
+  python3 -m unittest discover -s test/python/mutlass_library
+"""
+
+import os
+import sys
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..', 'python'))
+
+from mutlass_library.library import *
+from mutlass_library.gemm_operation import GemmOperation
+
+###################################################################################################
+
+#
+def MakeOperation(opcode_class, element, element_accumulator, tile_shape, atom_layout, alignment):
+  math_inst = MathInstruction([1, 1, 1], element, element, element_accumulator,
+                              opcode_class, MathOperation.multiply_add)
+  tile = TileDescription(tile_shape, 2, math_inst, 22, 22, [atom_layout])
+  A = TensorDescription(element, LayoutType.RowMajor, alignment)
+  B = TensorDescription(element, LayoutType.ColumnMajor, alignment)
+  C = TensorDescription(element_accumulator, LayoutType.ColumnMajor, 1)
+  return GemmOperation(GemmKind.Universal3x, 22, tile, A, B, C, element_accumulator)
+
+#
+class TestOccupancyEstimate(unittest.TestCase):
+
+  def check(self, operation, registers, registers_per_thread, threads_per_cta, smem_per_cta, ctas_per_core):
+    estimate = EstimateOccupancy(operation)
+    self.assertEqual(
+      (estimate.registers, estimate.registers_per_thread, estimate.threads_per_cta,
+       estimate.smem_per_cta, estimate.ctas_per_core),
+      (registers, registers_per_thread, threads_per_cta, smem_per_cta, ctas_per_core))
+
+  def test_matches_estimate_tensorop(self):
+    f16 = lambda tile, atom: MakeOperation(OpcodeClass.TensorOp, DataType.f16, DataType.f32, tile, atom, 8)
+
+    self.check(f16([128, 128, 32], [1, 1, 1]), 208, 208, 128, 16384, 4)
+    self.check(f16([128,  64, 32], [1, 1, 1]), 128, 128, 128, 12288, 6)
+    self.check(f16([128,  32, 32], [1, 1, 1]),  88,  88, 128, 10240, 7)
+    self.check(f16([256, 128, 32], [2, 1, 1]), 200, 200, 256, 24576, 2)
+    self.check(f16([256, 256, 32], [2, 2, 1]), 192, 192, 512, 32768, 1)
+
+    self.check(MakeOperation(OpcodeClass.TensorOp, DataType.s8, DataType.s32, [128, 128, 64], [1, 1, 1], 16),
+               208, 208, 128, 16384, 4)
+    self.check(MakeOperation(OpcodeClass.TensorOp, DataType.tf32, DataType.f32, [128, 128, 16], [1, 1, 1], 4),
+               208, 208, 128, 16384, 4)
+
+  def test_matches_estimate_simt(self):
+    f32 = lambda tile, atom: MakeOperation(OpcodeClass.Simt, DataType.f32, DataType.f32, tile, atom, 1)
+
+    # The smem tile of B is strided by BlockM, so it spans BlockN + (BlockK-1) * BlockM elements
+    self.check(f32([128, 128, 4], [16, 16, 1]), 148, 152, 256, 4096, 3)
+    self.check(f32([128, 128, 8], [16, 32, 1]), 148, 152, 512, 8192, 1)
+    self.check(f32([128,  64, 4], [16,  8, 1]), 150, 152, 128, 3840, 6)
+    self.check(f32([128,  64, 8], [16, 16, 1]), 150, 152, 256, 7936, 3)
+    self.check(f32([128,  32, 4], [16,  8, 1]), 101, 104, 128, 3712, 9)
+
+###################################################################################################
+
+if __name__ == '__main__':
+  unittest.main()
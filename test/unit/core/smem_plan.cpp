@@ -0,0 +1,155 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Tests for the layout of shared memory regions with lifetimes
+*/
+
+#include "mutlass_unit_test.h"
+
+#include "mutlass/smem_plan.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+enum Phase : int {
+  kPrologue = 0,
+  kMainloop = 1,
+  kEpilogue = 2
+};
+
+struct TileA {};
+struct TileB {};
+struct Bias {};
+struct Staging {};
+struct Scratch {};
+
+struct alignas(16) TileStorage {
+  float data[1024];
+};
+
+struct BiasStorage {
+  float data[128];
+};
+
+struct StagingStorage {
+  float data[1536];
+};
+
+struct EmptyStorage {};
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(SmemPlan, disjoint_lifetimes_form_a_union) {
+  using Plan = mutlass::SmemPlan<
+    mutlass::SmemRegion<TileA, TileStorage, kMainloop>,
+    mutlass::SmemRegion<Staging, StagingStorage, kEpilogue>>;
+
+  static_assert(Plan::offset<TileA> == 0);
+  static_assert(Plan::offset<Staging> == 0);
+  static_assert(Plan::aliases<TileA, Staging>);
+
+  // The same size as max(sizeof(TileStorage), sizeof(StagingStorage))
+  EXPECT_EQ(Plan::SharedStorageSize, int(sizeof(StagingStorage)));
+}
+
+TEST(SmemPlan, overlapping_lifetimes_keep_their_bytes) {
+  // The bias is read before the mainloop and by the epilogue, so it may alias neither
+  using Plan = mutlass::SmemPlan<
+    mutlass::SmemRegion<TileA, TileStorage, kMainloop>,
+    mutlass::SmemRegion<TileB, TileStorage, kMainloop>,
+    mutlass::SmemRegion<Bias, BiasStorage, kPrologue, kEpilogue, 128>,
+    mutlass::SmemRegion<Staging, StagingStorage, kEpilogue>>;
+
+  EXPECT_EQ(Plan::offset<TileA>, 0);
+  EXPECT_EQ(Plan::offset<TileB>, int(sizeof(TileStorage)));
+  EXPECT_EQ(Plan::offset<Bias>, 2 * int(sizeof(TileStorage)));
+  EXPECT_EQ(Plan::Region<Bias>::Alignment, 128);
+  EXPECT_EQ(Plan::Alignment, 128);
+
+  // The epilogue staging reuses the bytes of both tiles, but not those of the bias
+  EXPECT_EQ(Plan::offset<Staging>, 0);
+  EXPECT_TRUE((Plan::aliases<Staging, TileA>));
+  EXPECT_TRUE((Plan::aliases<Staging, TileB>));
+  EXPECT_FALSE((Plan::aliases<Staging, Bias>));
+  EXPECT_FALSE((Plan::aliases<TileA, TileB>));
+
+  EXPECT_EQ(Plan::SharedStorageSize, 2 * int(sizeof(TileStorage)) + int(sizeof(BiasStorage)));
+}
+
+TEST(SmemPlan, first_fit_fills_gaps) {
+  // Staging does not fit below the bias, which is live with it, so it moves past it
+  using Plan = mutlass::SmemPlan<
+    mutlass::SmemRegion<TileA, TileStorage, kMainloop>,
+    mutlass::SmemRegion<Bias, BiasStorage, kMainloop, kEpilogue>,
+    mutlass::SmemRegion<Staging, StagingStorage, kEpilogue>,
+    mutlass::SmemRegion<Scratch, BiasStorage, kEpilogue>>;
+
+  EXPECT_EQ(Plan::offset<Bias>, int(sizeof(TileStorage)));
+  EXPECT_EQ(Plan::offset<Staging>, int(sizeof(TileStorage) + sizeof(BiasStorage)));
+
+  // Scratch fits in the bytes of the tile, which is dead in the epilogue
+  EXPECT_EQ(Plan::offset<Scratch>, 0);
+  EXPECT_TRUE((Plan::aliases<Scratch, TileA>));
+  EXPECT_FALSE((Plan::aliases<Scratch, Staging>));
+}
+
+TEST(SmemPlan, empty_regions_take_no_bytes) {
+  using Plan = mutlass::SmemPlan<
+    mutlass::SmemRegion<TileA, TileStorage, kMainloop, kEpilogue>,
+    mutlass::SmemRegion<Staging, EmptyStorage, kEpilogue>>;
+
+  EXPECT_EQ(Plan::offset<Staging>, 0);
+  EXPECT_FALSE((Plan::aliases<TileA, Staging>));
+  EXPECT_EQ(Plan::SharedStorageSize, int(sizeof(TileStorage)));
+
+  EXPECT_EQ(mutlass::SmemPlan<>::SharedStorageSize, 0);
+}
+
+TEST(SmemPlan, get_returns_region_storage) {
+  using Plan = mutlass::SmemPlan<
+    mutlass::SmemRegion<TileA, TileStorage, kMainloop>,
+    mutlass::SmemRegion<Bias, BiasStorage, kMainloop, kEpilogue>>;
+
+  alignas(128) char smem_buf[Plan::SharedStorageSize];
+
+  BiasStorage& bias = Plan::get<Bias>(smem_buf);
+  TileStorage& tile = Plan::get<TileA>(smem_buf);
+
+  EXPECT_EQ(reinterpret_cast<char*>(&bias), smem_buf + Plan::offset<Bias>);
+  EXPECT_EQ(reinterpret_cast<char*>(&tile), smem_buf);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -86,6 +86,13 @@ enum class CheckEquality {
   RELATIVE = 1
 };
 
+enum class LaunchMode {
+  STREAM = 0,
+  GRAPH = 1,
+  PREPARED = 2,
+  DEVICE_PROBLEM = 3
+};
+
 namespace detail{
 
 // Helper classes that take default data type when
@@ -1233,6 +1240,8 @@ struct TestbedImpl {
   static constexpr uint32_t mma_promotion_interval = 4;
   HostCollectiveMainloopType collective_mma_inputs;
   CollectiveEpilogue collective_epilogue;
+  // Launch the kernel directly or as a node of a graph
+  LaunchMode launch_mode = LaunchMode::STREAM;
 
   //
   // Methods
@@ -1394,6 +1403,99 @@ struct TestbedImpl {
     return true;
   }
 
+  /// Launches the initialized GEMM as the only node of a graph
+  mutlass::Status run_graph(Gemm &gemm_op) {
+    musaGraph_t graph;
+    musaGraphNode_t node;
+    musaGraphExec_t graph_exec;
+
+    if (musaGraphCreate(&graph, 0) != musaSuccess) {
+      return mutlass::Status::kErrorInternal;
+    }
+
+    mutlass::Status status = gemm_op.add_graph_node(graph, &node);
+
+    if (status == mutlass::Status::kSuccess) {
+      if (musaGraphInstantiateWithFlags(&graph_exec, graph, 0) == musaSuccess) {
+        if (musaGraphLaunch(graph_exec, nullptr) != musaSuccess) {
+          status = mutlass::Status::kErrorInternal;
+        }
+        (void)musaStreamSynchronize(nullptr);
+        (void)musaGraphExecDestroy(graph_exec);
+      }
+      else {
+        status = mutlass::Status::kErrorInternal;
+      }
+    }
+
+    (void)musaGraphDestroy(graph);
+    return status;
+  }
+
+  /// Initializes the GEMM without operands and launches it after supplying them via update_pointers()
+  mutlass::Status run_prepared(Gemm &gemm_op, typename Gemm::Arguments const &arguments, void *workspace) {
+    typename Gemm::Arguments unbound = arguments;
+    unbound.mainloop.ptr_A = nullptr;
+    unbound.mainloop.ptr_B = nullptr;
+    unbound.epilogue.ptr_C = nullptr;
+    unbound.epilogue.ptr_D = nullptr;
+
+    mutlass::Status status = gemm_op.initialize(unbound, workspace);
+    if (status != mutlass::Status::kSuccess) {
+      return status;
+    }
+
+    gemm_op.update_pointers(
+      arguments.mainloop.ptr_A,
+      arguments.mainloop.ptr_B,
+      arguments.epilogue.ptr_C,
+      arguments.epilogue.ptr_D);
+
+    return gemm_op.run();
+  }
+
+  /// Launches the GEMM on a grid covering an upper bound of the problem, with the problem size and
+  /// operands read from a device-side problem descriptor
+  mutlass::Status run_device_problem(Gemm &gemm_op, typename Gemm::Arguments const &arguments, void *workspace) {
+    using ProblemDescriptor = typename Gemm::GemmKernel::ProblemDescriptor;
+    using TileShape = typename Gemm::GemmKernel::TileShape;
+
+    auto problem_shape_MNKL = mute::append<4>(arguments.problem_shape, 1);
+
+    ProblemDescriptor problem;
+    problem.M = mute::get<0>(problem_shape_MNKL);
+    problem.N = mute::get<1>(problem_shape_MNKL);
+    problem.K = mute::get<2>(problem_shape_MNKL);
+    problem.L = mute::get<3>(problem_shape_MNKL);
+    problem.ptr_A = arguments.mainloop.ptr_A;
+    problem.ptr_B = arguments.mainloop.ptr_B;
+    problem.ptr_C = arguments.epilogue.ptr_C;
+    problem.ptr_D = arguments.epilogue.ptr_D;
+
+    mutlass::device_memory::allocation<ProblemDescriptor> device_problem(1);
+    mutlass::device_memory::copy_to_device(device_problem.get(), &problem);
+
+    // Launch CTAs beyond the problem in M and N, which must exit without writing D
+    typename Gemm::Arguments bounded = arguments;
+    mute::get<0>(bounded.problem_shape) += 2 * int(mute::size<0>(TileShape{}));
+    mute::get<1>(bounded.problem_shape) += int(mute::size<1>(TileShape{}));
+    bounded.mainloop.ptr_A = nullptr;
+    bounded.mainloop.ptr_B = nullptr;
+    bounded.epilogue.ptr_C = nullptr;
+    bounded.epilogue.ptr_D = nullptr;
+    bounded.problem_descriptor = device_problem.get();
+
+    mutlass::Status status = gemm_op.initialize(bounded, workspace);
+    if (status != mutlass::Status::kSuccess) {
+      return status;
+    }
+
+    status = gemm_op.run();
+
+    (void)musaDeviceSynchronize();
+    return status;
+  }
+
   /// Exemutes one test
   bool run(
     ProblemShapeType problem_size,
@@ -1467,8 +1569,21 @@ struct TestbedImpl {
     }
     else {
       musaError_t result;
-      status = gemm_op.initialize(arguments, workspace.get());
-      status = gemm_op.run();
+      if (launch_mode == LaunchMode::PREPARED) {
+        status = run_prepared(gemm_op, arguments, workspace.get());
+      }
+      else if (launch_mode == LaunchMode::DEVICE_PROBLEM) {
+        status = run_device_problem(gemm_op, arguments, workspace.get());
+      }
+      else {
+        status = gemm_op.initialize(arguments, workspace.get());
+        if (launch_mode == LaunchMode::GRAPH) {
+          status = run_graph(gemm_op);
+        }
+        else {
+          status = gemm_op.run();
+        }
+      }
       result = musaDeviceSynchronize();
       if (result != musaSuccess) {
         EXPECT_EQ(result, musaSuccess) << "Error at Kernel Sync.";
@@ -1600,11 +1715,13 @@ template <
   typename Gemm,
   template <class T> class ActivationFunctor = mutlass::epilogue::thread::Identity
 >
-bool TestAll(double alpha = 1.0, double beta = 0.0, CheckEquality check_relative_equality = CheckEquality::RELATIVE) {
+bool TestAll(double alpha = 1.0, double beta = 0.0, CheckEquality check_relative_equality = CheckEquality::RELATIVE,
+             LaunchMode launch_mode = LaunchMode::STREAM) {
   using ElementScalar = typename Gemm::EpilogueOutputOp::ElementScalar;
   using ProblemShapeType = typename Gemm::GemmKernel::ProblemShape;
 
   Testbed3x<Gemm, ActivationFunctor> testbed(check_relative_equality, ScalarLoc::ON_HOST, VectorBeta::DISABLED);
+  testbed.impl_.launch_mode = launch_mode;
 
   int max_alignment = std::max(Gemm::kAlignmentA, Gemm::kAlignmentB);
   std::vector<int> problem_size_m = {max_alignment, 512 - 3 * max_alignment};
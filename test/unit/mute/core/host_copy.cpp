@@ -0,0 +1,132 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#define MUTE_ENABLE_HOST_COPY
+
+#include "mutlass_unit_test.h"
+
+#include <numeric>
+#include <vector>
+
+#include <mute/tensor.hpp>
+#include <mute/algorithm/copy.hpp>
+
+using namespace mute;
+
+template <class SrcTensor, class DstTensor>
+void
+test_host_copy(SrcTensor const& src, DstTensor&& dst)
+{
+  MUTLASS_TRACE_HOST(src.layout() << "  =>  " << dst.layout());
+
+  copy(src, dst);
+
+  for (int i = 0; i < size(src); ++i) {
+    ASSERT_EQ(dst(i), src(i)) << "at " << i;
+  }
+}
+
+TEST(MuTe_core, HostCopy)
+{
+  int const m = 37;
+  int const n = 53;
+  std::vector<float> a(4 * m * n);
+  std::vector<float> b(4 * m * n);
+  std::iota(a.begin(), a.end(), 1.0f);
+
+  // Contiguous in both
+  test_host_copy(make_tensor(a.data(), make_shape(m, n)),
+                 make_tensor(b.data(), make_shape(m, n)));
+  EXPECT_EQ(b[m * n - 1], a[m * n - 1]);
+
+  // Transposing
+  test_host_copy(make_tensor(a.data(), make_shape(m, n)),
+                 make_tensor(b.data(), make_shape(m, n), LayoutRight{}));
+  test_host_copy(make_tensor(a.data(), make_shape(m, n), LayoutRight{}),
+                 make_tensor(b.data(), make_shape(m, n)));
+
+  // Padded leading dimension and batch mode
+  test_host_copy(make_tensor(a.data(), make_shape(m, n, 2), make_stride(_1{}, m + 3, (m + 3) * n)),
+                 make_tensor(b.data(), make_shape(m, n, 2)));
+  test_host_copy(make_tensor(a.data(), make_shape(m, n, 2), make_stride(n, _1{}, m * n)),
+                 make_tensor(b.data(), make_shape(m, n, 2), make_stride(_1{}, m + 1, (m + 1) * n)));
+
+  // Neither tensor is contiguous
+  test_host_copy(make_tensor(a.data(), make_shape(m, n), make_stride(2, 2 * m)),
+                 make_tensor(b.data(), make_shape(m, n), make_stride(3 * n, 3)));
+
+  // Broadcast source
+  test_host_copy(make_tensor(a.data(), make_shape(m, n), make_stride(_0{}, 1)),
+                 make_tensor(b.data(), make_shape(m, n)));
+
+  // Static inner mode with dynamic outer mode
+  test_host_copy(make_tensor(a.data(), make_shape(_8{}, n)),
+                 make_tensor(b.data(), make_shape(_8{}, n), make_stride(n, _1{})));
+
+  // Hierarchical shapes that flatten differently fall back to the element-wise copy
+  test_host_copy(make_tensor(a.data(), make_shape(make_shape(4, 8), n)),
+                 make_tensor(b.data(), make_shape(32, n)));
+
+  // Empty
+  test_host_copy(make_tensor(a.data(), make_shape(0, n)),
+                 make_tensor(b.data(), make_shape(0, n)));
+}
+
+TEST(MuTe_core, HostCopyOverlapping)
+{
+  // Shifting a buffer in place keeps the element-wise semantics
+  std::vector<int> a(64);
+  std::iota(a.begin(), a.end(), 0);
+
+  copy(make_tensor(a.data() + 1, make_shape(63)), make_tensor(a.data(), make_shape(63)));
+
+  for (int i = 0; i < 63; ++i) {
+    EXPECT_EQ(a[i], i + 1);
+  }
+}
+
+TEST(MuTe_core, HostCopyLarge)
+{
+  // Large enough to be split across threads
+  int const m = 1536;
+  int const n = 1024;
+  std::vector<float> a(m * n);
+  std::vector<float> b(m * n);
+  std::iota(a.begin(), a.end(), 0.0f);
+
+  test_host_copy(make_tensor(a.data(), make_shape(m, n)),
+                 make_tensor(b.data(), make_shape(m, n)));
+  test_host_copy(make_tensor(a.data(), make_shape(m, n)),
+                 make_tensor(b.data(), make_shape(m, n), LayoutRight{}));
+  test_host_copy(make_tensor(a.data(), make_shape(m / 2, n), make_stride(2, m)),
+                 make_tensor(b.data(), make_shape(m / 2, n), LayoutRight{}));
+}
@@ -0,0 +1,173 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#define MUTE_ENABLE_HOST_MMA_EMULATION
+
+#include "mutlass_unit_test.h"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <mute/tensor.hpp>
+#include <mute/atom/mma_atom.hpp>
+
+using namespace mute;
+
+// Runs D = A * B^T for an (M,N,K) tile through mute::gemm on host warps and compares it bitwise
+// against a reference that accumulates every element over ascending k in the accumulator type.
+template <class MMA_Op, class AtomLayoutMNK, class TileShape, class StrideA, class StrideB, class Gen>
+void
+test_mp22_host_mma(AtomLayoutMNK, TileShape tile_shape, StrideA, StrideB, Gen&& gen)
+{
+  using TiledMma = TiledMMA<MMA_Atom<MMA_Op>, AtomLayoutMNK>;
+  using TA   = typename TiledMma::ValTypeA;
+  using TB   = typename TiledMma::ValTypeB;
+  using TC   = typename TiledMma::ValTypeC;
+  using Acc  = conditional_t<is_integral<TC>::value, int32_t, float>;
+
+  TiledMma tiled_mma;
+  auto M = size<0>(tile_shape);
+  auto N = size<1>(tile_shape);
+  auto K = size<2>(tile_shape);
+
+  std::vector<TA> a(M * K);
+  std::vector<TB> b(N * K);
+  std::vector<TC> c(M * N);
+  for (auto& x : a) { x = gen(TA{}); }
+  for (auto& x : b) { x = gen(TB{}); }
+
+  Tensor gA = make_tensor(a.data(), make_shape(M, K), StrideA{});
+  Tensor gB = make_tensor(b.data(), make_shape(N, K), StrideB{});
+  Tensor gC = make_tensor(c.data(), make_shape(M, N));
+
+  launch_host_warps(size(tiled_mma) / HostWarp::NumLanes, [&](int thread_idx) {
+    auto thr_mma = tiled_mma.get_thread_slice(thread_idx);
+    Tensor tCgA = thr_mma.partition_A(gA);
+    Tensor tCgB = thr_mma.partition_B(gB);
+    Tensor tCgC = thr_mma.partition_C(gC);
+    Tensor tCrA = thr_mma.partition_fragment_A(gA);
+    Tensor tCrB = thr_mma.partition_fragment_B(gB);
+    Tensor tCrC = thr_mma.make_fragment_C(tCgC);
+
+    copy(tCgA, tCrA);
+    copy(tCgB, tCrB);
+    clear(tCrC);
+    gemm(tiled_mma, tCrC, tCrA, tCrB, tCrC);
+    copy(tCrC, tCgC);
+  });
+
+  for (int m = 0; m < M; ++m) {
+    for (int n = 0; n < N; ++n) {
+      Acc acc = 0;
+      for (int k = 0; k < K; ++k) {
+        Acc p = Acc(gA(m, k)) * Acc(gB(n, k));
+        acc = is_integral<Acc>::value ? Acc(uint32_t(acc) + uint32_t(p)) : Acc(acc + p);
+      }
+      TC ref = TC(acc);
+      ASSERT_EQ(std::memcmp(&gC(m, n), &ref, sizeof(TC)), 0)
+        << "at (" << m << "," << n << "): " << gC(m, n) << " != " << ref;
+    }
+  }
+}
+
+struct SmallIntegers
+{
+  std::mt19937 rng{2024};
+  template <class T>
+  T operator()(T) { return T(int(rng() % 7) - 3); }
+};
+
+struct RandomValues
+{
+  std::mt19937 rng{2023};
+
+  template <class T>
+  T operator()(T) {
+    if constexpr (is_integral<T>::value) {
+      return T(int(rng() % 256) - 128);
+    } else if constexpr (is_same<T, tfloat32_t>::value) {
+      // Keep the low mantissa bits the hardware ignores
+      float x = std::uniform_real_distribution<float>(-1.0f, 1.0f)(rng);
+      uint32_t bits;
+      std::memcpy(&bits, &x, sizeof(bits));
+      return tfloat32_t::bitcast(bits);
+    } else {
+      return T(std::uniform_real_distribution<float>(-1.0f, 1.0f)(rng));
+    }
+  }
+};
+
+TEST(MuTe_core, MP22HostMma_F16)
+{
+  auto tile = make_shape(_32{}, _32{}, _32{});
+  test_mp22_host_mma<MP22_32x32x16_F32F16F16F32_TT>(Layout<Shape<_1,_1,_1>>{}, tile, GenRowMajor{}, GenColMajor{}, SmallIntegers{});
+  test_mp22_host_mma<MP22_32x32x16_F32F16F16F32_TN>(Layout<Shape<_1,_1,_1>>{}, tile, GenRowMajor{}, GenRowMajor{}, SmallIntegers{});
+  test_mp22_host_mma<MP22_32x32x16_F32F16F16F32_NT>(Layout<Shape<_1,_1,_1>>{}, tile, GenColMajor{}, GenColMajor{}, RandomValues{});
+  test_mp22_host_mma<MP22_32x32x16_F32F16F16F32_NN>(Layout<Shape<_1,_1,_1>>{}, tile, GenColMajor{}, GenRowMajor{}, RandomValues{});
+}
+
+TEST(MuTe_core, MP22HostMma_BF16)
+{
+  auto tile = make_shape(_32{}, _32{}, _32{});
+  test_mp22_host_mma<MP22_32x32x16_F32BF16BF16F32_TT>(Layout<Shape<_1,_1,_1>>{}, tile, GenRowMajor{}, GenColMajor{}, RandomValues{});
+  test_mp22_host_mma<MP22_32x32x16_F32BF16BF16F32_TN>(Layout<Shape<_1,_1,_1>>{}, tile, GenRowMajor{}, GenRowMajor{}, RandomValues{});
+  test_mp22_host_mma<MP22_32x32x16_F32BF16BF16F32_NT>(Layout<Shape<_1,_1,_1>>{}, tile, GenColMajor{}, GenColMajor{}, SmallIntegers{});
+  test_mp22_host_mma<MP22_32x32x16_F32BF16BF16F32_NN>(Layout<Shape<_1,_1,_1>>{}, tile, GenColMajor{}, GenRowMajor{}, SmallIntegers{});
+}
+
+TEST(MuTe_core, MP22HostMma_TF32)
+{
+  auto tile = make_shape(_32{}, _32{}, _16{});
+  test_mp22_host_mma<MP22_32x32x8_F32TF32TF32F32_TT>(Layout<Shape<_1,_1,_1>>{}, tile, GenRowMajor{}, GenColMajor{}, RandomValues{});
+  test_mp22_host_mma<MP22_32x32x8_F32TF32TF32F32_TN>(Layout<Shape<_1,_1,_1>>{}, tile, GenRowMajor{}, GenRowMajor{}, RandomValues{});
+  test_mp22_host_mma<MP22_32x32x8_F32TF32TF32F32_NT>(Layout<Shape<_1,_1,_1>>{}, tile, GenColMajor{}, GenColMajor{}, SmallIntegers{});
+  test_mp22_host_mma<MP22_32x32x8_F32TF32TF32F32_NN>(Layout<Shape<_1,_1,_1>>{}, tile, GenColMajor{}, GenRowMajor{}, SmallIntegers{});
+}
+
+TEST(MuTe_core, MP22HostMma_S8)
+{
+  auto tile = make_shape(_32{}, _32{}, _64{});
+  test_mp22_host_mma<MP22_32x32x32_S32S8S8S32_TT>(Layout<Shape<_1,_1,_1>>{}, tile, GenRowMajor{}, GenColMajor{}, RandomValues{});
+  test_mp22_host_mma<MP22_32x32x32_S32S8S8S32_TN>(Layout<Shape<_1,_1,_1>>{}, tile, GenRowMajor{}, GenRowMajor{}, RandomValues{});
+  test_mp22_host_mma<MP22_32x32x32_S32S8S8S32_NT>(Layout<Shape<_1,_1,_1>>{}, tile, GenColMajor{}, GenColMajor{}, RandomValues{});
+  test_mp22_host_mma<MP22_32x32x32_S32S8S8S32_NN>(Layout<Shape<_1,_1,_1>>{}, tile, GenColMajor{}, GenRowMajor{}, RandomValues{});
+}
+
+TEST(MuTe_core, MP22HostMma_TiledAtoms)
+{
+  // Four warps over a 2x2 atom layout, each covering two atoms along M and N and four k-blocks
+  auto tile = make_shape(_128{}, _128{}, _64{});
+  test_mp22_host_mma<MP22_32x32x16_F32F16F16F32_TN>(Layout<Shape<_2,_2,_1>>{}, tile, GenRowMajor{}, GenRowMajor{}, RandomValues{});
+  test_mp22_host_mma<MP22_32x32x16_F32BF16BF16F32_NT>(Layout<Shape<_2,_2,_1>, Stride<_2,_1,_0>>{}, tile, GenColMajor{}, GenColMajor{}, RandomValues{});
+}
@@ -265,3 +265,36 @@ TEST(MuTe_core, Tuple)
     MUTLASS_TRACE_HOST("a(_,1,_,(1,2)) = " << dice(make_coord(_,1,_,make_coord(1,2)), a));
   }
 }
+
+TEST(MuTe_core, TupleAccess)
+{
+  using namespace mute;
+
+  using T = tuple<_1, int, tuple<_2, float>, _3, int64_t>;
+  T t(_1{}, 7, tuple<_2, float>(_2{}, 1.5f), _3{}, int64_t(9));
+
+  MUTE_STATIC_ASSERT(is_same_v<std::tuple_element_t<0, T>, _1>);
+  MUTE_STATIC_ASSERT(is_same_v<std::tuple_element_t<2, T>, tuple<_2, float>>);
+  MUTE_STATIC_ASSERT(is_same_v<std::tuple_element_t<4, T const>, int64_t const>);
+
+  // Static elements are returned by value, dynamic elements by reference
+  MUTE_STATIC_ASSERT(is_same_v<decltype(get<0>(t)), _1>);
+  MUTE_STATIC_ASSERT(is_same_v<decltype(get<1>(t)), int&>);
+  MUTE_STATIC_ASSERT(is_same_v<decltype(get<1>(static_cast<T const&>(t))), int const&>);
+  MUTE_STATIC_ASSERT(is_same_v<decltype(get<1>(static_cast<T&&>(t))), int&&>);
+
+  get<1>(t) = 8;
+  ASSERT_EQ(get<1>(t), 8);
+  ASSERT_EQ(get<1>(get<2>(t)), 1.5f);
+  ASSERT_EQ(get<4>(t), 9);
+  ASSERT_EQ(sizeof(T), sizeof(tuple<int, tuple<float>, int64_t>));
+
+  // Equality is static whenever any compared element pair is statically unequal or all are static
+  MUTE_STATIC_ASSERT_V((make_tuple(_1{}, _2{}) == make_tuple(_1{}, _2{})));
+  MUTE_STATIC_ASSERT_V((make_tuple(_1{}, _2{}) != make_tuple(_1{}, _3{})));
+  MUTE_STATIC_ASSERT_V((make_tuple(_1{}, _2{}) != make_tuple(_1{})));
+  MUTE_STATIC_ASSERT_V((make_tuple(1, _2{}) != make_tuple(1, _3{})));
+  MUTE_STATIC_ASSERT(is_same_v<decltype(make_tuple(1, _2{}) == make_tuple(1, _2{})), bool>);
+  ASSERT_TRUE((make_tuple(1, _2{}, 3) == make_tuple(1, _2{}, 3)));
+  ASSERT_TRUE((make_tuple(1, _2{}, 3) != make_tuple(1, _2{}, 4)));
+}
@@ -0,0 +1,202 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include "mutlass_unit_test.h"
+
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "mutlass/profiler/performance_baseline.h"
+
+namespace {
+
+char const *kBaselineReport =
+  "{\"problem\":1,\"provider\":\"mutlass\",\"operation_kind\":\"gemm\","
+  "\"operation\":\"mutlass_mp22_simt_sgemm_128x128x8_tn_align1\",\"disposition\":\"passed\","
+  "\"status\":\"success\",\"arguments\":{\"m\":\"1024\",\"n\":\"512\",\"k\":\"256\"},"
+  "\"bytes\":4194304,\"flops\":268435456,\"runtime\":0.5,\"gbytes_per_sec\":7.8,\"gflops_per_sec\":536.8}\n"
+  "\n"
+  "{\"tags\":{\"build\":\"rc\\\"1\\\"\"},\"problem\":2,\"provider\":\"mutlass\",\"operation_kind\":\"gemm\","
+  "\"operation\":\"mutlass_mp22_simt_sgemm_128x128x8_tn_align1\",\"disposition\":\"passed\","
+  "\"status\":\"success\",\"arguments\":{\"k\":\"512\",\"n\":\"512\",\"m\":\"1024\"},"
+  "\"bytes\":4194304,\"flops\":536870912,\"runtime\":1.0,\"gflops_per_sec\":536.8,"
+  "\"iterations\":100,\"runtime_p50\":0.99}\n";
+
+} // namespace anonymous
+
+TEST(Profiler_PerformanceBaseline, Load)
+{
+  using namespace mutlass::profiler;
+
+  std::stringstream ss(kBaselineReport);
+
+  PerformanceBaseline baseline;
+  ASSERT_TRUE(baseline.load(ss));
+  EXPECT_EQ(baseline.size(), 2);
+
+  // Arguments are joined irrespective of their order
+  BaselineResult const *result = baseline.find(PerformanceBaseline::make_key(
+    "mutlass", "mutlass_mp22_simt_sgemm_128x128x8_tn_align1",
+    {{"m", "1024"}, {"n", "512"}, {"k", "512"}, {"cache_mode", "cold"}}));
+
+  ASSERT_NE(result, nullptr);
+  EXPECT_DOUBLE_EQ(result->runtime, 1.0);
+  EXPECT_DOUBLE_EQ(result->gflops_per_sec, 536.8);
+
+  EXPECT_EQ(baseline.find(PerformanceBaseline::make_key(
+    "mublas", "mutlass_mp22_simt_sgemm_128x128x8_tn_align1",
+    {{"m", "1024"}, {"n", "512"}, {"k", "512"}, {"cache_mode", "cold"}})), nullptr);
+
+  EXPECT_EQ(baseline.find(PerformanceBaseline::make_key(
+    "mutlass", "mutlass_mp22_simt_sgemm_128x128x8_tn_align1",
+    {{"m", "1024"}, {"n", "512"}, {"k", "128"}, {"cache_mode", "cold"}})), nullptr);
+}
+
+TEST(Profiler_PerformanceBaseline, CacheMode)
+{
+  using namespace mutlass::profiler;
+
+  std::stringstream ss(
+    "{\"provider\":\"mutlass\",\"operation\":\"gemm\",\"status\":\"success\",\"cache_mode\":\"cold\","
+    "\"arguments\":{\"m\":\"64\"},\"runtime\":2.0}\n"
+    "{\"provider\":\"mutlass\",\"operation\":\"gemm\",\"status\":\"success\",\"cache_mode\":\"warm\","
+    "\"arguments\":{\"m\":\"64\"},\"runtime\":1.0}\n");
+
+  PerformanceBaseline baseline;
+  ASSERT_TRUE(baseline.load(ss));
+  EXPECT_EQ(baseline.size(), 2);
+
+  // Each cache mode is compared against its own baseline
+  BaselineResult const *cold = baseline.find(PerformanceBaseline::make_key(
+    "mutlass", "gemm", {{"m", "64"}, {"cache_mode", "cold"}}));
+  BaselineResult const *warm = baseline.find(PerformanceBaseline::make_key(
+    "mutlass", "gemm", {{"cache_mode", "warm"}, {"m", "64"}}));
+
+  ASSERT_NE(cold, nullptr);
+  ASSERT_NE(warm, nullptr);
+  EXPECT_DOUBLE_EQ(cold->runtime, 2.0);
+  EXPECT_DOUBLE_EQ(warm->runtime, 1.0);
+}
+
+TEST(Profiler_PerformanceBaseline, CacheModeDefault)
+{
+  using namespace mutlass::profiler;
+
+  std::stringstream ss(
+    "{\"provider\":\"mutlass\",\"operation\":\"gemm\",\"status\":\"success\","
+    "\"arguments\":{\"m\":\"64\"},\"runtime\":2.0}\n");
+
+  PerformanceBaseline baseline;
+  ASSERT_TRUE(baseline.load(ss));
+
+  // Entries without a cache mode are treated as cold measurements
+  EXPECT_NE(baseline.find(PerformanceBaseline::make_key(
+    "mutlass", "gemm", {{"m", "64"}, {"cache_mode", "cold"}})), nullptr);
+  EXPECT_EQ(baseline.find(PerformanceBaseline::make_key(
+    "mutlass", "gemm", {{"m", "64"}, {"cache_mode", "warm"}})), nullptr);
+}
+
+TEST(Profiler_PerformanceBaseline, OperationKind)
+{
+  using namespace mutlass::profiler;
+
+  // Baseline written by a GEMM-only run, used by a run profiling GEMM and FMHA operations
+  std::string const report(
+    "{\"provider\":\"mutlass\",\"operation_kind\":\"gemm\",\"operation\":\"gemm\","
+    "\"status\":\"success\",\"arguments\":{\"m\":\"64\"},\"runtime\":2.0}\n");
+
+  std::stringstream gemm_ss(report);
+  PerformanceBaseline gemm_baseline;
+  ASSERT_TRUE(gemm_baseline.load(gemm_ss, "gemm"));
+  EXPECT_EQ(gemm_baseline.size(), 1);
+
+  // The FMHA report is left without a baseline, so its results are not reported as unmatched
+  std::stringstream fmha_ss(report);
+  PerformanceBaseline fmha_baseline;
+  ASSERT_TRUE(fmha_baseline.load(fmha_ss, "fmha"));
+  EXPECT_EQ(fmha_baseline.size(), 0);
+
+  std::stringstream all_ss(report);
+  PerformanceBaseline all_baseline;
+  ASSERT_TRUE(all_baseline.load(all_ss));
+  EXPECT_EQ(all_baseline.size(), 1);
+}
+
+TEST(Profiler_PerformanceBaseline, Malformed)
+{
+  using namespace mutlass::profiler;
+
+  std::stringstream ss("{\"operation\":\"gemm\",\"runtime\":1.0\n");
+
+  PerformanceBaseline baseline;
+  EXPECT_FALSE(baseline.load(ss));
+}
+
+TEST(Profiler_PerformanceBaseline, Compare)
+{
+  using namespace mutlass::profiler;
+
+  BaselineResult baseline;
+  baseline.runtime = 1.0;
+  baseline.gflops_per_sec = 100.0;
+
+  BaselineComparison faster = PerformanceBaseline::compare(baseline, 0.9, 111.1, 0.05);
+  EXPECT_FALSE(faster.regressed);
+  EXPECT_NEAR(faster.runtime_change, -0.1, 1e-12);
+
+  BaselineComparison noise = PerformanceBaseline::compare(baseline, 1.04, 96.2, 0.05);
+  EXPECT_FALSE(noise.regressed);
+
+  BaselineComparison slower = PerformanceBaseline::compare(baseline, 1.1, 90.9, 0.05);
+  EXPECT_TRUE(slower.regressed);
+  EXPECT_NEAR(slower.runtime_change, 0.1, 1e-12);
+  EXPECT_NEAR(slower.gflops_change, -0.091, 1e-12);
+}
+
+TEST(Profiler_PerformanceBaseline, EscapeJsonString)
+{
+  using namespace mutlass::profiler;
+
+  EXPECT_EQ(escape_json_string("plain"), "plain");
+  EXPECT_EQ(escape_json_string("a\"b\\c\n"), "a\\\"b\\\\c\\n");
+  EXPECT_EQ(escape_json_string(std::string(1, '\x01')), "\\u0001");
+}
+
+TEST(Profiler_PerformanceBaseline, JsonNumber)
+{
+  using namespace mutlass::profiler;
+
+  EXPECT_EQ(json_number(0.5), "0.5");
+  EXPECT_EQ(json_number(std::numeric_limits<double>::infinity()), "null");
+  EXPECT_EQ(json_number(std::numeric_limits<double>::quiet_NaN()), "null");
+}
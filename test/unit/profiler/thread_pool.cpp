@@ -0,0 +1,101 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include "mutlass_unit_test.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "mutlass/profiler/thread_pool.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(Profiler_ThreadPool, Submit)
+{
+  using namespace mutlass::profiler;
+
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.thread_count(), 4);
+
+  std::vector<std::future<int>> results;
+  for (int idx = 0; idx < 64; ++idx) {
+    results.push_back(pool.submit([idx]() { return idx * idx; }));
+  }
+
+  for (int idx = 0; idx < 64; ++idx) {
+    EXPECT_EQ(results.at(idx).get(), idx * idx);
+  }
+}
+
+TEST(Profiler_ThreadPool, Exception)
+{
+  using namespace mutlass::profiler;
+
+  ThreadPool pool(1);
+
+  std::future<int> result = pool.submit([]() -> int { throw std::runtime_error("reference failed"); });
+  EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST(Profiler_ThreadPool, Synchronous)
+{
+  using namespace mutlass::profiler;
+
+  ThreadPool pool(0);
+
+  std::thread::id caller = std::this_thread::get_id();
+  std::future<std::thread::id> result = pool.submit([]() { return std::this_thread::get_id(); });
+
+  EXPECT_EQ(result.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+  EXPECT_EQ(result.get(), caller);
+}
+
+TEST(Profiler_ThreadPool, DrainOnDestruction)
+{
+  using namespace mutlass::profiler;
+
+  std::atomic<int> count(0);
+  {
+    ThreadPool pool(2);
+    for (int idx = 0; idx < 32; ++idx) {
+      pool.enqueue([&count]() { ++count; });
+    }
+  }
+
+  EXPECT_EQ(count.load(), 32);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,140 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include "mutlass_unit_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "mutlass/profiler/timing_statistics.h"
+
+TEST(Profiler_TimingStatistics, Empty)
+{
+  using namespace mutlass::profiler;
+
+  TimingStatistics stats = compute_timing_statistics({});
+
+  EXPECT_FALSE(stats.good());
+  EXPECT_EQ(stats.iterations, 0);
+}
+
+TEST(Profiler_TimingStatistics, Summary)
+{
+  using namespace mutlass::profiler;
+
+  // 1, 2, ..., 101 in shuffled order
+  std::vector<double> samples;
+  for (int i = 1; i <= 101; ++i) {
+    samples.push_back(double(i));
+  }
+  std::shuffle(samples.begin(), samples.end(), std::mt19937(2019));
+
+  TimingStatistics stats = compute_timing_statistics(samples);
+
+  EXPECT_TRUE(stats.good());
+  EXPECT_EQ(stats.iterations, 101);
+  EXPECT_DOUBLE_EQ(stats.min, 1);
+  EXPECT_DOUBLE_EQ(stats.max, 101);
+  EXPECT_DOUBLE_EQ(stats.mean, 51);
+  EXPECT_DOUBLE_EQ(stats.p50, 51);
+  EXPECT_DOUBLE_EQ(stats.p90, 91);
+  EXPECT_DOUBLE_EQ(stats.p99, 100);
+
+  // Sample standard deviation of 1..n is sqrt(n * (n + 1) / 12)
+  EXPECT_NEAR(stats.stddev, std::sqrt(101.0 * 102.0 / 12.0), 1e-9);
+}
+
+TEST(Profiler_TimingStatistics, Percentile)
+{
+  using namespace mutlass::profiler;
+
+  std::vector<double> sorted = {1, 2, 3, 4};
+
+  EXPECT_DOUBLE_EQ(percentile(sorted, 0), 1);
+  EXPECT_DOUBLE_EQ(percentile(sorted, 50), 2.5);
+  EXPECT_DOUBLE_EQ(percentile(sorted, 100), 4);
+  EXPECT_DOUBLE_EQ(percentile({7}, 99), 7);
+  EXPECT_DOUBLE_EQ(percentile({}, 50), 0);
+}
+
+TEST(Profiler_TimingStatistics, MedianConfidenceInterval)
+{
+  using namespace mutlass::profiler;
+
+  // Too few samples to bound the median
+  EXPECT_LT(median_confidence_interval({1, 1, 1, 1}), 0);
+  EXPECT_FALSE(median_confidence_satisfied({1, 1, 1, 1}, 1.0));
+
+  // Constant samples converge immediately
+  std::vector<double> constant(16, 2.0);
+  EXPECT_DOUBLE_EQ(median_confidence_interval(constant), 0);
+  EXPECT_TRUE(median_confidence_satisfied(constant, 0.01));
+
+  // 100 samples: ranks 40 and 61 bound the median 50.5
+  std::vector<double> linear;
+  for (int i = 1; i <= 100; ++i) {
+    linear.push_back(double(i));
+  }
+  std::reverse(linear.begin(), linear.end());
+
+  EXPECT_NEAR(median_confidence_interval(linear), (61.0 - 40.0) / 2.0 / 50.5, 1e-12);
+  EXPECT_TRUE(median_confidence_satisfied(linear, 0.25));
+  EXPECT_FALSE(median_confidence_satisfied(linear, 0.1));
+}
+
+TEST(Profiler_TimingStatistics, MedianConfidenceNarrowsWithSamples)
+{
+  using namespace mutlass::profiler;
+
+  std::mt19937 rng(2019);
+  std::normal_distribution<double> dist(1.0, 0.05);
+
+  std::vector<double> samples;
+  double previous = -1;
+
+  for (int n : {32, 256, 2048}) {
+    while (int(samples.size()) < n) {
+      samples.push_back(dist(rng));
+    }
+
+    double interval = median_confidence_interval(samples);
+    EXPECT_GT(interval, 0);
+    if (previous > 0) {
+      EXPECT_LT(interval, previous);
+    }
+    previous = interval;
+  }
+
+  EXPECT_TRUE(median_confidence_satisfied(samples, 0.01));
+}
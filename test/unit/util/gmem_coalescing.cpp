@@ -0,0 +1,182 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Tests for the global memory coalescing analysis
+*/
+
+#include "mutlass_unit_test.h"
+
+#include "mute/tensor.hpp"
+#include "mute/atom/mma_atom.hpp"
+#include "mute/atom/copy_atom.hpp"
+
+#include "mutlass/gemm/collective/collective_builder.hpp"
+
+#include "mutlass/util/packed_stride.hpp"
+#include "mutlass/util/gmem_coalescing.hpp"
+
+using namespace mute;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// 128 threads each copying one float, thread i owning row i of the tile
+using RowPerThreadCopy = decltype(make_tiled_copy(
+  Copy_Atom<UniversalCopy<uint32_t>, float>{},
+  Layout<Shape<_128, _1>>{},
+  Layout<Shape<_1, _1>>{}));
+
+template <class OpClass, class Element, int Alignment, class LayoutA, class LayoutB, class TileShape, class AtomLayout>
+using Mainloop = typename mutlass::gemm::collective::CollectiveBuilder<
+    mutlass::arch::Mp22, OpClass,
+    Element, LayoutA, Alignment,
+    Element, LayoutB, Alignment,
+    float,
+    TileShape, Shape<_1,_1,_1>, AtomLayout,
+    mutlass::gemm::collective::PermuteLayoutAuto,
+    mutlass::gemm::collective::StageCountAuto,
+    mutlass::gemm::collective::KernelScheduleAuto
+  >::CollectiveOp;
+
+// Every tile load of a builder-generated mainloop must coalesce perfectly for packed operands
+// and use the full access width allowed by its alignment
+template <class Mainloop>
+void verify_mainloop(int alignment_bits, int m = 4096, int n = 4096, int k = 4096) {
+  auto dA = mutlass::make_mute_packed_stride(typename Mainloop::StrideA{}, make_shape(m, k, 1));
+  auto dB = mutlass::make_mute_packed_stride(typename Mainloop::StrideB{}, make_shape(n, k, 1));
+
+  auto report = mutlass::analysis::analyze_mainloop_gmem<Mainloop>(dA, dB);
+
+  MUTLASS_TRACE_HOST("load A " << report.load_a);
+  MUTLASS_TRACE_HOST("load B " << report.load_b);
+
+  EXPECT_TRUE(report.coalesced());
+  EXPECT_DOUBLE_EQ(report.load_a.efficiency(), 1.0);
+  EXPECT_DOUBLE_EQ(report.load_b.efficiency(), 1.0);
+  EXPECT_EQ(report.load_a.vector_bits, alignment_bits);
+  EXPECT_EQ(report.load_b.vector_bits, alignment_bits);
+}
+
+template <class OpClass, class Element, int Alignment, class TileShape, class AtomLayout>
+void verify_all_layouts() {
+  using R = mutlass::layout::RowMajor;
+  using C = mutlass::layout::ColumnMajor;
+  int const bits = Alignment * sizeof_bits_v<Element>;
+  verify_mainloop<Mainloop<OpClass, Element, Alignment, C, C, TileShape, AtomLayout>>(bits);
+  verify_mainloop<Mainloop<OpClass, Element, Alignment, C, R, TileShape, AtomLayout>>(bits);
+  verify_mainloop<Mainloop<OpClass, Element, Alignment, R, C, TileShape, AtomLayout>>(bits);
+  verify_mainloop<Mainloop<OpClass, Element, Alignment, R, R, TileShape, AtomLayout>>(bits);
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(GmemCoalescing, contiguous) {
+  auto report = mutlass::analysis::analyze_gmem_load(
+    RowPerThreadCopy{}, make_layout(make_shape(_128{}, _1{}), make_stride(_1{}, 4096)));
+
+  MUTLASS_TRACE_HOST(report);
+
+  // 128 floats are 16 transactions of 32 bytes
+  EXPECT_EQ(report.instructions, 1);
+  EXPECT_EQ(report.transactions, 16);
+  EXPECT_TRUE(report.coalesced());
+  EXPECT_EQ(report.bytes_used, 512);
+  EXPECT_EQ(report.vector_bits, 32);
+}
+
+TEST(GmemCoalescing, strided) {
+  auto report = mutlass::analysis::analyze_gmem_load(
+    RowPerThreadCopy{}, make_layout(make_shape(_128{}, _1{}), make_stride(2, 1)));
+
+  EXPECT_EQ(report.transactions, 32);
+  EXPECT_DOUBLE_EQ(report.efficiency(), 0.5);
+
+  // One transaction per thread when every row lives in a different segment
+  report = mutlass::analysis::analyze_gmem_store(
+    RowPerThreadCopy{}, make_layout(make_shape(_128{}, _1{}), make_stride(1000, 1)));
+
+  MUTLASS_TRACE_HOST(report);
+
+  EXPECT_EQ(report.transactions, 128);
+  EXPECT_DOUBLE_EQ(report.transactions_per_instruction(), 128.0);
+  EXPECT_DOUBLE_EQ(report.efficiency(), 4.0 / 32.0);
+}
+
+TEST(GmemCoalescing, misaligned_base) {
+  mutlass::analysis::GmemTransactionModel model;
+  model.base_offset = 16;
+
+  auto report = mutlass::analysis::analyze_gmem_load(
+    RowPerThreadCopy{}, make_layout(make_shape(_128{}, _1{}), make_stride(_1{}, 4096)), model);
+
+  EXPECT_EQ(report.transactions, 17);
+  EXPECT_EQ(report.ideal_transactions, 16);
+  EXPECT_FALSE(report.coalesced());
+}
+
+TEST(GmemCoalescing, runtime_stride_limits_vector_width) {
+  using Loop = Mainloop<mutlass::arch::OpClassTensorOp, mutlass::half_t, 8,
+                        mutlass::layout::RowMajor, mutlass::layout::ColumnMajor,
+                        Shape<_128, _128, _32>, Layout<Shape<_2, _2, _1>>>;
+
+  // A leading dimension that is only a multiple of 2 elements breaks the 128-bit accesses
+  auto dA = make_stride(int64_t(4098), _1{}, int64_t(0));
+  auto dB = mutlass::make_mute_packed_stride(typename Loop::StrideB{}, make_shape(4096, 4096, 1));
+  auto report = mutlass::analysis::analyze_mainloop_gmem<Loop>(dA, dB);
+
+  MUTLASS_TRACE_HOST(report.load_a);
+
+  EXPECT_EQ(report.load_a.vector_bits, 32);
+  EXPECT_EQ(report.load_b.vector_bits, 128);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(GmemCoalescing, mp22_tensorop_builder) {
+  using Atoms = Layout<Shape<_2, _2, _1>>;
+  verify_all_layouts<mutlass::arch::OpClassTensorOp, mutlass::half_t,     8, Shape<_128, _128, _32>, Atoms>();
+  verify_all_layouts<mutlass::arch::OpClassTensorOp, mutlass::bfloat16_t, 8, Shape<_128, _128, _32>, Atoms>();
+  verify_all_layouts<mutlass::arch::OpClassTensorOp, float,               4, Shape<_128, _128, _16>, Atoms>();
+  verify_all_layouts<mutlass::arch::OpClassTensorOp, int8_t,             16, Shape<_128, _128, _64>, Atoms>();
+}
+
+TEST(GmemCoalescing, mp22_simt_builder) {
+  using Atoms = Layout<Shape<_16, _8, _1>>;
+  verify_all_layouts<mutlass::arch::OpClassSimt, float, 1, Shape<_128, _128, _8>, Atoms>();
+  verify_all_layouts<mutlass::arch::OpClassSimt, float, 4, Shape<_128, _128, _8>, Atoms>();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
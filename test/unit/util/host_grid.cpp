@@ -0,0 +1,239 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+
+/*! \file
+    \brief Tests for the host simulation of GemmUniversal kernels
+*/
+
+// Defines the built-in variables of the simulated threads, so it comes before any kernel header
+#include "mutlass/util/host_grid.hpp"
+
+#include "mutlass_unit_test.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "mute/tensor.hpp"
+#include "mute/atom/mma_atom.hpp"
+#include "mute/atom/copy_atom.hpp"
+
+#include "mutlass/gemm/collective/collective_builder.hpp"
+#include "mutlass/epilogue/collective/collective_builder.hpp"
+#include "mutlass/gemm/kernel/gemm_universal.hpp"
+
+#include "mutlass/util/packed_stride.hpp"
+
+using namespace mute;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+template <class OpClass, class Element, class TileShape, class AtomLayout, int AlignmentA, int AlignmentB,
+          class Permutation = mutlass::gemm::collective::PermuteLayoutAuto>
+struct Mp22Gemm {
+  using CollectiveEpilogue = typename mutlass::epilogue::collective::CollectiveBuilder<
+      mutlass::arch::Mp22, OpClass,
+      TileShape, Shape<_1,_1,_1>,
+      mutlass::epilogue::collective::EpilogueTileAuto,
+      float, float,
+      float, mutlass::layout::ColumnMajor, 1,
+      float, mutlass::layout::ColumnMajor, 1,
+      mutlass::epilogue::collective::EpilogueScheduleAuto
+    >::CollectiveOp;
+
+  using CollectiveMainloop = typename mutlass::gemm::collective::CollectiveBuilder<
+      mutlass::arch::Mp22, OpClass,
+      Element, mutlass::layout::RowMajor, AlignmentA,
+      Element, mutlass::layout::ColumnMajor, AlignmentB,
+      float,
+      TileShape, Shape<_1,_1,_1>,
+      AtomLayout,
+      Permutation,
+      mutlass::gemm::collective::StageCountAuto,
+      mutlass::gemm::collective::KernelScheduleAuto
+    >::CollectiveOp;
+
+  using Kernel = mutlass::gemm::kernel::GemmUniversal<
+      Shape<int,int,int,int>,
+      CollectiveMainloop,
+      CollectiveEpilogue>;
+};
+
+// Runs D = alpha * A * B + beta * C with a row-major A, a column-major B and column-major C and D
+// on the simulated grid
+template <class GemmKernel, class Element>
+std::vector<float>
+run_host_gemm(int M, int N, int K,
+              std::vector<Element> const& A, std::vector<Element> const& B, std::vector<float> const& C,
+              float alpha, float beta, mutlass::simulation::HostGridOptions const& options = {}) {
+  std::vector<float> D(size_t(M) * N, -1.0f);
+
+  typename GemmKernel::Arguments args{
+    mutlass::gemm::GemmUniversalMode::kGemm,
+    {M, N, K, 1},
+    {A.data(), mutlass::make_mute_packed_stride(typename GemmKernel::StrideA{}, make_shape(M, K, 1)),
+     B.data(), mutlass::make_mute_packed_stride(typename GemmKernel::StrideB{}, make_shape(N, K, 1))},
+    {{alpha, beta},
+     C.data(), mutlass::make_mute_packed_stride(typename GemmKernel::StrideC{}, make_shape(M, N, 1)),
+     D.data(), mutlass::make_mute_packed_stride(typename GemmKernel::StrideD{}, make_shape(M, N, 1))}
+  };
+  EXPECT_TRUE(GemmKernel::can_implement(args));
+
+  auto params = GemmKernel::to_underlying_arguments(args, nullptr);
+  mutlass::simulation::launch_host_kernel<GemmKernel>(params, options);
+  return D;
+}
+
+// Accumulates every element over ascending k in fp32, the order of the host MMA emulation
+template <class Element>
+float
+reference_dot(int m, int n, int K, std::vector<Element> const& A, std::vector<Element> const& B) {
+  float acc = 0.0f;
+  for (int k = 0; k < K; ++k) {
+    acc += float(A[size_t(m) * K + k]) * float(B[size_t(n) * K + k]);
+  }
+  return acc;
+}
+
+template <class Element, class Gen>
+std::vector<Element>
+make_block(size_t size, Gen&& gen) {
+  std::vector<Element> block(size);
+  for (auto& x : block) {
+    x = Element(gen());
+  }
+  return block;
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostGrid, grid_builtins) {
+  struct Kernel {
+    struct Params {
+      int* out;
+    };
+    void operator()(Params const& params, char* smem) {
+      // Every thread publishes its index through shared memory and reads its neighbour's
+      int* slots = reinterpret_cast<int*>(smem);
+      slots[threadIdx.x] = int(threadIdx.x);
+      __syncthreads();
+      int neighbour = slots[(threadIdx.x + 1) % blockDim.x];
+      int cta = int(blockIdx.x + gridDim.x * blockIdx.y);
+      params.out[cta * blockDim.x + threadIdx.x] = cta * 1000 + neighbour;
+    }
+  };
+
+  dim3 grid(3, 2, 1);
+  dim3 block(160, 1, 1);
+  std::vector<int> out(6 * 160, -1);
+  mutlass::simulation::launch_host_grid<Kernel>({out.data()}, grid, block, 160 * sizeof(int), {4});
+
+  for (int cta = 0; cta < 6; ++cta) {
+    for (int t = 0; t < 160; ++t) {
+      EXPECT_EQ(out[cta * 160 + t], cta * 1000 + (t + 1) % 160);
+    }
+  }
+}
+
+TEST(HostGrid, mp22_tensorop_gemm_residues) {
+  using GemmKernel = Mp22Gemm<mutlass::arch::OpClassTensorOp, half_t, Shape<_128,_128,_32>, Layout<Shape<_1,_1,_1>>, 8, 8>::Kernel;
+
+  // Partial tiles along M and N and a k-residue, with values for which every result is exact
+  int M = 200, N = 136, K = 72;
+  std::mt19937 rng(2024);
+  auto small = [&] { return int(rng() % 7) - 3; };
+  auto A = make_block<half_t>(size_t(M) * K, small);
+  auto B = make_block<half_t>(size_t(N) * K, small);
+  auto C = make_block<float>(size_t(M) * N, small);
+
+  auto D = run_host_gemm<GemmKernel>(M, N, K, A, B, C, 2.0f, -1.0f, {2});
+
+  for (int n = 0; n < N; ++n) {
+    for (int m = 0; m < M; ++m) {
+      float ref = 2.0f * reference_dot(m, n, K, A, B) - C[m + size_t(n) * M];
+      ASSERT_EQ(D[m + size_t(n) * M], ref) << "at (" << m << "," << n << ")";
+    }
+  }
+}
+
+TEST(HostGrid, mp22_tensorop_gemm_bitwise) {
+  using GemmKernel = Mp22Gemm<mutlass::arch::OpClassTensorOp, bfloat16_t, Shape<_128,_128,_32>, Layout<Shape<_1,_1,_1>>, 8, 8>::Kernel;
+
+  int M = 256, N = 128, K = 128;
+  std::mt19937 rng(2023);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  auto A = make_block<bfloat16_t>(size_t(M) * K, [&] { return dist(rng); });
+  auto B = make_block<bfloat16_t>(size_t(N) * K, [&] { return dist(rng); });
+  std::vector<float> C(size_t(M) * N, 0.0f);
+
+  auto D = run_host_gemm<GemmKernel>(M, N, K, A, B, C, 1.0f, 0.0f);
+
+  for (int n = 0; n < N; ++n) {
+    for (int m = 0; m < M; ++m) {
+      float ref = reference_dot(m, n, K, A, B);
+      ASSERT_EQ(std::memcmp(&D[m + size_t(n) * M], &ref, sizeof(float)), 0)
+        << "at (" << m << "," << n << "): " << D[m + size_t(n) * M] << " != " << ref;
+    }
+  }
+}
+
+TEST(HostGrid, mp22_simt_gemm) {
+  // The 128x32x4 SIMT configuration of the library generator
+  using Permutation = Tile<Layout<Shape<_16,_4>, Stride<_4,_1>>,
+                           Layout<Shape< _8,_4>, Stride<_4,_1>>,
+                           Underscore>;
+  using GemmKernel = Mp22Gemm<mutlass::arch::OpClassSimt, float, Shape<_128,_32,_4>, Layout<Shape<_16,_8,_1>>, 4, 1, Permutation>::Kernel;
+
+  int M = 130, N = 70, K = 20;
+  std::mt19937 rng(2025);
+  auto small = [&] { return int(rng() % 7) - 3; };
+  auto A = make_block<float>(size_t(M) * K, small);
+  auto B = make_block<float>(size_t(N) * K, small);
+  auto C = make_block<float>(size_t(M) * N, small);
+
+  auto D = run_host_gemm<GemmKernel>(M, N, K, A, B, C, 1.0f, 1.0f, {3});
+
+  for (int n = 0; n < N; ++n) {
+    for (int m = 0; m < M; ++m) {
+      float ref = reference_dot(m, n, K, A, B) + C[m + size_t(n) * M];
+      ASSERT_EQ(D[m + size_t(n) * M], ref) << "at (" << m << "," << n << ")";
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,239 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+/*! \file
+    \brief Tests for the register footprint and occupancy estimate of collective mainloops
+*/
+
+#include "mutlass_unit_test.h"
+
+#include "mute/tensor.hpp"
+#include "mute/atom/mma_atom.hpp"
+#include "mute/atom/copy_atom.hpp"
+
+#include "mutlass/gemm/collective/collective_builder.hpp"
+#include "mutlass/epilogue/collective/collective_builder.hpp"
+
+#include "mutlass/util/occupancy_estimate.hpp"
+
+using namespace mute;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+template <class Element, int BlockM, int BlockN, int AtomM, int AtomN>
+using Mp22Mainloop = typename mutlass::gemm::collective::CollectiveBuilder<
+    mutlass::arch::Mp22, mutlass::arch::OpClassTensorOp,
+    Element, mutlass::layout::RowMajor, 128 / sizeof_bits_v<Element>,
+    Element, mutlass::layout::ColumnMajor, 128 / sizeof_bits_v<Element>,
+    float,
+    Shape<Int<BlockM>, Int<BlockN>, Int<512 / sizeof_bits_v<Element>>>, Shape<_1,_1,_1>,
+    Layout<Shape<Int<AtomM>, Int<AtomN>, _1>>,
+    mutlass::gemm::collective::PermuteLayoutAuto,
+    mutlass::gemm::collective::StageCountAuto,
+    mutlass::gemm::collective::KernelScheduleAuto
+  >::CollectiveOp;
+
+// An epilogue staging its output through more shared memory than the mainloop uses
+struct SmemEpilogue {
+  struct SharedStorage {
+    char smem[48 * 1024];
+  };
+};
+
+// An epilogue reading a bias vector it loads before the mainloop
+struct ResidentEpilogue {
+  struct SharedStorage {
+    float bias[128];
+  };
+
+  static constexpr bool SharedStorageLiveInMainloop = true;
+};
+
+// The collectives the library generator emits for an MP22 GEMM of a tile shape
+template <class OpClass, class Element, class ElementAccumulator,
+          int BlockM, int BlockN, int BlockK, int AtomM, int AtomN, int Alignment>
+struct GeneratedMp22Gemm {
+  using TileShape = Shape<Int<BlockM>, Int<BlockN>, Int<BlockK>>;
+
+  using Epilogue = typename mutlass::epilogue::collective::CollectiveBuilder<
+      mutlass::arch::Mp22, OpClass,
+      TileShape, Shape<_1,_1,_1>,
+      mutlass::epilogue::collective::EpilogueTileAuto,
+      ElementAccumulator, ElementAccumulator,
+      ElementAccumulator, mutlass::layout::ColumnMajor, 1,
+      ElementAccumulator, mutlass::layout::ColumnMajor, 1,
+      mutlass::epilogue::collective::EpilogueScheduleAuto
+    >::CollectiveOp;
+
+  using Mainloop = typename mutlass::gemm::collective::CollectiveBuilder<
+      mutlass::arch::Mp22, OpClass,
+      Element, mutlass::layout::RowMajor, Alignment,
+      Element, mutlass::layout::ColumnMajor, Alignment,
+      ElementAccumulator,
+      TileShape, Shape<_1,_1,_1>,
+      Layout<Shape<Int<AtomM>, Int<AtomN>, _1>>,
+      mutlass::gemm::collective::PermuteLayoutAuto,
+      mutlass::gemm::collective::StageCount<2>,
+      mutlass::gemm::KernelMultistage
+    >::CollectiveOp;
+};
+
+// Checks the estimate of a generated GEMM against the values the generator's EstimateOccupancy()
+// returns for the same operation, pinned in test/python/mutlass_library/test_occupancy_estimate.py
+template <class Gemm>
+void expect_generated_estimate(int registers, int registers_per_thread, int threads_per_cta,
+                               int smem_per_cta, int ctas_per_core) {
+  auto estimate = mutlass::analysis::estimate_occupancy<typename Gemm::Mainloop, typename Gemm::Epilogue>();
+
+  MUTLASS_TRACE_HOST(estimate);
+
+  EXPECT_EQ(estimate.registers.total(), registers);
+  EXPECT_EQ(estimate.registers_per_thread, registers_per_thread);
+  EXPECT_EQ(estimate.threads_per_cta, threads_per_cta);
+  EXPECT_EQ(estimate.smem_per_cta, smem_per_cta);
+  EXPECT_EQ(estimate.ctas_per_core, ctas_per_core);
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(OccupancyEstimate, mp22_register_footprint) {
+  using Mainloop = Mp22Mainloop<half_t, 128, 128, 1, 1>;
+
+  // The estimate is a constant expression of the collective types
+  constexpr auto registers = mutlass::analysis::estimate_mainloop_registers<Mainloop>();
+  static_assert(registers.total() > registers.accumulators);
+
+  MUTLASS_TRACE_HOST(registers);
+
+  // One warp holds the 128x128 f32 accumulators, and the 128x32 f16 tiles of A and B both as MMA
+  // fragments and as copy buffers
+  EXPECT_EQ(registers.accumulators, 128 * 128 / 128);
+  EXPECT_EQ(registers.fragment_a, 128 * 32 / 128 / 2);
+  EXPECT_EQ(registers.fragment_b, 128 * 32 / 128 / 2);
+  EXPECT_EQ(registers.copy_buffer_a, 128 * 32 / 128 / 2);
+  EXPECT_EQ(registers.copy_buffer_b, 128 * 32 / 128 / 2);
+  EXPECT_EQ(registers.reserved, mutlass::analysis::OccupancyModel{}.reserved_registers);
+  EXPECT_EQ(registers.total(), 208);
+
+  // Register counts round up to whole 32-bit words, independently of the element width
+  auto registers_s8 = mutlass::analysis::estimate_mainloop_registers<Mp22Mainloop<int8_t, 128, 128, 1, 1>>();
+  EXPECT_EQ(registers_s8.fragment_a, 128 * 64 / 128 / 4);
+  EXPECT_EQ(registers_s8.accumulators, registers.accumulators);
+}
+
+TEST(OccupancyEstimate, mp22_occupancy_limiter) {
+  constexpr auto estimate = mutlass::analysis::estimate_occupancy<Mp22Mainloop<half_t, 128, 128, 1, 1>>();
+
+  MUTLASS_TRACE_HOST(estimate);
+
+  EXPECT_FALSE(estimate.spills());
+  EXPECT_EQ(estimate.threads_per_cta, 128);
+  EXPECT_EQ(estimate.registers_per_thread, 208);
+  EXPECT_EQ(estimate.smem_per_cta, 2 * 128 * 32 * 2);
+  EXPECT_EQ(estimate.ctas_by_registers, 4);
+  EXPECT_EQ(estimate.ctas_per_core, 4);
+  EXPECT_STREQ(estimate.limiter(), "registers");
+  EXPECT_DOUBLE_EQ(estimate.occupancy(), 4.0 * 128 / 2048);
+
+  // Four warps of 192 registers each fit a single CTA into the register file
+  auto large = mutlass::analysis::estimate_occupancy<Mp22Mainloop<half_t, 256, 256, 2, 2>>();
+  EXPECT_EQ(large.threads_per_cta, 512);
+  EXPECT_EQ(large.registers.total(), 192);
+  EXPECT_EQ(large.ctas_per_core, 1);
+
+  // With registers to spare, shared memory bounds the same kernel
+  mutlass::analysis::OccupancyModel model;
+  model.registers_per_core = 1 << 20;
+  large = mutlass::analysis::estimate_occupancy<Mp22Mainloop<half_t, 256, 256, 2, 2>>(model);
+  EXPECT_EQ(large.ctas_per_core, model.smem_per_core / (2 * 256 * 32 * 2));
+  EXPECT_STREQ(large.limiter(), "smem");
+}
+
+TEST(OccupancyEstimate, spills_beyond_addressable_registers) {
+  mutlass::analysis::OccupancyModel model;
+  model.max_registers_per_thread = 128;
+
+  auto estimate = mutlass::analysis::estimate_occupancy<Mp22Mainloop<half_t, 128, 128, 1, 1>>(model);
+
+  EXPECT_TRUE(estimate.spills());
+  EXPECT_EQ(estimate.registers_per_thread, 128);
+  EXPECT_EQ(estimate.ctas_by_registers, model.registers_per_core / (128 * 128));
+}
+
+TEST(OccupancyEstimate, epilogue_overlays_shared_storage) {
+  using Mainloop = Mp22Mainloop<half_t, 128, 64, 1, 1>;
+
+  auto mainloop_only = mutlass::analysis::estimate_occupancy<Mainloop>();
+  auto with_epilogue = mutlass::analysis::estimate_occupancy<Mainloop, SmemEpilogue>();
+
+  EXPECT_EQ(mainloop_only.smem_per_cta, int(sizeof(typename Mainloop::SharedStorage)));
+  EXPECT_EQ(with_epilogue.smem_per_cta, int(sizeof(SmemEpilogue::SharedStorage)));
+  EXPECT_EQ(with_epilogue.ctas_per_core, 1);
+  EXPECT_STREQ(with_epilogue.limiter(), "smem");
+  EXPECT_EQ(with_epilogue.registers.total(), mainloop_only.registers.total());
+
+  // Storage the epilogue keeps live through the mainloop is laid out after the mainloop's
+  auto with_resident = mutlass::analysis::estimate_occupancy<Mainloop, ResidentEpilogue>();
+  EXPECT_EQ(with_resident.smem_per_cta,
+            int(sizeof(typename Mainloop::SharedStorage) + sizeof(ResidentEpilogue::SharedStorage)));
+}
+
+TEST(OccupancyEstimate, matches_generator_tensorop) {
+  using mutlass::arch::OpClassTensorOp;
+
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassTensorOp, half_t, float, 128, 128, 32, 1, 1, 8>>(208, 208, 128, 16384, 4);
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassTensorOp, half_t, float, 128,  64, 32, 1, 1, 8>>(128, 128, 128, 12288, 6);
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassTensorOp, half_t, float, 128,  32, 32, 1, 1, 8>>( 88,  88, 128, 10240, 7);
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassTensorOp, half_t, float, 256, 128, 32, 2, 1, 8>>(200, 200, 256, 24576, 2);
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassTensorOp, half_t, float, 256, 256, 32, 2, 2, 8>>(192, 192, 512, 32768, 1);
+
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassTensorOp, int8_t, int32_t, 128, 128, 64, 1, 1, 16>>(208, 208, 128, 16384, 4);
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassTensorOp, tfloat32_t, float, 128, 128, 16, 1, 1, 4>>(208, 208, 128, 16384, 4);
+}
+
+TEST(OccupancyEstimate, matches_generator_simt) {
+  using mutlass::arch::OpClassSimt;
+
+  // The SIMT builder strides the smem tile of B by BlockM, so B spans BlockN + (BlockK-1) * BlockM elements
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassSimt, float, float, 128, 128, 4, 16, 16, 1>>(148, 152, 256, 4096, 3);
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassSimt, float, float, 128, 128, 8, 16, 32, 1>>(148, 152, 512, 8192, 1);
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassSimt, float, float, 128,  64, 4, 16,  8, 1>>(150, 152, 128, 3840, 6);
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassSimt, float, float, 128,  64, 8, 16, 16, 1>>(150, 152, 256, 7936, 3);
+  expect_generated_estimate<GeneratedMp22Gemm<OpClassSimt, float, float, 128,  32, 4, 16,  8, 1>>(101, 104, 128, 3712, 9);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
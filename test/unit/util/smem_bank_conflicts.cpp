@@ -0,0 +1,218 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Tests for the shared memory bank conflict analysis
+*/
+
+#include "mutlass_unit_test.h"
+
+#include "mute/tensor.hpp"
+#include "mute/atom/mma_atom.hpp"
+#include "mute/atom/copy_atom.hpp"
+
+#include "mutlass/gemm/collective/collective_builder.hpp"
+
+#include "mutlass/util/smem_bank_conflicts.hpp"
+
+using namespace mute;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// 128 threads each copying one float of a 128x8 tile, thread i owning row i
+using RowPerThreadCopy = decltype(make_tiled_copy(
+  Copy_Atom<UniversalCopy<uint32_t>, float>{},
+  Layout<Shape<_128, _1>>{},
+  Layout<Shape<_1, _1>>{}));
+
+// 128 threads each copying four contiguous floats of a 128x32 tile
+using VectorCopy = decltype(make_tiled_copy(
+  Copy_Atom<UniversalCopy<uint128_t>, float>{},
+  Layout<Shape<_16, _8>, Stride<_8, _1>>{},
+  Layout<Shape<_1, _4>>{}));
+
+template <class Element, class LayoutA, class LayoutB, class TileShape, class AtomLayout>
+using Mp22Mainloop = typename mutlass::gemm::collective::CollectiveBuilder<
+    mutlass::arch::Mp22, mutlass::arch::OpClassTensorOp,
+    Element, LayoutA, 128 / sizeof_bits_v<Element>,
+    Element, LayoutB, 128 / sizeof_bits_v<Element>,
+    float,
+    TileShape, Shape<_1,_1,_1>, AtomLayout,
+    mutlass::gemm::collective::PermuteLayoutAuto,
+    mutlass::gemm::collective::StageCountAuto,
+    mutlass::gemm::collective::KernelScheduleAuto
+  >::CollectiveOp;
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(SmemBankConflicts, contiguous_column_is_conflict_free) {
+  auto report = mutlass::analysis::analyze_smem_store(
+    RowPerThreadCopy{}, make_layout(Shape<_128, _8>{}));
+
+  MUTLASS_TRACE_HOST(report);
+
+  // 8 columns, each one instruction served in 4 phases of 32 lanes
+  EXPECT_EQ(report.threads, 128);
+  EXPECT_EQ(report.instructions, 8);
+  EXPECT_EQ(report.ideal_wavefronts, 32);
+  EXPECT_TRUE(report.conflict_free());
+  EXPECT_EQ(report.vector_bits, 32);
+}
+
+TEST(SmemBankConflicts, strided_column_conflicts) {
+  // Rows are 32 words apart, so every lane of a phase hits the same bank
+  auto report = mutlass::analysis::analyze_smem_store(
+    RowPerThreadCopy{}, make_layout(Shape<_128, _32>{}, LayoutRight{}));
+
+  MUTLASS_TRACE_HOST(report);
+
+  EXPECT_EQ(report.max_ways, 32);
+  EXPECT_EQ(report.wavefronts, 32 * report.ideal_wavefronts);
+  EXPECT_DOUBLE_EQ(report.efficiency(), 1.0 / 32);
+}
+
+TEST(SmemBankConflicts, swizzle_removes_conflicts) {
+  auto layout = composition(Swizzle<5,0,5>{}, make_layout(Shape<_128, _32>{}, LayoutRight{}));
+  auto report = mutlass::analysis::analyze_smem_store(RowPerThreadCopy{}, layout);
+
+  MUTLASS_TRACE_HOST(report);
+
+  EXPECT_TRUE(report.conflict_free());
+}
+
+TEST(SmemBankConflicts, broadcast_is_conflict_free) {
+  // Every thread loads the same column
+  auto report = mutlass::analysis::analyze_smem_load(
+    RowPerThreadCopy{}, make_layout(Shape<_128, _8>{}, Stride<_0, _1>{}));
+
+  EXPECT_EQ(report.wavefronts, report.ideal_wavefronts);
+  EXPECT_EQ(report.max_ways, 1);
+}
+
+TEST(SmemBankConflicts, vector_width) {
+  auto row_major = make_layout(Shape<_16, _32>{}, LayoutRight{});
+  auto report = mutlass::analysis::analyze_smem_store(VectorCopy{}, row_major);
+
+  MUTLASS_TRACE_HOST(report);
+
+  // 128-bit accesses fill the banks with 8 lanes
+  EXPECT_EQ(report.vector_bits, 128);
+  EXPECT_EQ(report.instructions, 1);
+  EXPECT_EQ(report.ideal_wavefronts, 16);
+  EXPECT_TRUE(report.conflict_free());
+
+  // Column-major smem breaks the four values of a thread into scalar accesses
+  auto col_major = make_layout(Shape<_16, _32>{});
+  report = mutlass::analysis::analyze_smem_store(VectorCopy{}, col_major);
+
+  MUTLASS_TRACE_HOST(report);
+
+  EXPECT_EQ(report.vector_bits, 32);
+  EXPECT_EQ(report.instructions, 4);
+  EXPECT_EQ(report.bytes, 16 * 32 * 4);
+}
+
+TEST(SmemBankConflicts, custom_bank_model) {
+  mutlass::analysis::SmemBankModel model;
+  model.num_banks = 16;
+  model.warp_size = 32;
+
+  auto report = mutlass::analysis::analyze_smem_store(
+    RowPerThreadCopy{}, make_layout(Shape<_128, _8>{}), model);
+
+  // 4 warps, 8 columns, 2 phases of 16 lanes each
+  EXPECT_EQ(report.instructions, 32);
+  EXPECT_EQ(report.ideal_wavefronts, 64);
+  EXPECT_TRUE(report.conflict_free());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The MMA operand loads of every MP22 tensor op mainloop must stay conflict free, and the
+// stores of the gmem tiles must not get worse than what the builder produces today.
+template <class Mainloop>
+void verify_mp22_mainloop(double min_store_efficiency) {
+  auto report = mutlass::analysis::analyze_mainloop_smem<Mainloop>();
+
+  MUTLASS_TRACE_HOST("store A " << report.store_a);
+  MUTLASS_TRACE_HOST("load  A " << report.load_a);
+  MUTLASS_TRACE_HOST("store B " << report.store_b);
+  MUTLASS_TRACE_HOST("load  B " << report.load_b);
+
+  EXPECT_TRUE(report.load_a.conflict_free());
+  EXPECT_TRUE(report.load_b.conflict_free());
+  EXPECT_GE(report.store_a.efficiency(), min_store_efficiency);
+  EXPECT_GE(report.store_b.efficiency(), min_store_efficiency);
+}
+
+TEST(SmemBankConflicts, mp22_builder_f16) {
+  using R = mutlass::layout::RowMajor;
+  using C = mutlass::layout::ColumnMajor;
+  using Tile = Shape<_128, _128, _32>;
+  using Atoms = Layout<Shape<_2, _2, _1>>;
+  verify_mp22_mainloop<Mp22Mainloop<mutlass::half_t, R, C, Tile, Atoms>>(0.25);
+  verify_mp22_mainloop<Mp22Mainloop<mutlass::half_t, C, R, Tile, Atoms>>(0.25);
+  verify_mp22_mainloop<Mp22Mainloop<mutlass::half_t, R, R, Tile, Atoms>>(0.25);
+  verify_mp22_mainloop<Mp22Mainloop<mutlass::half_t, C, C, Tile, Atoms>>(0.25);
+}
+
+TEST(SmemBankConflicts, mp22_builder_bf16) {
+  using R = mutlass::layout::RowMajor;
+  using C = mutlass::layout::ColumnMajor;
+  verify_mp22_mainloop<Mp22Mainloop<mutlass::bfloat16_t, R, C, Shape<_128, _128, _32>, Layout<Shape<_2, _2, _1>>>>(0.25);
+  verify_mp22_mainloop<Mp22Mainloop<mutlass::bfloat16_t, C, R, Shape<_128, _64, _32>, Layout<Shape<_2, _1, _1>>>>(0.25);
+}
+
+TEST(SmemBankConflicts, mp22_builder_tf32) {
+  using R = mutlass::layout::RowMajor;
+  using C = mutlass::layout::ColumnMajor;
+  using Tile = Shape<_128, _128, _16>;
+  using Atoms = Layout<Shape<_2, _2, _1>>;
+  verify_mp22_mainloop<Mp22Mainloop<float, R, C, Tile, Atoms>>(0.25);
+  verify_mp22_mainloop<Mp22Mainloop<float, C, R, Tile, Atoms>>(0.25);
+}
+
+TEST(SmemBankConflicts, mp22_builder_s8) {
+  using R = mutlass::layout::RowMajor;
+  using C = mutlass::layout::ColumnMajor;
+  using Tile = Shape<_128, _128, _64>;
+  using Atoms = Layout<Shape<_2, _2, _1>>;
+  verify_mp22_mainloop<Mp22Mainloop<int8_t, R, C, Tile, Atoms>>(0.25);
+  // MN-major int8 tiles are stored with 8-way conflicts
+  verify_mp22_mainloop<Mp22Mainloop<int8_t, C, R, Tile, Atoms>>(0.125);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,174 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Tests for the shared memory swizzle search
+*/
+
+#include "mutlass_unit_test.h"
+
+#include "mute/tensor.hpp"
+#include "mute/atom/mma_atom.hpp"
+#include "mute/atom/copy_atom.hpp"
+
+#include "mutlass/gemm/collective/collective_builder.hpp"
+
+#include "mutlass/util/smem_bank_conflicts.hpp"
+#include "mutlass/util/smem_swizzle_search.hpp"
+
+using namespace mute;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// 128 threads each storing eight contiguous halves of a row-major 32x64 tile
+using RowStore = decltype(make_tiled_copy(
+  Copy_Atom<UniversalCopy<uint128_t>, half_t>{},
+  Layout<Shape<_16, _8>, Stride<_8, _1>>{},
+  Layout<Shape<_1, _8>>{}));
+
+// 128 threads loading eight contiguous halves each, consecutive threads walking down the rows
+using ColumnLoad = decltype(make_tiled_copy(
+  Copy_Atom<UniversalCopy<uint128_t>, half_t>{},
+  Layout<Shape<_32, _4>>{},
+  Layout<Shape<_1, _8>>{}));
+
+template <class Element, class LayoutA, class LayoutB,
+          class SmemSwizzleType = mutlass::gemm::collective::SmemSwizzleAuto>
+using Mp22Mainloop = typename mutlass::gemm::collective::CollectiveBuilder<
+    mutlass::arch::Mp22, mutlass::arch::OpClassTensorOp,
+    Element, LayoutA, 128 / sizeof_bits_v<Element>,
+    Element, LayoutB, 128 / sizeof_bits_v<Element>,
+    float,
+    Shape<_128, _128, Int<512 / sizeof_bits_v<Element>>>, Shape<_1,_1,_1>, Layout<Shape<_2, _2, _1>>,
+    mutlass::gemm::collective::PermuteLayoutAuto,
+    mutlass::gemm::collective::StageCountAuto,
+    mutlass::gemm::collective::KernelScheduleAuto,
+    SmemSwizzleType
+  >::CollectiveOp;
+
+template <class Swizzle>
+void expect_matches_mute(mutlass::analysis::SwizzleParams const &params) {
+  for (int offset = 0; offset < (1 << 14); ++offset) {
+    ASSERT_EQ(params(offset), int64_t(Swizzle{}(offset)));
+  }
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(SmemSwizzleSearch, params_match_mute_swizzle) {
+  expect_matches_mute<Swizzle<3,3,3>>({3, 3, 3});
+  expect_matches_mute<Swizzle<2,4,4>>({2, 4, 4});
+  expect_matches_mute<Swizzle<1,5,2>>({1, 5, 2});
+  expect_matches_mute<Swizzle<0,4,3>>({});
+}
+
+TEST(SmemSwizzleSearch, finds_xor_of_row_into_column) {
+  auto smem_layout = make_layout(Shape<_32, _64>{}, LayoutRight{});
+  auto result = mutlass::analysis::search_smem_swizzle(RowStore{}, ColumnLoad{}, smem_layout);
+
+  MUTLASS_TRACE_HOST("unswizzled: " << result.unswizzled.load);
+  MUTLASS_TRACE_HOST("best " << result.best().swizzle << ": " << result.best().load);
+
+  // Rows are 128 bytes apart, so the column loads of a phase all hit the same banks
+  EXPECT_TRUE(result.unswizzled.store.conflict_free());
+  EXPECT_EQ(result.unswizzled.load.max_ways, 8);
+
+  EXPECT_EQ(result.best().swizzle, (mutlass::analysis::SwizzleParams{3, 3, 3}));
+  EXPECT_EQ(result.best().bank_conflicts(), 0);
+
+  // The search evaluates swizzles exactly as composing them with the tile does
+  auto swizzled = composition(Swizzle<3,3,3>{}, smem_layout);
+  EXPECT_EQ(result.best().store.wavefronts, mutlass::analysis::analyze_smem_store(RowStore{}, swizzled).wavefronts);
+  EXPECT_EQ(result.best().load.wavefronts, mutlass::analysis::analyze_smem_load(ColumnLoad{}, swizzled).wavefronts);
+}
+
+TEST(SmemSwizzleSearch, keeps_vector_width) {
+  auto smem_layout = make_layout(Shape<_32, _64>{}, LayoutRight{});
+  auto result = mutlass::analysis::search_smem_swizzle(RowStore{}, ColumnLoad{}, smem_layout);
+
+  ASSERT_GT(result.ranked.size(), 1u);
+  for (auto const &candidate : result.ranked) {
+    EXPECT_EQ(candidate.store.vector_bits, 128);
+    EXPECT_EQ(candidate.load.vector_bits, 128);
+    EXPECT_GE(candidate.swizzle.bits ? candidate.swizzle.base : 3, 3);
+    EXPECT_LE(candidate.swizzle.footprint_bits(), 11);
+  }
+}
+
+TEST(SmemSwizzleSearch, mp22_builder_consumes_swizzle) {
+  using R = mutlass::layout::RowMajor;
+  using C = mutlass::layout::ColumnMajor;
+
+  // MN-major f16 stores conflict 4-way without a swizzle
+  auto search = mutlass::analysis::search_mainloop_swizzle<Mp22Mainloop<half_t, C, R>>();
+
+  MUTLASS_TRACE_HOST("A: " << search.a.best().swizzle << " " << search.a.best().store);
+  MUTLASS_TRACE_HOST("B: " << search.b.best().swizzle << " " << search.b.best().store);
+
+  EXPECT_EQ(search.a.unswizzled.store.wavefronts, 4 * search.a.unswizzled.store.ideal_wavefronts);
+  EXPECT_EQ(search.a.best().swizzle, (mutlass::analysis::SwizzleParams{2, 4, 4}));
+  EXPECT_EQ(search.a.best().bank_conflicts(), 0);
+  EXPECT_EQ(search.b.best().swizzle, (mutlass::analysis::SwizzleParams{2, 4, 4}));
+
+  EXPECT_EQ(mutlass::analysis::smem_swizzle_type(search.a.best().swizzle, search.b.best().swizzle),
+            "mutlass::gemm::collective::SmemSwizzle<mute::Swizzle<2,4,4>, mute::Swizzle<2,4,4>>");
+
+  // The builder composes the swizzles with its atoms, giving the traffic the search predicted
+  using Swizzled = Mp22Mainloop<half_t, C, R,
+    mutlass::gemm::collective::SmemSwizzle<Swizzle<2,4,4>, Swizzle<2,4,4>>>;
+  auto report = mutlass::analysis::analyze_mainloop_smem<Swizzled>();
+
+  EXPECT_TRUE(report.conflict_free());
+  EXPECT_EQ(report.store_a.wavefronts, search.a.best().store.wavefronts);
+  EXPECT_EQ(report.load_a.wavefronts, search.a.best().load.wavefronts);
+  EXPECT_EQ(report.store_b.wavefronts, search.b.best().store.wavefronts);
+  EXPECT_EQ(report.load_b.wavefronts, search.b.best().load.wavefronts);
+}
+
+TEST(SmemSwizzleSearch, mp22_k_major_atom_limits_search) {
+  using R = mutlass::layout::RowMajor;
+  using C = mutlass::layout::ColumnMajor;
+
+  // The K-major atom interleaves rows between the two halves of a 32 byte K chunk, so no single
+  // swizzle of at most 3 bits separates all lanes of a store phase; the best one halves the conflicts.
+  auto search = mutlass::analysis::search_mainloop_swizzle<Mp22Mainloop<half_t, R, C>>();
+
+  EXPECT_EQ(search.a.unswizzled.store.wavefronts, 4 * search.a.unswizzled.store.ideal_wavefronts);
+  EXPECT_EQ(search.a.best().store.wavefronts, 2 * search.a.best().store.ideal_wavefronts);
+  EXPECT_TRUE(search.a.best().load.conflict_free());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
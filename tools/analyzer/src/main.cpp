@@ -0,0 +1,353 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Reports shared memory bank conflicts, global memory coalescing and estimated occupancy
+           of the MP22 CollectiveBuilder configurations, and searches their shared memory swizzles.
+*/
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "mute/tensor.hpp"
+#include "mute/atom/mma_atom.hpp"
+#include "mute/atom/copy_atom.hpp"
+
+#include "mutlass/mutlass.h"
+#include "mutlass/gemm/collective/collective_builder.hpp"
+
+#include "mutlass/util/command_line.h"
+#include "mutlass/util/packed_stride.hpp"
+#include "mutlass/util/gmem_coalescing.hpp"
+#include "mutlass/util/occupancy_estimate.hpp"
+#include "mutlass/util/smem_bank_conflicts.hpp"
+#include "mutlass/util/smem_swizzle_search.hpp"
+
+using namespace mute;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Options {
+
+  bool help = false;
+  std::string analysis = "smem";
+  std::string element = "all";
+  std::string layout = "all";
+  std::string tile = "all";
+  bool conflicts_only = false;
+  int m = 4096;
+  int n = 4096;
+  int k = 4096;
+  int max_swizzle_bits = 3;
+  mutlass::analysis::SmemBankModel model;
+  mutlass::analysis::GmemTransactionModel gmem_model;
+  mutlass::analysis::OccupancyModel occupancy_model;
+
+  void parse(int argc, char const **argv) {
+    mutlass::CommandLine cmd(argc, argv);
+
+    help = cmd.check_cmd_line_flag("help");
+    cmd.get_cmd_line_argument("analysis", analysis, std::string("smem"));
+    cmd.get_cmd_line_argument("element", element, std::string("all"));
+    cmd.get_cmd_line_argument("layout", layout, std::string("all"));
+    cmd.get_cmd_line_argument("tile", tile, std::string("all"));
+    cmd.get_cmd_line_argument("conflicts-only", conflicts_only, false);
+    cmd.get_cmd_line_argument("banks", model.num_banks, model.num_banks);
+    cmd.get_cmd_line_argument("bank-bytes", model.bank_bytes, model.bank_bytes);
+    cmd.get_cmd_line_argument("warp-size", model.warp_size, model.warp_size);
+    cmd.get_cmd_line_argument("max-vector-bytes", model.max_vector_bytes, model.max_vector_bytes);
+    cmd.get_cmd_line_argument("m", m, m);
+    cmd.get_cmd_line_argument("n", n, n);
+    cmd.get_cmd_line_argument("k", k, k);
+    cmd.get_cmd_line_argument("transaction-bytes", gmem_model.transaction_bytes, gmem_model.transaction_bytes);
+    cmd.get_cmd_line_argument("max-swizzle-bits", max_swizzle_bits, max_swizzle_bits);
+    cmd.get_cmd_line_argument("registers-per-core", occupancy_model.registers_per_core, occupancy_model.registers_per_core);
+    cmd.get_cmd_line_argument("max-registers-per-thread", occupancy_model.max_registers_per_thread, occupancy_model.max_registers_per_thread);
+    cmd.get_cmd_line_argument("smem-per-core", occupancy_model.smem_per_core, occupancy_model.smem_per_core);
+    cmd.get_cmd_line_argument("max-threads-per-core", occupancy_model.max_threads_per_core, occupancy_model.max_threads_per_core);
+    gmem_model.warp_size = model.warp_size;
+    gmem_model.max_vector_bytes = model.max_vector_bytes;
+  }
+
+  std::ostream &print_usage(std::ostream &out) const {
+    out << "mutlass_analyzer\n\n"
+      << "  Replays the memory accesses of the MP22 tensor op CollectiveBuilder mainloops on the\n"
+      << "  host. Reports bank conflicts of the shared memory accesses, the transactions the\n"
+      << "  global memory tile loads need for packed operands, the swizzles that minimize the\n"
+      << "  wavefronts of the shared memory stores and loads together, or the registers per thread\n"
+      << "  and CTAs per core estimated from the collective types.\n\n"
+      << "Options:\n\n"
+      << "  --help                      Displays this usage statement\n\n"
+      << "  --analysis=<str>            smem, gmem, swizzle or occupancy (default: smem)\n"
+      << "  --element=<str>             f16, bf16, tf32, s8 or all\n"
+      << "  --layout=<str>              Majorness of A and B: nn, nt, tn, tt or all\n"
+      << "  --tile=<str>                Threadblock tile MxN: 128x128, 128x64, 64x128 or all\n"
+      << "  --conflicts-only=<bool>     Only list configurations with conflicts, uncoalesced loads, or\n"
+      << "                              that spill or fit a single CTA per core\n\n"
+      << "  --banks=<int>               Number of shared memory banks (default: " << model.num_banks << ")\n"
+      << "  --bank-bytes=<int>          Width of a bank in bytes (default: " << model.bank_bytes << ")\n"
+      << "  --warp-size=<int>           Threads issuing one instruction (default: " << model.warp_size << ")\n"
+      << "  --max-vector-bytes=<int>    Widest access of a thread (default: " << model.max_vector_bytes << ")\n\n"
+      << "  --m=<int> --n=<int> --k=<int>\n"
+      << "                              Problem size giving the packed gmem strides (default: 4096)\n"
+      << "  --transaction-bytes=<int>   Bytes fetched per gmem transaction (default: " << gmem_model.transaction_bytes << ")\n\n"
+      << "  --max-swizzle-bits=<int>    Widest swizzle mask searched (default: " << max_swizzle_bits << ")\n\n"
+      << "  --registers-per-core=<int>  32-bit registers of one core (default: " << occupancy_model.registers_per_core << ")\n"
+      << "  --max-registers-per-thread=<int>\n"
+      << "                              Registers a thread may use before spilling (default: " << occupancy_model.max_registers_per_thread << ")\n"
+      << "  --smem-per-core=<int>       Shared memory bytes of one core (default: " << occupancy_model.smem_per_core << ")\n"
+      << "  --max-threads-per-core=<int>\n"
+      << "                              Resident threads of one core (default: " << occupancy_model.max_threads_per_core << ")\n\n"
+      << "Examples:\n\n"
+      << "  $ mutlass_analyzer --element=f16 --layout=tn --banks=64\n\n"
+      << "  $ mutlass_analyzer --analysis=gmem --element=bf16 --k=4100\n\n"
+      << "  $ mutlass_analyzer --analysis=swizzle --element=f16 --layout=nt\n\n"
+      << "  $ mutlass_analyzer --analysis=occupancy --element=s8 --registers-per-core=65536\n\n";
+    return out;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class Element, class LayoutA, class LayoutB, int BlockM, int BlockN, int AtomM, int AtomN>
+void analyze(
+  Options const &options,
+  char const *element_name,
+  char const *layout_name) {
+
+  constexpr int BlockK = 512 / sizeof_bits_v<Element>;
+
+  std::string tile = std::to_string(BlockM) + "x" + std::to_string(BlockN);
+  if ((options.element != "all" && options.element != element_name) ||
+      (options.layout != "all" && options.layout != layout_name) ||
+      (options.tile != "all" && options.tile != tile)) {
+    return;
+  }
+
+  using Mainloop = typename mutlass::gemm::collective::CollectiveBuilder<
+      mutlass::arch::Mp22, mutlass::arch::OpClassTensorOp,
+      Element, LayoutA, 128 / sizeof_bits_v<Element>,
+      Element, LayoutB, 128 / sizeof_bits_v<Element>,
+      float,
+      Shape<Int<BlockM>, Int<BlockN>, Int<BlockK>>,
+      Shape<_1,_1,_1>,
+      Layout<Shape<Int<AtomM>, Int<AtomN>, _1>>,
+      mutlass::gemm::collective::PermuteLayoutAuto,
+      mutlass::gemm::collective::StageCountAuto,
+      mutlass::gemm::collective::KernelScheduleAuto
+    >::CollectiveOp;
+
+  std::string name = std::string("mp22_tensorop_") + element_name + "_" + tile + "x" +
+                     std::to_string(BlockK) + "_" + layout_name;
+
+  if (options.analysis == "gmem") {
+    auto dA = mutlass::make_mute_packed_stride(typename Mainloop::StrideA{}, make_shape(options.m, options.k, 1));
+    auto dB = mutlass::make_mute_packed_stride(typename Mainloop::StrideB{}, make_shape(options.n, options.k, 1));
+    auto report = mutlass::analysis::analyze_mainloop_gmem<Mainloop>(dA, dB, options.gmem_model);
+
+    if (options.conflicts_only && report.coalesced()) {
+      return;
+    }
+
+    auto print = [&](char const *access, mutlass::analysis::GmemAccessReport const &r) {
+      std::cout << std::left << std::setw(36) << name << std::setw(9) << access << std::right
+                << std::setw(13) << r.instructions
+                << std::setw(14) << r.transactions
+                << std::setw(8) << r.ideal_transactions
+                << std::setw(8) << r.vector_bits
+                << std::setw(12) << std::fixed << std::setprecision(3) << r.efficiency() << "\n";
+    };
+
+    print("load_a", report.load_a);
+    print("load_b", report.load_b);
+    return;
+  }
+
+  if (options.analysis == "occupancy") {
+    auto estimate = mutlass::analysis::estimate_occupancy<Mainloop>(options.occupancy_model);
+
+    if (options.conflicts_only && !estimate.spills() && estimate.ctas_per_core > 1) {
+      return;
+    }
+
+    std::cout << std::left << std::setw(36) << name << std::right
+              << std::setw(6) << estimate.registers.accumulators
+              << std::setw(8) << (estimate.registers.fragment_a + estimate.registers.fragment_b)
+              << std::setw(8) << (estimate.registers.copy_buffer_a + estimate.registers.copy_buffer_b)
+              << std::setw(8) << estimate.registers.total()
+              << std::setw(8) << (estimate.spills() ? "yes" : "no")
+              << std::setw(9) << estimate.threads_per_cta
+              << std::setw(8) << estimate.smem_per_cta
+              << std::setw(6) << estimate.ctas_per_core
+              << std::setw(11) << estimate.limiter()
+              << std::setw(11) << std::fixed << std::setprecision(3) << estimate.occupancy() << "\n";
+    return;
+  }
+
+  if (options.analysis == "swizzle") {
+    auto search = mutlass::analysis::search_mainloop_swizzle<Mainloop>(options.model, options.max_swizzle_bits);
+
+    if (options.conflicts_only &&
+        search.a.unswizzled.bank_conflicts() == 0 && search.b.unswizzled.bank_conflicts() == 0) {
+      return;
+    }
+
+    auto print = [&](char const *operand, mutlass::analysis::SwizzleSearchResult const &r) {
+      std::cout << std::left << std::setw(36) << name << std::setw(9) << operand << std::right
+                << std::setw(13) << r.unswizzled.wavefronts()
+                << std::setw(12) << r.best().wavefronts()
+                << std::setw(8) << (r.best().store.ideal_wavefronts + r.best().load.ideal_wavefronts)
+                << "  " << r.best().swizzle << "\n";
+    };
+
+    print("a", search.a);
+    print("b", search.b);
+    std::cout << "  " << mutlass::analysis::smem_swizzle_type(search.a.best().swizzle, search.b.best().swizzle) << "\n";
+    return;
+  }
+
+  auto report = mutlass::analysis::analyze_mainloop_smem<Mainloop>(options.model);
+
+  if (options.conflicts_only && report.conflict_free()) {
+    return;
+  }
+
+  auto print = [&](char const *access, mutlass::analysis::SmemAccessReport const &r) {
+    std::cout << std::left << std::setw(36) << name << std::setw(9) << access << std::right
+              << std::setw(13) << r.instructions
+              << std::setw(12) << r.wavefronts
+              << std::setw(8) << r.ideal_wavefronts
+              << std::setw(10) << r.max_ways
+              << std::setw(8) << r.vector_bits
+              << std::setw(12) << std::fixed << std::setprecision(3) << r.efficiency() << "\n";
+  };
+
+  print("store_a", report.store_a);
+  print("load_a", report.load_a);
+  print("store_b", report.store_b);
+  print("load_b", report.load_b);
+}
+
+template <class Element, class LayoutA, class LayoutB>
+void analyze_tiles(Options const &options, char const *element_name, char const *layout_name) {
+  analyze<Element, LayoutA, LayoutB, 128, 128, 2, 2>(options, element_name, layout_name);
+  analyze<Element, LayoutA, LayoutB, 128,  64, 2, 1>(options, element_name, layout_name);
+  analyze<Element, LayoutA, LayoutB,  64, 128, 1, 2>(options, element_name, layout_name);
+}
+
+template <class Element>
+void analyze_layouts(Options const &options, char const *element_name) {
+  using R = mutlass::layout::RowMajor;
+  using C = mutlass::layout::ColumnMajor;
+  analyze_tiles<Element, C, C>(options, element_name, "nn");
+  analyze_tiles<Element, C, R>(options, element_name, "nt");
+  analyze_tiles<Element, R, C>(options, element_name, "tn");
+  analyze_tiles<Element, R, R>(options, element_name, "tt");
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char const **argv) {
+
+  Options options;
+  options.parse(argc, argv);
+
+  if (options.help) {
+    options.print_usage(std::cout);
+    return 0;
+  }
+
+  if (options.model.num_banks <= 0 || options.model.bank_bytes <= 0 ||
+      options.model.warp_size <= 0 || options.model.max_vector_bytes <= 0 ||
+      options.gmem_model.transaction_bytes <= 0) {
+    std::cerr << "Invalid memory model." << std::endl;
+    return -1;
+  }
+
+  if (options.occupancy_model.registers_per_core <= 0 || options.occupancy_model.max_registers_per_thread <= 0 ||
+      options.occupancy_model.smem_per_core <= 0 || options.occupancy_model.max_threads_per_core <= 0) {
+    std::cerr << "Invalid occupancy model." << std::endl;
+    return -1;
+  }
+
+  if (options.analysis != "smem" && options.analysis != "gmem" && options.analysis != "swizzle" &&
+      options.analysis != "occupancy") {
+    std::cerr << "Unknown analysis '" << options.analysis << "'." << std::endl;
+    return -1;
+  }
+
+  if (options.analysis == "occupancy") {
+    std::cout << std::left << std::setw(36) << "configuration" << std::right
+              << std::setw(6) << "accum"
+              << std::setw(8) << "frags"
+              << std::setw(8) << "copy"
+              << std::setw(8) << "regs"
+              << std::setw(8) << "spills"
+              << std::setw(9) << "threads"
+              << std::setw(8) << "smem"
+              << std::setw(6) << "ctas"
+              << std::setw(11) << "limiter"
+              << std::setw(11) << "occupancy" << "\n";
+  }
+  else if (options.analysis == "swizzle") {
+    std::cout << std::left << std::setw(36) << "configuration" << std::setw(9) << "operand" << std::right
+              << std::setw(13) << "unswizzled"
+              << std::setw(12) << "swizzled"
+              << std::setw(8) << "ideal"
+              << "  swizzle\n";
+  }
+  else {
+    std::cout << std::left << std::setw(36) << "configuration" << std::setw(9) << "access" << std::right
+              << std::setw(13) << "instructions";
+    if (options.analysis == "gmem") {
+      std::cout << std::setw(14) << "transactions"
+                << std::setw(8) << "ideal";
+    }
+    else {
+      std::cout << std::setw(12) << "wavefronts"
+                << std::setw(8) << "ideal"
+                << std::setw(10) << "max_ways";
+    }
+    std::cout << std::setw(8) << "vector"
+              << std::setw(12) << "efficiency" << "\n";
+  }
+
+  analyze_layouts<mutlass::half_t>(options, "f16");
+  analyze_layouts<mutlass::bfloat16_t>(options, "bf16");
+  analyze_layouts<float>(options, "tf32");
+  analyze_layouts<int8_t>(options, "s8");
+
+  return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
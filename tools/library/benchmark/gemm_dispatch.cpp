@@ -0,0 +1,181 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/* \file
+   \brief Measures the host-side latency of submitting many small GEMMs through
+      library::Handle::gemm_universal() one at a time and through Handle::gemm_batch().
+
+   Kernels are launched asynchronously and the device is only synchronized after each timed
+   loop, so the reported times are dominated by host dispatch: key lookup, operation selection,
+   argument lowering and the launch call itself.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "mutlass/library/handle.h"
+#include "mutlass/library/library.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace mutlass::library;
+using mutlass::Status;
+
+using Clock = std::chrono::steady_clock;
+
+/// Returns the elapsed time in microseconds
+static double elapsed_us(Clock::time_point start, Clock::time_point stop) {
+  return std::chrono::duration<double, std::micro>(stop - start).count();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char const **argv) {
+
+  int request_count = (argc > 1 ? std::atoi(argv[1]) : 256);
+  int iterations = (argc > 2 ? std::atoi(argv[2]) : 20);
+
+  // Heterogeneous small problems, as issued per step by a transformer layer
+  int const kShapes[][3] = {
+    {64, 64, 64}, {128, 64, 64}, {64, 128, 128}, {128, 128, 64}
+  };
+  int const kShapeCount = int(sizeof(kShapes) / sizeof(kShapes[0]));
+  int const kMaxExtent = 128;
+
+  size_t matrix_elements = size_t(kMaxExtent) * kMaxExtent;
+
+  float *block = nullptr;
+  if (musaMalloc(reinterpret_cast<void **>(&block), sizeof(float) * matrix_elements * 3 * request_count) != musaSuccess) {
+    std::cerr << "musaMalloc() failed" << std::endl;
+    return -1;
+  }
+
+  float alpha = 1;
+  float beta = 0;
+
+  std::vector<GemmRequest> requests(request_count);
+
+  for (int idx = 0; idx < request_count; ++idx) {
+    int const *shape = kShapes[idx % kShapeCount];
+    float *operands = block + matrix_elements * 3 * idx;
+
+    GemmRequest &request = requests[idx];
+
+    request.M = shape[0];
+    request.N = shape[1];
+    request.K = shape[2];
+    request.element_compute = NumericTypeID::kF32;
+    request.element_scalar = NumericTypeID::kF32;
+    request.alpha = &alpha;
+    request.beta = &beta;
+
+    request.element_A = NumericTypeID::kF32;
+    request.ptr_A = operands;
+    request.lda = kMaxExtent;
+
+    request.element_B = NumericTypeID::kF32;
+    request.ptr_B = operands + matrix_elements;
+    request.ldb = kMaxExtent;
+
+    request.element_C = NumericTypeID::kF32;
+    request.ptr_C = operands + matrix_elements * 2;
+    request.ldc = kMaxExtent;
+
+    request.element_D = NumericTypeID::kF32;
+    request.ptr_D = operands + matrix_elements * 2;
+    request.ldd = kMaxExtent;
+  }
+
+  Handle handle;
+
+  auto submit_each = [&]() {
+    Status status = Status::kSuccess;
+    for (GemmRequest const &r : requests) {
+      Status s = handle.gemm_universal(
+        r.mode, r.M, r.N, r.K, r.element_compute, r.element_scalar, r.alpha,
+        r.element_A, r.layout_A, r.transform_A, r.ptr_A, r.lda,
+        r.element_B, r.layout_B, r.transform_B, r.ptr_B, r.ldb,
+        r.beta,
+        r.element_C, r.layout_C, r.ptr_C, r.ldc,
+        r.element_D, r.layout_D, r.ptr_D, r.ldd);
+      if (s != Status::kSuccess) {
+        status = s;
+      }
+    }
+    return status;
+  };
+
+  auto submit_batch = [&]() {
+    return handle.gemm_batch(requests.data(), request_count);
+  };
+
+  // Warm up, constructing the operations on first lookup
+  if (submit_each() != Status::kSuccess || submit_batch() != Status::kSuccess) {
+    std::cerr << "No operation supports the benchmark problems" << std::endl;
+    (void)musaFree(block);
+    return -1;
+  }
+  (void)musaDeviceSynchronize();
+
+  double each_us = 0;
+  double batch_us = 0;
+
+  for (int iter = 0; iter < iterations; ++iter) {
+    auto start = Clock::now();
+    submit_each();
+    each_us += elapsed_us(start, Clock::now());
+    (void)musaDeviceSynchronize();
+
+    start = Clock::now();
+    submit_batch();
+    batch_us += elapsed_us(start, Clock::now());
+    (void)musaDeviceSynchronize();
+  }
+
+  double each_per_request = each_us / (double(iterations) * request_count);
+  double batch_per_request = batch_us / (double(iterations) * request_count);
+
+  std::cout << std::fixed << std::setprecision(3)
+    << "Requests per submission: " << request_count << ", iterations: " << iterations << "\n"
+    << "gemm_universal():        " << each_per_request << " us per request\n"
+    << "gemm_batch():            " << batch_per_request << " us per request ("
+    << (batch_per_request > 0 ? each_per_request / batch_per_request : 0.0) << "x)\n";
+
+  (void)musaFree(block);
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
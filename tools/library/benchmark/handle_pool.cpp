@@ -0,0 +1,200 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/* \file
+   \brief Measures the host-side throughput of GEMM submission from many threads and devices with
+      a library::Handle constructed per job and with handles acquired from a library::HandlePool.
+
+   Each thread runs a sequence of jobs on its own stream of device (thread % device count), as
+   an inference server does for each request it serves, and each job submits a few small GEMMs.
+   Devices are only synchronized after each timed pass.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "mutlass/library/handle.h"
+#include "mutlass/library/handle_pool.h"
+#include "mutlass/library/library.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace mutlass::library;
+using mutlass::Status;
+
+using Clock = std::chrono::steady_clock;
+
+/// Returns the elapsed time in microseconds
+static double elapsed_us(Clock::time_point start, Clock::time_point stop) {
+  return std::chrono::duration<double, std::micro>(stop - start).count();
+}
+
+/// Operands and stream of a thread
+struct ThreadState {
+  int device_idx = 0;
+  musaStream_t stream = nullptr;
+  float *block = nullptr;
+};
+
+int const kExtent = 128;
+
+/// Submits the GEMMs of one job
+static Status submit_job(Handle &handle, ThreadState const &state, int gemm_count) {
+
+  float alpha = 1;
+  float beta = 0;
+
+  size_t matrix_elements = size_t(kExtent) * kExtent;
+
+  Status status = Status::kSuccess;
+
+  for (int idx = 0; idx < gemm_count && status == Status::kSuccess; ++idx) {
+    status = handle.gemm_universal(
+      GemmUniversalMode::kGemm, kExtent, kExtent, kExtent,
+      NumericTypeID::kF32, NumericTypeID::kF32, &alpha,
+      NumericTypeID::kF32, LayoutTypeID::kColumnMajor, ComplexTransform::kNone, state.block, kExtent,
+      NumericTypeID::kF32, LayoutTypeID::kColumnMajor, ComplexTransform::kNone, state.block + matrix_elements, kExtent,
+      &beta,
+      NumericTypeID::kF32, LayoutTypeID::kColumnMajor, state.block + matrix_elements * 2, kExtent,
+      NumericTypeID::kF32, LayoutTypeID::kColumnMajor, state.block + matrix_elements * 2, kExtent);
+  }
+
+  return status;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char const **argv) {
+
+  int thread_count = (argc > 1 ? std::atoi(argv[1]) : 8);
+  int job_count = (argc > 2 ? std::atoi(argv[2]) : 64);
+  int gemm_count = (argc > 3 ? std::atoi(argv[3]) : 4);
+
+  HandlePool &pool = HandlePool::get();
+
+  int device_count = pool.device_count();
+  if (device_count <= 0) {
+    std::cerr << "No MUSA device found" << std::endl;
+    return -1;
+  }
+
+  std::vector<ThreadState> states(thread_count);
+
+  for (int t = 0; t < thread_count; ++t) {
+    ThreadState &state = states[t];
+    state.device_idx = t % device_count;
+
+    if (musaSetDevice(state.device_idx) != musaSuccess ||
+      musaStreamCreate(&state.stream) != musaSuccess ||
+      musaMalloc(reinterpret_cast<void **>(&state.block), sizeof(float) * kExtent * kExtent * 3) != musaSuccess) {
+      std::cerr << "Failed to allocate thread resources" << std::endl;
+      return -1;
+    }
+  }
+
+  // Runs all threads and returns the elapsed time
+  auto run_pass = [&](bool use_pool) {
+
+    std::vector<Status> statuses(thread_count, Status::kSuccess);
+    std::vector<std::thread> threads;
+
+    auto start = Clock::now();
+
+    for (int t = 0; t < thread_count; ++t) {
+      threads.emplace_back([&, t]() {
+        ThreadState const &state = states[t];
+        for (int job = 0; job < job_count && statuses[t] == Status::kSuccess; ++job) {
+          if (use_pool) {
+            statuses[t] = submit_job(pool.acquire(state.device_idx, state.stream), state, gemm_count);
+          }
+          else {
+            (void)musaSetDevice(state.device_idx);
+            Handle handle(state.stream);
+            statuses[t] = submit_job(handle, state, gemm_count);
+          }
+        }
+      });
+    }
+
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+
+    double us = elapsed_us(start, Clock::now());
+
+    for (int device_idx = 0; device_idx < device_count; ++device_idx) {
+      (void)musaSetDevice(device_idx);
+      (void)musaDeviceSynchronize();
+    }
+
+    for (Status status : statuses) {
+      if (status != Status::kSuccess) {
+        return -1.0;
+      }
+    }
+
+    return us;
+  };
+
+  // Warm up, constructing the operations. Each pass acquires pooled handles once per thread, as
+  // they are released when the thread exits.
+  if (run_pass(false) < 0 || run_pass(true) < 0) {
+    std::cerr << "No operation supports the benchmark problems" << std::endl;
+    return -1;
+  }
+
+  double handle_us = run_pass(false);
+  double pool_us = run_pass(true);
+
+  double gemms = double(thread_count) * job_count * gemm_count;
+
+  std::cout << std::fixed << std::setprecision(3)
+    << "Threads: " << thread_count << ", devices: " << device_count
+    << ", jobs per thread: " << job_count << ", GEMMs per job: " << gemm_count << "\n"
+    << "Handle per job:  " << handle_us / gemms << " us per GEMM\n"
+    << "HandlePool:      " << pool_us / gemms << " us per GEMM ("
+    << (pool_us > 0 ? handle_us / pool_us : 0.0) << "x)\n";
+
+  for (ThreadState &state : states) {
+    (void)musaSetDevice(state.device_idx);
+    (void)musaStreamDestroy(state.stream);
+    (void)musaFree(state.block);
+  }
+
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,132 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/* \file
+   \brief Compares the time to initialize the MUTLASS Library when generated GEMM operations are
+      constructed eagerly with the time when they are constructed on first lookup.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "mutlass/library/library.h"
+#include "mutlass/library/manifest.h"
+#include "mutlass/library/operation_table.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace mutlass::library;
+
+using Clock = std::chrono::steady_clock;
+
+/// Returns the elapsed time in milliseconds
+static double elapsed_ms(Clock::time_point start, Clock::time_point stop) {
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char const **argv) {
+
+  //
+  // Eager: construct every operation and index it before the first query
+  //
+
+  double eager_ms = 0;
+  size_t eager_operations = 0;
+  {
+    auto start = Clock::now();
+
+    Manifest manifest;
+    manifest.initialize();
+
+    OperationTable table;
+    table.append(manifest);
+
+    eager_ms = elapsed_ms(start, Clock::now());
+    eager_operations = manifest.operations().size();
+  }
+
+  //
+  // Lazy: record generated operations by functional key and construct them on first lookup
+  //
+
+  double lazy_ms = 0;
+  double lookup_ms = 0;
+  double max_lookup_ms = 0;
+  size_t lazy_operations = 0;
+  size_t deferred_operations = 0;
+  size_t deferred_keys = 0;
+  {
+    auto start = Clock::now();
+
+    Manifest manifest;
+    manifest.initialize(true);
+
+    OperationTable table;
+    table.append(manifest);
+
+    lazy_ms = elapsed_ms(start, Clock::now());
+    lazy_operations = manifest.operations().size();
+    deferred_operations = manifest.deferred_operation_count();
+
+    std::vector<GemmFunctionalKey> keys = manifest.deferred_keys();
+    deferred_keys = keys.size();
+
+    for (auto const &key : keys) {
+      auto lookup_start = Clock::now();
+
+      table.find_gemm_operations(manifest, key);
+
+      double ms = elapsed_ms(lookup_start, Clock::now());
+      lookup_ms += ms;
+      max_lookup_ms = std::max(max_lookup_ms, ms);
+    }
+  }
+
+  std::cout << std::fixed << std::setprecision(3)
+    << "Eager registration:  " << eager_ms << " ms, "
+    << eager_operations << " operations constructed\n"
+    << "Lazy registration:   " << lazy_ms << " ms, "
+    << lazy_operations << " operations constructed, "
+    << deferred_operations << " deferred under " << deferred_keys << " functional keys\n"
+    << "First lookup:        " << (deferred_keys ? lookup_ms / deferred_keys : 0.0) << " ms average, "
+    << max_lookup_ms << " ms maximum per functional key\n"
+    << "All first lookups:   " << lookup_ms << " ms\n";
+
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -303,6 +303,44 @@ struct GemmDescription : public OperationDescription {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Description of fused multi-head attention computations
+struct FmhaDescription : public OperationDescription {
+
+  /// Describes the query operand
+  TensorDescription Q;
+
+  /// Describes the key operand
+  TensorDescription K;
+
+  /// Describes the value operand
+  TensorDescription V;
+
+  /// Describes the output
+  TensorDescription O;
+
+  /// Number of elements of each head
+  int head_dim;
+
+  //
+  // Methods
+  //
+
+  FmhaDescription(
+    TensorDescription const& Q = TensorDescription(),
+    TensorDescription const& K = TensorDescription(),
+    TensorDescription const& V = TensorDescription(),
+    TensorDescription const& O = TensorDescription(),
+    int head_dim = 0
+  ):
+    Q(Q),
+    K(K),
+    V(V),
+    O(O),
+    head_dim(head_dim) {}
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace library
 } // namespace mutlass
 
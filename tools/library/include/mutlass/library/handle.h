@@ -35,8 +35,12 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <unordered_map>
 #include "mutlass/library/library.h"
+#include "mutlass/library/gemm_functional_key.h"
+#include "mutlass/library/workspace_arena.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -45,6 +49,55 @@ namespace library {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// GEMM problem submitted to Handle::gemm_batch(). Members follow the arguments of
+/// Handle::gemm_universal().
+struct GemmRequest {
+
+  GemmUniversalMode mode = GemmUniversalMode::kGemm;
+
+  int M = 0;
+  int N = 0;
+  int K = 0;
+
+  NumericTypeID element_compute = NumericTypeID::kInvalid;
+  NumericTypeID element_scalar = NumericTypeID::kInvalid;
+
+  void const *alpha = nullptr;
+
+  NumericTypeID element_A = NumericTypeID::kInvalid;
+  LayoutTypeID layout_A = LayoutTypeID::kColumnMajor;
+  ComplexTransform transform_A = ComplexTransform::kNone;
+  void const *ptr_A = nullptr;
+  int64_t lda = 0;
+
+  NumericTypeID element_B = NumericTypeID::kInvalid;
+  LayoutTypeID layout_B = LayoutTypeID::kColumnMajor;
+  ComplexTransform transform_B = ComplexTransform::kNone;
+  void const *ptr_B = nullptr;
+  int64_t ldb = 0;
+
+  void const *beta = nullptr;
+
+  NumericTypeID element_C = NumericTypeID::kInvalid;
+  LayoutTypeID layout_C = LayoutTypeID::kColumnMajor;
+  void const *ptr_C = nullptr;
+  int64_t ldc = 0;
+
+  NumericTypeID element_D = NumericTypeID::kInvalid;
+  LayoutTypeID layout_D = LayoutTypeID::kColumnMajor;
+  void *ptr_D = nullptr;
+  int64_t ldd = 0;
+
+  int batch_count = 1;
+
+  int64_t batch_stride_A = 0;
+  int64_t batch_stride_B = 0;
+  int64_t batch_stride_C = 0;
+  int64_t batch_stride_D = 0;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Handle object
 class Handle {
 private:
@@ -55,17 +108,17 @@ private:
   /// Provider of operations
   Provider provider_;
 
+  /// Index of the MUSA device
+  int device_idx_;
+
   /// MUSA device properties
   musaDeviceProp device_;
 
   /// MUSA stream
   musaStream_t stream_;
 
-  /// Device workspace
-  void *workspace_;
-
-  /// Size of device workspace in bytes
-  size_t workspace_size_;
+  /// Device workspace, from which the workspace of each launch is sub-allocated
+  WorkspaceArena workspace_arena_;
     
   /// Indicates whether scalars are host or device pointers
   ScalarPointerMode scalar_pointer_mode_;
@@ -73,11 +126,26 @@ private:
   /// Pointer to the most recently exemuted operation
   Operation const *last_operation_;
 
+  /// Operations selected by this handle, by functional key and problem alignment. Lookups that
+  /// hit this cache do not synchronize with other handles.
+  std::unordered_map<
+    GemmFunctionalKey,
+    std::map<int, Operation const *>,
+    GemmFunctionalKeyHasher> gemm_operation_cache_;
+
 public:
 
   /// Constructor
   Handle(musaStream_t stream = nullptr, size_t workspace_size = (4<<20));
 
+  /// Constructs a handle for a given device, which must be current. The device properties are not
+  /// queried.
+  Handle(
+    int device_idx,
+    musaDeviceProp const &device,
+    musaStream_t stream,
+    size_t workspace_size);
+
   /// Destructor
   ~Handle();
 
@@ -94,6 +162,9 @@ public:
   /// Returns compute capability of the selected device
   int compute_capability() const;
 
+  /// Returns the index of the selected device
+  int get_device_index() const;
+
   /// Sets the current MUSA stream
   void set_stream(musaStream_t stream);
 
@@ -112,9 +183,14 @@ public:
   /// Gets a pointer to the device workspace allocation in Global Memory
   void *get_workspace() const;
 
-  /// Sets the size of device workspace, invalidating calls to get_device_workspace()
+  /// Ensures the device workspace holds at least the given number of bytes, or releases it if
+  /// bytes is zero, invalidating calls to get_device_workspace(). The workspace otherwise grows
+  /// as operations require and never shrinks.
   void set_workspace_size(size_t bytes);
 
+  /// Gets usage statistics of the device workspace
+  WorkspaceArenaStatistics const &get_workspace_statistics() const;
+
   /// Gets the scalar pointer mode
   ScalarPointerMode get_scalar_pointer_mode() const;
 
@@ -124,6 +200,10 @@ public:
   /// Gets the most recently exemuted operation
   Operation const *get_last_operation() const;
 
+  /// Selects the preferred GEMM operation of a functional key for the compute capability of the
+  /// device and a problem alignment. Returns nullptr if none is supported.
+  Operation const *select_gemm_operation(GemmFunctionalKey const &key, int alignment);
+
   //
   // Computations
   //
@@ -215,6 +295,20 @@ public:
     int64_t batch_stride_C = 0,               /// Batch stride of C operand
     int64_t batch_stride_D = 0                /// Batch stride of D operand
   );
+
+  /// Exemutes a batch of independent GEMM computations: D <= alpha * A*B + beta * C.
+  //
+  // Operations are selected through the cache of the handle, and requests are submitted grouped
+  // by the operation selected for them, so they may complete in any order. Consecutive requests
+  // of a group that differ only in equally strided operands are submitted as a single batched
+  // launch. If statuses is not null, it receives the status of each request. Returns the
+  // first failure or Status::kSuccess.
+  //
+  Status gemm_batch(
+    GemmRequest const *requests,              /// Array of requests
+    int count,                                /// Number of requests
+    Status *statuses = nullptr                /// Optional array receiving the status of each request
+  );
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,166 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Pool of library::Handle objects shared by the threads of a process driving one or more
+      MUSA devices.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "mutlass/library/handle.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace library {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Thread-safe pool of handles keyed by device and stream.
+//
+// Each thread acquires its own handle for a (device, stream) pair, so handles are never shared
+// between threads and their state, including the cache of selected operations and the workspace
+// arena, is accessed without synchronization. Device properties are queried once per device.
+// The workspace is not shared between the handles of a device, as launches on different streams
+// may run concurrently.
+//
+// A handle remains valid until the thread that acquired it exits, when it is returned to the
+// pool and released, or until the pool is destroyed.
+//
+// The pool lock is only taken the first time a thread acquires the handle of a (device, stream)
+// pair. Later acquisitions are resolved from a thread-local cache.
+//
+class HandlePool {
+private:
+
+  /// Handles acquired by a thread, released when the thread exits
+  struct ThreadHandles;
+
+  /// Properties of a device
+  struct DeviceState {
+    musaDeviceProp properties;
+  };
+
+  /// Key of a handle
+  struct HandleKey {
+    std::thread::id thread;
+    int device_idx;
+    musaStream_t stream;
+
+    bool operator<(HandleKey const &rhs) const {
+      if (thread != rhs.thread) {
+        return thread < rhs.thread;
+      }
+      if (device_idx != rhs.device_idx) {
+        return device_idx < rhs.device_idx;
+      }
+      return stream < rhs.stream;
+    }
+  };
+
+  /// Unique identifier of the pool, distinguishing its entries in the thread-local caches
+  uint64_t id_;
+
+  /// Initial size of the device workspace of each handle in bytes
+  size_t workspace_size_;
+
+  /// Guards devices_ and handles_
+  mutable std::mutex mutex_;
+
+  /// State of each device, created on first use
+  mutable std::vector<std::unique_ptr<DeviceState>> devices_;
+
+  /// Handles of each thread, device and stream
+  std::map<HandleKey, std::unique_ptr<Handle>> handles_;
+
+public:
+
+  /// Constructor. The workspace of each handle grows from the given size as operations require.
+  explicit HandlePool(size_t workspace_size = 0);
+
+  /// Destructor releases all handles
+  ~HandlePool();
+
+  HandlePool(HandlePool const &) = delete;
+  HandlePool &operator=(HandlePool const &) = delete;
+
+  /// Returns the calling thread's handle for the current device and a stream
+  Handle &acquire(musaStream_t stream = nullptr);
+
+  /// Returns the calling thread's handle for a device and a stream, making the device current
+  Handle &acquire(int device_idx, musaStream_t stream);
+
+  /// Returns the number of MUSA devices
+  int device_count() const;
+
+  /// Returns the compute capability of a device
+  int compute_capability(int device_idx) const;
+
+  /// Returns the initial size of the device workspace of each handle in bytes
+  size_t get_workspace_size() const;
+
+  /// Returns the number of handles created
+  size_t handle_count() const;
+
+  /// Returns the pool shared by the process. It is never destroyed, so that no device is
+  /// accessed during static destruction.
+  static HandlePool &get();
+
+private:
+
+  /// Returns the state of a device, creating it if needed. Requires mutex_ to be held.
+  DeviceState &device_(int device_idx) const;
+
+  /// Creates the calling thread's handle for a device and a stream. The device must be current.
+  Handle *create_(int device_idx, musaStream_t stream);
+
+  /// Releases the calling thread's handle for a device and a stream
+  void release_(int device_idx, musaStream_t stream);
+
+  /// Returns the handles acquired by the calling thread
+  static ThreadHandles &thread_handles_();
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
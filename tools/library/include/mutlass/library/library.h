@@ -110,6 +110,34 @@ public:
     void *device_workspace = nullptr, 
     musaStream_t stream = nullptr) const = 0;
 
+  /// Validates the arguments once and prepares the host workspace, which must have been set up by
+  /// initialize(), for repeated launches with launch(). Operations without a prepared path
+  /// return Status::kErrorNotSupported.
+  virtual Status prepare(
+    void const *arguments,
+    void *host_workspace,
+    void *device_workspace = nullptr,
+    musaStream_t stream = nullptr) const {
+    return Status::kErrorNotSupported;
+  }
+
+  /// Replaces the operand pointers of a prepared host workspace
+  virtual Status update_pointers(
+    void *host_workspace,
+    void const *A,
+    void const *B,
+    void const *C,
+    void *D) const {
+    return Status::kErrorNotSupported;
+  }
+
+  /// Launches the operation prepared in the host workspace
+  virtual Status launch(
+    void *host_workspace,
+    musaStream_t stream = nullptr) const {
+    return Status::kErrorNotSupported;
+  }
+
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -805,6 +833,65 @@ struct ReductionArguments {
   ScalarPointerMode pointer_mode;
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Configuration for fused multi-head attention forward
+//
+// OperationKind: Fmha
+//
+// Q and O hold num_heads and K and V hold num_heads_kv rows of head_dim contiguous elements per
+// token; the ld* strides are the number of elements between consecutive tokens.
+//
+struct FmhaConfiguration {
+
+  /// Number of sequences
+  int batch_count;
+
+  /// Queries of every sequence, or their maximum if the arguments give cu_seqlens_q
+  int seqlen_q;
+
+  /// Keys of every sequence, or their maximum if the arguments give cu_seqlens_k
+  int seqlen_k;
+
+  /// Number of query heads
+  int num_heads;
+
+  /// Number of key and value heads, which divides num_heads
+  int num_heads_kv;
+
+  /// Masks keys after each query, aligned to the last query and key of a sequence
+  bool causal;
+
+  /// Token strides of Q, K, V and O
+  int64_t ldq;
+  int64_t ldk;
+  int64_t ldv;
+  int64_t ldo;
+};
+
+/// Arguments for fused multi-head attention forward
+struct FmhaArguments {
+
+  /// Pointers to the packed Q, K and V tensors
+  void const *Q;
+  void const *K;
+  void const *V;
+
+  /// Pointer to the packed output tensor
+  void *O;
+
+  /// Device arrays of batch_count + 1 token offsets of the sequences, or null for sequences of
+  /// fixed length
+  int const *cu_seqlens_q;
+  int const *cu_seqlens_k;
+
+  /// Scale applied to Q K^T before the softmax
+  float softmax_scale;
+
+  /// Optional device array receiving the logsumexp of each query and head
+  float *lse;
+};
+
 } // namespace library
 } // namespace mutlass
 
@@ -41,10 +41,13 @@
 #include <list>
 #include <memory>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "library.h"
+#include "gemm_functional_key.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -66,6 +69,21 @@ void initialize_all_reduction_op(Manifest &manifest);
 /// List of operations
 using OperationVector = std::vector<std::unique_ptr<Operation>>;
 
+/// Constructs a generated operation on demand
+using OperationFactory = Operation *(*)();
+
+/// Generated GEMM operation registered by its functional key and not yet constructed
+struct DeferredGemmOperation {
+
+  GemmFunctionalKey key;
+
+  /// Constructs the operation. Null once it has been constructed.
+  OperationFactory factory;
+
+  DeferredGemmOperation(GemmFunctionalKey const &key, OperationFactory factory):
+    key(key), factory(factory) { }
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Manifest of MUTLASS Library
@@ -78,11 +96,21 @@ private:
   /// Global list of operations
   OperationVector operations_;
 
+  /// If true, generated GEMM operations are recorded rather than constructed when registered
+  bool lazy_;
+
+  /// GEMM operations registered while lazy, in registration order
+  std::vector<DeferredGemmOperation> deferred_gemm_operations_;
+
+  /// Indices into deferred_gemm_operations_ of the operations not yet constructed, by functional key
+  std::unordered_map<GemmFunctionalKey, std::vector<size_t>, GemmFunctionalKeyHasher> deferred_gemm_keys_;
+
 public:
-  Manifest (Provider provider = library::Provider::kMUTLASS) : provider_(provider) { }
+  Manifest (Provider provider = library::Provider::kMUTLASS) : provider_(provider), lazy_(false) { }
 
-  /// Top-level initialization
-  Status initialize();
+  /// Top-level initialization. If lazy, generated GEMM operations are only recorded by their
+  /// functional key and are constructed by construct() or construct_all().
+  Status initialize(bool lazy = false);
 
   /// Used for initialization
   void reserve(size_t operation_count);
@@ -93,6 +121,24 @@ public:
   /// Appends an operation and takes ownership
   void append(Operation *operation_ptr);
 
+  /// Registers a generated GEMM operation, constructing it immediately unless the manifest is lazy
+  void append(GemmFunctionalKey const &key, OperationFactory factory);
+
+  /// Returns true if generated GEMM operations are constructed on demand
+  bool lazy() const;
+
+  /// Functional keys of the GEMM operations not yet constructed
+  std::vector<GemmFunctionalKey> deferred_keys() const;
+
+  /// Number of GEMM operations not yet constructed
+  size_t deferred_operation_count() const;
+
+  /// Constructs the deferred GEMM operations of a functional key and returns them
+  std::vector<Operation const *> construct(GemmFunctionalKey const &key);
+
+  /// Constructs all deferred GEMM operations in registration order and returns them
+  std::vector<Operation const *> construct_all();
+
   /// Returns an iterator to the first operation
   OperationVector const &operations() const;
 
@@ -42,6 +42,7 @@
 #include <algorithm>
 
 #include "mutlass/library/library.h"
+#include "mutlass/library/gemm_functional_key.h"
 #include "mutlass/library/manifest.h"
 #include "mutlass/library/util.h"
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -53,146 +54,6 @@ namespace library {
 //                          Data Structures for Gemm Functional Maps
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// Tuple uniquely identifying Gemm functional behavior
-struct GemmFunctionalKey {
-
-  Provider provider;
-  GemmKind gemm_kind;
-  NumericTypeID element_compute;
-  NumericTypeID element_scalar;
-  NumericTypeID element_A;
-  LayoutTypeID layout_A;
-  ComplexTransform transform_A;
-  NumericTypeID element_B;
-  LayoutTypeID layout_B;
-  ComplexTransform transform_B;
-  NumericTypeID element_C;
-  LayoutTypeID layout_C;
-  NumericTypeID element_D;
-  LayoutTypeID layout_D;
-
-  //
-  // Methods
-  //
-
-  inline
-  GemmFunctionalKey(
-    Provider provider,
-    GemmKind gemm_kind = GemmKind::kGemm,
-    NumericTypeID element_compute = NumericTypeID::kF32,
-    NumericTypeID element_scalar = NumericTypeID::kF32,
-    NumericTypeID element_A = NumericTypeID::kF16,
-    LayoutTypeID layout_A = LayoutTypeID::kColumnMajor,
-    ComplexTransform transform_A = ComplexTransform::kNone,
-    NumericTypeID element_B = NumericTypeID::kF16,
-    LayoutTypeID layout_B = LayoutTypeID::kColumnMajor,
-    ComplexTransform transform_B = ComplexTransform::kNone,
-    NumericTypeID element_C = NumericTypeID::kF16,
-    LayoutTypeID layout_C = LayoutTypeID::kColumnMajor,
-    NumericTypeID element_D = NumericTypeID::kF16,
-    LayoutTypeID layout_D = LayoutTypeID::kColumnMajor
-  ):
-    provider(provider),
-    gemm_kind(gemm_kind),
-    element_compute(element_compute),
-    element_scalar(element_scalar),
-    element_A(element_A),
-    layout_A(layout_A),
-    transform_A(transform_A),
-    element_B(element_B),
-    layout_B(layout_B),
-    transform_B(transform_B),
-    element_C(element_C),
-    layout_C(layout_C),
-    element_D(element_D),
-    layout_D(layout_D)
-  { }
-
-  inline
-  bool operator==(GemmFunctionalKey const &rhs) const {
-    return 
-      (provider == rhs.provider) &&
-      (gemm_kind == rhs.gemm_kind) &&
-      (element_compute == rhs.element_compute) &&
-      (element_scalar == rhs.element_scalar) &&
-      (element_A == rhs.element_A) &&
-      (layout_A == rhs.layout_A) &&
-      (transform_A == rhs.transform_A) &&
-      (element_B == rhs.element_B) &&
-      (layout_B == rhs.layout_B) &&
-      (transform_B == rhs.transform_B) &&
-      (element_C == rhs.element_C) &&
-      (layout_C == rhs.layout_C) &&
-      (element_D == rhs.element_D) &&
-      (layout_D == rhs.layout_D);
-  }
-
-  inline
-  bool operator!=(GemmFunctionalKey const &rhs) const {
-    return !(*this == rhs);
-  }
-};
-
-
-/////////////////////////////////////////////////////////////////////////////////////////////////
-inline
-std::ostream & operator<<(std::ostream &out, mutlass::library::GemmFunctionalKey const &k) {
-
-  out << "{\n"
-    << "         provider: " << to_string(k.provider) << "\n"
-    << "        gemm_kind: " << to_string(k.gemm_kind) << "\n"
-    << "  element_compute: " << to_string(k.element_compute) << "\n"
-    << "   element_scalar: " << to_string(k.element_scalar) << "\n"
-    << "        element_A: " << to_string(k.element_A) << "\n"
-    << "         layout_A: " << to_string(k.layout_A) << "\n"
-    << "      transform_A: " << to_string(k.transform_A) << "\n"
-    << "        element_B: " << to_string(k.element_B) << "\n"
-    << "         layout_B: " << to_string(k.layout_B) << "\n"
-    << "      transform_B: " << to_string(k.transform_B) << "\n"
-    << "        element_C: " << to_string(k.element_C) << "\n"
-    << "         layout_C: " << to_string(k.layout_C) << "\n"
-    << "        element_D: " << to_string(k.element_D) << "\n"
-    << "         layout_D: " << to_string(k.layout_D) << "\n"
-    << "}";
-
-  return out;
-}
-
-/////////////////////////////////////////////////////////////////////////////////////////////////
-
-/// Hash function for GemmFunctionalKey
-struct GemmFunctionalKeyHasher {
-  using IntHash = std::hash<int>;
-
-  inline
-  static size_t rotl(size_t key, int shl) {
-    return (key << shl) | (key >> (sizeof(key)*8 - shl));
-  }
-
-  inline
-  size_t operator()(GemmFunctionalKey const &key) const {
-    IntHash hash;
-
-    return
-      rotl(hash(int(key.provider)),        1) ^ 
-      rotl(hash(int(key.gemm_kind)),       2) ^ 
-      rotl(hash(int(key.element_compute)), 3) ^
-      rotl(hash(int(key.element_scalar)),  4) ^
-      rotl(hash(int(key.element_A)),       5) ^
-      rotl(hash(int(key.layout_A)),        6) ^
-      rotl(hash(int(key.transform_A)),     7) ^
-      rotl(hash(int(key.element_B)),       8) ^
-      rotl(hash(int(key.layout_B)),        9) ^
-      rotl(hash(int(key.transform_B)),    10) ^
-      rotl(hash(int(key.element_C)),      11) ^
-      rotl(hash(int(key.layout_C)),       12) ^
-      rotl(hash(int(key.element_D)),      13) ^
-      rotl(hash(int(key.layout_D)),       14);
-  }
-};
-
-/////////////////////////////////////////////////////////////////////////////////////////////////
-
 /// Establishes a partial ordering to search for GEMM operators
 struct GemmPreferenceKey {
 
@@ -256,8 +117,18 @@ public:
   
 public:
 
+  /// Inserts the operations constructed by the manifest. Functional keys whose operations are
+  /// deferred are inserted without operations so that later insertions do not rehash the map.
   void append(Manifest const &manifest);
 
+  /// Inserts a single operation
+  void append(Operation const *operation);
+
+  /// Returns the operations of a functional key, first constructing any deferred by the manifest.
+  /// Returns gemm_operations.end() if the key is unknown.
+  GemmOperationFunctionalMap::const_iterator find_gemm_operations(
+    Manifest &manifest,
+    GemmFunctionalKey const &key);
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -266,5 +137,3 @@ public:
 } // namespace mutlass
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
-
-std::ostream & operator<<(std::ostream &out, mutlass::library::GemmFunctionalKey const &k);
@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "mutlass/library/library.h"
 #include "mutlass/library/manifest.h"
 #include "mutlass/library/operation_table.h"
@@ -53,11 +55,36 @@ public:
   /// Operation table referencing the Manifest
   OperationTable operation_table;
 
+private:
+
+  /// Serializes construction of deferred operations
+  std::mutex mutex_;
+
+  /// Handle looks up operations lazily through find_gemm_operations()
+  friend class Handle;
+
 public:
 
+  /// Registers all operations. Generated GEMM operations are constructed on the first lookup
+  /// of their functional key by a Handle, or all at once by get().
   Singleton();
 
+  /// Returns the singleton with all operations constructed. Once constructed, the manifest and
+  /// operation table are no longer modified and may be enumerated without synchronization.
   static Singleton const &get();
+
+  /// Returns the singleton with all operations constructed. Equivalent to get().
+  static Singleton const &get_all();
+
+private:
+
+  /// Returns the singleton, whose deferred operations may not have been constructed yet
+  static Singleton &instance_();
+
+  /// Returns a copy of the operations of a functional key, constructing them on first lookup.
+  /// The copy is taken under the lock as concurrent lookups may rehash the operation table.
+  /// Returns an empty map if the key is unknown.
+  static GemmOperationVectorMap find_gemm_operations(GemmFunctionalKey const &key);
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -141,6 +141,7 @@ enum class OperationKind {
   kEqGemm,
   kSparseGemm,
   kReduction,
+  kFmha,
   kInvalid
 };
 
@@ -0,0 +1,170 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Growable arena of device workspace from which library::Handle sub-allocates the
+      workspace of each operation it launches.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "mutlass/library/library.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace library {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Usage statistics of a WorkspaceArena
+struct WorkspaceArenaStatistics {
+
+  /// Size of the current buffer in bytes
+  size_t capacity = 0;
+
+  /// Bytes sub-allocated since the last reset, including alignment padding
+  size_t in_use = 0;
+
+  /// Largest number of bytes sub-allocated between two resets
+  size_t high_water_mark = 0;
+
+  /// Number of sub-allocations
+  size_t allocation_count = 0;
+
+  /// Number of times a larger buffer was allocated
+  size_t growth_count = 0;
+
+  /// Total number of bytes zeroed
+  size_t bytes_cleared = 0;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Growable arena of device workspace.
+//
+// allocate() returns aligned regions of one buffer and reset() makes the whole buffer available
+// again, so the workspace of consecutive operations is reused without device allocations. If a
+// region does not fit, a buffer at least twice as large is allocated, and the previous buffer is
+// released on the next reset as regions of it may still be referenced. The buffer never shrinks
+// unless release() is called.
+//
+// Each byte of a buffer is zeroed the first time it is sub-allocated, on the stream of that
+// allocation. Operations that rely on workspace contents in later launches restore them, as they
+// did with the fixed workspace of a handle, so regions are not cleared again when reused.
+//
+// An arena is not thread-safe.
+//
+class WorkspaceArena {
+public:
+
+  /// Alignment of each region in bytes
+  static size_t const kAlignment = 256;
+
+  /// Smallest buffer allocated when the arena grows
+  static size_t const kMinimumCapacity = (64 << 10);
+
+private:
+
+  /// Current buffer
+  void *buffer_;
+
+  /// Next free position of the current buffer
+  size_t offset_;
+
+  /// Bytes of the current buffer zeroed so far, starting from its beginning
+  size_t cleared_;
+
+  /// Buffers replaced while their regions were in use, released on the next reset
+  std::vector<void *> retired_;
+
+  /// Statistics
+  WorkspaceArenaStatistics statistics_;
+
+public:
+
+  /// Constructs an arena, allocating a buffer of the given size. Throws std::runtime_error if
+  /// the allocation fails.
+  explicit WorkspaceArena(size_t capacity = 0);
+
+  /// Destructor releases all buffers
+  ~WorkspaceArena();
+
+  WorkspaceArena(WorkspaceArena const &) = delete;
+  WorkspaceArena &operator=(WorkspaceArena const &) = delete;
+
+  /// Move constructor
+  WorkspaceArena(WorkspaceArena &&arena);
+
+  /// Move assignment operator
+  WorkspaceArena &operator=(WorkspaceArena &&arena);
+
+  /// Ensures the buffer holds at least the given number of bytes. Throws std::runtime_error if
+  /// the allocation fails.
+  void reserve(size_t bytes);
+
+  /// Returns an aligned region of the given size, zeroing its bytes not yet cleared on a stream.
+  /// Returns the next free position of the buffer, which may be null, if bytes is zero. Returns
+  /// nullptr if the arena cannot grow.
+  void *allocate(size_t bytes, musaStream_t stream = nullptr);
+
+  /// Makes the whole buffer available to later allocations
+  void reset();
+
+  /// Releases all buffers
+  void release();
+
+  /// Returns the current buffer
+  void *data() const;
+
+  /// Returns the size of the current buffer in bytes
+  size_t capacity() const;
+
+  /// Returns usage statistics
+  WorkspaceArenaStatistics const &statistics() const;
+
+private:
+
+  /// Replaces the buffer by one of at least the given size, keeping the current one until the
+  /// next reset if regions of it are in use. Returns false if the allocation fails.
+  bool grow_(size_t bytes);
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
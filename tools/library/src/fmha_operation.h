@@ -0,0 +1,198 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+  \brief Defines operations for fused multi-head attention in MUTLASS Library.
+*/
+
+#pragma once
+
+#include <new>
+
+#include "mutlass/mutlass.h"
+#include "mutlass/library/library.h"
+#include "library_internal.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass::library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Wraps an fmha::device::FmhaForward handle. Q, K, V and O are packed with the heads of a token
+/// contiguous, so that only the token strides are configurable.
+template <typename Operator_>
+class FmhaForwardOperation : public Operation {
+public:
+  using Operator = Operator_;
+  using OperatorArguments = typename Operator::Arguments;
+  using Element = typename Operator::Element;
+  using ElementAccumulator = typename Operator::ElementAccumulator;
+  using StrideQKV = typename Operator::FmhaKernel::StrideQKV;
+
+private:
+
+  FmhaDescription description_;
+
+  /// The configuration is kept with the handle, since the arguments do not repeat it
+  struct HostWorkspace {
+    FmhaConfiguration configuration;
+    Operator op;
+  };
+
+public:
+
+  /// Constructor
+  FmhaForwardOperation(char const *name = "unknown_fmha") {
+
+    description_.name = name;
+    description_.provider = Provider::kMUTLASS;
+    description_.kind = OperationKind::kFmha;
+    description_.head_dim = Operator::HeadDim;
+
+    description_.tile_description.threadblock_shape = make_Coord(
+      Operator::BlockM, Operator::BlockN, Operator::HeadDim);
+    description_.tile_description.threadblock_stages = 1;
+    description_.tile_description.warp_count = make_Coord(Operator::BlockM / 32, 1, 1);
+
+    description_.tile_description.math_instruction.instruction_shape = make_Coord(32, 32, 16);
+    description_.tile_description.math_instruction.element_accumulator =
+      NumericTypeMap<ElementAccumulator>::kId;
+    description_.tile_description.math_instruction.opcode_class = OpcodeClassID::kTensorOp;
+    description_.tile_description.math_instruction.math_operation = MathOperationID::kMultiplyAdd;
+
+    description_.tile_description.minimum_compute_capability =
+      ArchMap<typename Operator::ArchTag, arch::OpClassTensorOp>::kMin;
+    description_.tile_description.maximum_compute_capability =
+      ArchMap<typename Operator::ArchTag, arch::OpClassTensorOp>::kMax;
+
+    description_.Q = make_TensorDescription<Element, layout::RowMajor>(Operator::kAlignment);
+    description_.K = make_TensorDescription<Element, layout::RowMajor>(Operator::kAlignment);
+    description_.V = make_TensorDescription<Element, layout::RowMajor>(Operator::kAlignment);
+    description_.O = make_TensorDescription<Element, layout::RowMajor>(Operator::kAlignment);
+  }
+
+  /// Returns the description of the FMHA operation
+  virtual OperationDescription const & description() const {
+    return description_;
+  }
+
+protected:
+
+  /// Constructs the arguments structure given the configuration and arguments
+  static OperatorArguments construct_arguments_(
+      FmhaConfiguration const *configuration, FmhaArguments const *arguments) {
+
+    OperatorArguments args;
+
+    args.batch_count = configuration->batch_count;
+    args.seqlen_q = configuration->seqlen_q;
+    args.seqlen_k = configuration->seqlen_k;
+    args.num_heads = configuration->num_heads;
+    args.num_heads_kv = configuration->num_heads_kv;
+    args.causal = configuration->causal;
+
+    args.ptr_Q = static_cast<Element const *>(arguments->Q);
+    args.ptr_K = static_cast<Element const *>(arguments->K);
+    args.ptr_V = static_cast<Element const *>(arguments->V);
+    args.ptr_O = static_cast<Element *>(arguments->O);
+    args.dQ = StrideQKV{configuration->ldq, int64_t(Operator::HeadDim)};
+    args.dK = StrideQKV{configuration->ldk, int64_t(Operator::HeadDim)};
+    args.dV = StrideQKV{configuration->ldv, int64_t(Operator::HeadDim)};
+    args.dO = StrideQKV{configuration->ldo, int64_t(Operator::HeadDim)};
+
+    args.cu_seqlens_q = arguments->cu_seqlens_q;
+    args.cu_seqlens_k = arguments->cu_seqlens_k;
+    args.softmax_scale = ElementAccumulator(arguments->softmax_scale);
+    args.ptr_LSE = arguments->lse;
+
+    return args;
+  }
+
+public:
+
+  /// Returns success if the operation can proceed
+  Status can_implement(
+      void const *configuration_ptr, void const *arguments_ptr) const override {
+
+    OperatorArguments args = construct_arguments_(
+      static_cast<FmhaConfiguration const *>(configuration_ptr),
+      static_cast<FmhaArguments const *>(arguments_ptr));
+
+    return Operator::can_implement(args);
+  }
+
+  /// Gets the host-side workspace
+  uint64_t get_host_workspace_size(void const *configuration) const override {
+    return sizeof(HostWorkspace);
+  }
+
+  /// Gets the device-side workspace
+  uint64_t get_device_workspace_size(
+      void const *configuration_ptr, void const *arguments_ptr) const override {
+    return 0;
+  }
+
+  /// Initializes the workspace
+  Status initialize(
+      void const *configuration_ptr,
+      void *host_workspace,
+      void *device_workspace,
+      musaStream_t stream = nullptr) const override {
+
+    HostWorkspace *workspace = new (host_workspace) HostWorkspace;
+    workspace->configuration = *static_cast<FmhaConfiguration const *>(configuration_ptr);
+
+    return Operator::initialize_function_attributes();
+  }
+
+  /// Runs the kernel
+  Status run(
+      void const *arguments_ptr,
+      void *host_workspace,
+      void *device_workspace = nullptr,
+      musaStream_t stream = nullptr) const override {
+
+    HostWorkspace *workspace = static_cast<HostWorkspace *>(host_workspace);
+
+    OperatorArguments args = construct_arguments_(
+      &workspace->configuration, static_cast<FmhaArguments const *>(arguments_ptr));
+
+    return workspace->op.run(args, device_workspace, stream);
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace mutlass::library
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
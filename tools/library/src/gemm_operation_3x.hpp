@@ -37,6 +37,7 @@
 
 #include "mutlass/mutlass.h"
 #include "mutlass/library/library.h"
+#include "mutlass/library/gemm_functional_key.h"
 #include "library_internal.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -167,6 +168,25 @@ public:
   GemmUniversal3xOperation(char const *name = "unknown_gemm"):
     GemmOperation3xBase<Operator_>(name, GemmKind::kUniversal) {}
 
+  /// Returns the functional key of the operation without constructing it
+  static GemmFunctionalKey functional_key() {
+    return GemmFunctionalKey(
+      Provider::kMUTLASS,
+      GemmKind::kUniversal,
+      NumericTypeMap<ElementAccumulator>::kId,
+      NumericTypeMap<ElementCompute>::kId,
+      NumericTypeMap<ElementA>::kId,
+      LayoutMap<LayoutA>::kId,
+      ComplexTransformMap<Operator::kTransformA>::kId,
+      NumericTypeMap<ElementB>::kId,
+      LayoutMap<LayoutB>::kId,
+      ComplexTransformMap<Operator::kTransformB>::kId,
+      NumericTypeMap<ElementC>::kId,
+      LayoutMap<LayoutC>::kId,
+      NumericTypeMap<ElementD>::kId,
+      LayoutMap<LayoutD>::kId);
+  }
+
 protected:
 
   /// Constructs the arguments structure given the configuration and arguments
@@ -327,6 +347,54 @@ public:
     status = op->run(args, device_workspace, stream);
     return status;
   }
+
+  /// Validates the arguments and lowers them into the operator's params once
+  Status prepare(
+      void const *arguments_ptr,
+      void *host_workspace,
+      void *device_workspace = nullptr,
+      musaStream_t stream = nullptr) const override {
+
+    OperatorArguments args;
+    Status status = update_arguments_(args, static_cast<GemmUniversalArguments const *>(arguments_ptr));
+    if (status != Status::kSuccess) {
+      return status;
+    }
+
+    status = Operator::can_implement(args);
+    if (status != Status::kSuccess) {
+      return status;
+    }
+
+    Operator *op = static_cast<Operator *>(host_workspace);
+    return op->initialize(args, device_workspace, stream);
+  }
+
+  /// Replaces the operand pointers of the prepared params
+  Status update_pointers(
+      void *host_workspace,
+      void const *A,
+      void const *B,
+      void const *C,
+      void *D) const override {
+
+    Operator *op = static_cast<Operator *>(host_workspace);
+    op->update_pointers(
+      static_cast<ElementA const *>(A),
+      static_cast<ElementB const *>(B),
+      static_cast<ElementC const *>(C),
+      static_cast<ElementD *>(D));
+    return Status::kSuccess;
+  }
+
+  /// Launches the prepared params
+  Status launch(
+      void *host_workspace,
+      musaStream_t stream = nullptr) const override {
+
+    Operator *op = static_cast<Operator *>(host_workspace);
+    return op->run(stream);
+  }
 };
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,314 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Pool of library::Handle objects keyed by device and stream.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#include "mutlass/library/handle_pool.h"
+
+namespace mutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Identifier of the next pool
+std::atomic<uint64_t> next_pool_id(1);
+
+/// Guards the registry of live pools. Threads exiting during static destruction may still
+/// access it, so it is never destroyed.
+std::mutex &pool_registry_mutex() {
+  static std::mutex *mutex = new std::mutex;
+  return *mutex;
+}
+
+/// Live pools by identifier. Requires pool_registry_mutex() to be held.
+std::map<uint64_t, HandlePool *> &pool_registry() {
+  static std::map<uint64_t, HandlePool *> *registry = new std::map<uint64_t, HandlePool *>;
+  return *registry;
+}
+
+/// Makes a device current if it is not already
+void set_device(int device_idx) {
+
+  int current_device_idx = -1;
+
+  if (musaGetDevice(&current_device_idx) != musaSuccess) {
+    throw std::runtime_error("musaGetDevice() failed");
+  }
+
+  if (current_device_idx != device_idx && musaSetDevice(device_idx) != musaSuccess) {
+    throw std::runtime_error("musaSetDevice() failed");
+  }
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Handles acquired by a thread, returned to their pools when the thread exits
+struct HandlePool::ThreadHandles {
+
+  /// Handle acquired from a pool
+  struct Entry {
+    uint64_t pool_id;
+    int device_idx;
+    musaStream_t stream;
+    Handle *handle;
+  };
+
+  std::vector<Entry> entries;
+
+  /// Returns the handles to the pools which still exist. The registry lock keeps a pool from
+  /// being destroyed while its handle is released.
+  ~ThreadHandles() {
+
+    std::lock_guard<std::mutex> lock(pool_registry_mutex());
+
+    for (Entry const &entry : entries) {
+      auto pool_it = pool_registry().find(entry.pool_id);
+      if (pool_it != pool_registry().end()) {
+        pool_it->second->release_(entry.device_idx, entry.stream);
+      }
+    }
+  }
+
+  /// Removes the entries of destroyed pools, whose handles have been released
+  void prune() {
+
+    std::lock_guard<std::mutex> lock(pool_registry_mutex());
+
+    entries.erase(
+      std::remove_if(entries.begin(), entries.end(), [](Entry const &entry) {
+        return pool_registry().find(entry.pool_id) == pool_registry().end();
+      }),
+      entries.end());
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Constructor
+HandlePool::HandlePool(size_t workspace_size):
+  id_(next_pool_id.fetch_add(1)),
+  workspace_size_(workspace_size) {
+
+  int device_count = 0;
+
+  if (musaGetDeviceCount(&device_count) != musaSuccess) {
+    throw std::runtime_error("musaGetDeviceCount() failed");
+  }
+
+  devices_.resize(device_count);
+
+  std::lock_guard<std::mutex> lock(pool_registry_mutex());
+  pool_registry()[id_] = this;
+}
+
+/// Destructor releases all handles
+HandlePool::~HandlePool() {
+
+  // Threads exiting from now on no longer return their handles to this pool
+  {
+    std::lock_guard<std::mutex> lock(pool_registry_mutex());
+    pool_registry().erase(id_);
+  }
+
+  int current_device_idx = -1;
+  musaGetDevice(&current_device_idx);
+
+  // Workspaces are released on the device of each handle
+  for (auto &entry : handles_) {
+    musaSetDevice(entry.first.device_idx);
+    entry.second.reset();
+  }
+
+  handles_.clear();
+
+  if (current_device_idx >= 0) {
+    musaSetDevice(current_device_idx);
+  }
+}
+
+/// Returns the calling thread's handle for the current device and a stream
+Handle &HandlePool::acquire(musaStream_t stream) {
+
+  int device_idx = -1;
+
+  if (musaGetDevice(&device_idx) != musaSuccess) {
+    throw std::runtime_error("musaGetDevice() failed");
+  }
+
+  return acquire(device_idx, stream);
+}
+
+/// Returns the calling thread's handle for a device and a stream, making the device current
+Handle &HandlePool::acquire(int device_idx, musaStream_t stream) {
+
+  set_device(device_idx);
+
+  ThreadHandles &thread_handles = thread_handles_();
+
+  for (ThreadHandles::Entry const &entry : thread_handles.entries) {
+    if (entry.pool_id == id_ && entry.device_idx == device_idx && entry.stream == stream) {
+      return *entry.handle;
+    }
+  }
+
+  thread_handles.prune();
+
+  Handle *handle = create_(device_idx, stream);
+
+  thread_handles.entries.push_back(ThreadHandles::Entry{id_, device_idx, stream, handle});
+
+  return *handle;
+}
+
+/// Returns the number of MUSA devices
+int HandlePool::device_count() const {
+  return int(devices_.size());
+}
+
+/// Returns the compute capability of a device
+int HandlePool::compute_capability(int device_idx) const {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  musaDeviceProp const &properties = device_(device_idx).properties;
+
+  return properties.major * 10 + properties.minor;
+}
+
+/// Returns the initial size of the device workspace of each handle in bytes
+size_t HandlePool::get_workspace_size() const {
+  return workspace_size_;
+}
+
+/// Returns the number of handles created
+size_t HandlePool::handle_count() const {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return handles_.size();
+}
+
+/// Returns the pool shared by the process. It is intentionally leaked, as releasing workspace
+/// during static destruction may call into a MUSA runtime which has already been torn down.
+HandlePool &HandlePool::get() {
+  static HandlePool *pool = new HandlePool;
+  return *pool;
+}
+
+/// Returns the state of a device, creating it if needed. Requires mutex_ to be held.
+HandlePool::DeviceState &HandlePool::device_(int device_idx) const {
+
+  if (device_idx < 0 || device_idx >= int(devices_.size())) {
+    throw std::out_of_range("Invalid device index");
+  }
+
+  if (!devices_[device_idx]) {
+
+    std::unique_ptr<DeviceState> device(new DeviceState);
+
+    if (musaGetDeviceProperties(&device->properties, device_idx) != musaSuccess) {
+      throw std::runtime_error("musaGetDeviceProperties() failed");
+    }
+
+    devices_[device_idx] = std::move(device);
+  }
+
+  return *devices_[device_idx];
+}
+
+/// Creates the calling thread's handle for a device and a stream. The device must be current.
+Handle *HandlePool::create_(int device_idx, musaStream_t stream) {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  DeviceState &device = device_(device_idx);
+
+  std::unique_ptr<Handle> &handle = handles_[HandleKey{std::this_thread::get_id(), device_idx, stream}];
+
+  if (!handle) {
+    handle.reset(new Handle(device_idx, device.properties, stream, workspace_size_));
+  }
+
+  return handle.get();
+}
+
+/// Releases the calling thread's handle for a device and a stream
+void HandlePool::release_(int device_idx, musaStream_t stream) {
+
+  std::unique_ptr<Handle> handle;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto handle_it = handles_.find(HandleKey{std::this_thread::get_id(), device_idx, stream});
+    if (handle_it == handles_.end()) {
+      return;
+    }
+
+    handle = std::move(handle_it->second);
+    handles_.erase(handle_it);
+  }
+
+  // The workspace is released on the device of the handle
+  int current_device_idx = -1;
+  musaGetDevice(&current_device_idx);
+  musaSetDevice(device_idx);
+
+  handle.reset();
+
+  if (current_device_idx >= 0 && current_device_idx != device_idx) {
+    musaSetDevice(current_device_idx);
+  }
+}
+
+/// Returns the handles acquired by the calling thread
+HandlePool::ThreadHandles &HandlePool::thread_handles_() {
+  thread_local ThreadHandles thread_handles;
+  return thread_handles;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace mutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -45,22 +45,31 @@ namespace library {
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void initialize_reference_operations(Manifest &manifest);
+void initialize_fmha_operations(Manifest &manifest);
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Top-level initialization
-Status Manifest::initialize() {
+Status Manifest::initialize(bool lazy) {
 
   if (!operations_.empty()) {
     operations_.clear();
   }
 
+  deferred_gemm_operations_.clear();
+  deferred_gemm_keys_.clear();
+
+  lazy_ = lazy;
+
   // initialize procedurally generated mutlass op in manifest object
   initialize_all(*this);
 
   // initialize manually instanced reference op in manifest object
   initialize_reference_operations(*this);
 
+  // initialize manually instanced fused attention op in manifest object
+  initialize_fmha_operations(*this);
+
   return Status::kSuccess;
 }
 
@@ -72,6 +81,8 @@ void Manifest::reserve(size_t operation_count) {
 /// Graceful shutdown
 Status Manifest::release() {
   operations_.clear();
+  deferred_gemm_operations_.clear();
+  deferred_gemm_keys_.clear();
   return Status::kSuccess;
 }
 
@@ -80,6 +91,93 @@ void Manifest::append(Operation *operation_ptr) {
   operations_.emplace_back(operation_ptr);
 }
 
+/// Registers a generated GEMM operation, constructing it immediately unless the manifest is lazy
+void Manifest::append(GemmFunctionalKey const &key, OperationFactory factory) {
+
+  if (!lazy_) {
+    append(factory());
+    return;
+  }
+
+  deferred_gemm_keys_[key].push_back(deferred_gemm_operations_.size());
+  deferred_gemm_operations_.emplace_back(key, factory);
+}
+
+/// Returns true if generated GEMM operations are constructed on demand
+bool Manifest::lazy() const {
+  return lazy_;
+}
+
+/// Functional keys of the GEMM operations not yet constructed
+std::vector<GemmFunctionalKey> Manifest::deferred_keys() const {
+
+  std::vector<GemmFunctionalKey> keys;
+  keys.reserve(deferred_gemm_keys_.size());
+
+  for (auto const &entry : deferred_gemm_keys_) {
+    keys.push_back(entry.first);
+  }
+
+  return keys;
+}
+
+/// Number of GEMM operations not yet constructed
+size_t Manifest::deferred_operation_count() const {
+
+  size_t count = 0;
+
+  for (auto const &entry : deferred_gemm_keys_) {
+    count += entry.second.size();
+  }
+
+  return count;
+}
+
+/// Constructs the deferred GEMM operations of a functional key and returns them
+std::vector<Operation const *> Manifest::construct(GemmFunctionalKey const &key) {
+
+  std::vector<Operation const *> constructed;
+
+  auto key_it = deferred_gemm_keys_.find(key);
+  if (key_it == deferred_gemm_keys_.end()) {
+    return constructed;
+  }
+
+  for (size_t idx : key_it->second) {
+
+    DeferredGemmOperation &deferred = deferred_gemm_operations_.at(idx);
+
+    append(deferred.factory());
+    deferred.factory = nullptr;
+
+    constructed.push_back(operations_.back().get());
+  }
+
+  deferred_gemm_keys_.erase(key_it);
+
+  return constructed;
+}
+
+/// Constructs all deferred GEMM operations in registration order and returns them
+std::vector<Operation const *> Manifest::construct_all() {
+
+  std::vector<Operation const *> constructed;
+
+  for (auto &deferred : deferred_gemm_operations_) {
+    if (deferred.factory) {
+      append(deferred.factory());
+      deferred.factory = nullptr;
+
+      constructed.push_back(operations_.back().get());
+    }
+  }
+
+  deferred_gemm_operations_.clear();
+  deferred_gemm_keys_.clear();
+
+  return constructed;
+}
+
 /// Returns an iterator to the first operation
 OperationVector const & Manifest::operations() const {
   return operations_;
@@ -0,0 +1,223 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Growable arena of device workspace.
+*/
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "mutlass/library/workspace_arena.h"
+
+namespace mutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Constructs an arena, allocating a buffer of the given size
+WorkspaceArena::WorkspaceArena(size_t capacity):
+  buffer_(nullptr),
+  offset_(0),
+  cleared_(0) {
+
+  reserve(capacity);
+}
+
+/// Destructor releases all buffers
+WorkspaceArena::~WorkspaceArena() {
+  release();
+}
+
+/// Move constructor
+WorkspaceArena::WorkspaceArena(WorkspaceArena &&arena):
+  buffer_(arena.buffer_),
+  offset_(arena.offset_),
+  cleared_(arena.cleared_),
+  retired_(std::move(arena.retired_)),
+  statistics_(arena.statistics_) {
+
+  arena.buffer_ = nullptr;
+  arena.offset_ = 0;
+  arena.cleared_ = 0;
+  arena.retired_.clear();
+  arena.statistics_ = WorkspaceArenaStatistics();
+}
+
+/// Move assignment operator
+WorkspaceArena &WorkspaceArena::operator=(WorkspaceArena &&arena) {
+
+  if (this != &arena) {
+    release();
+
+    buffer_ = arena.buffer_;
+    offset_ = arena.offset_;
+    cleared_ = arena.cleared_;
+    retired_ = std::move(arena.retired_);
+    statistics_ = arena.statistics_;
+
+    arena.buffer_ = nullptr;
+    arena.offset_ = 0;
+    arena.cleared_ = 0;
+    arena.retired_.clear();
+    arena.statistics_ = WorkspaceArenaStatistics();
+  }
+
+  return *this;
+}
+
+/// Ensures the buffer holds at least the given number of bytes
+void WorkspaceArena::reserve(size_t bytes) {
+  if (bytes > statistics_.capacity && !grow_(bytes)) {
+    throw std::runtime_error("Failed to allocate workspace");
+  }
+}
+
+/// Returns an aligned region of the given size, zeroing its bytes not yet cleared on a stream
+void *WorkspaceArena::allocate(size_t bytes, musaStream_t stream) {
+
+  size_t offset = (offset_ + kAlignment - 1) / kAlignment * kAlignment;
+
+  if (bytes == 0) {
+    return buffer_ ? static_cast<char *>(buffer_) + std::min(offset, statistics_.capacity) : nullptr;
+  }
+
+  size_t padded_bytes = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+
+  if (offset + bytes > statistics_.capacity) {
+
+    // Size the new buffer for everything sub-allocated since the last reset
+    if (!grow_(std::max(statistics_.in_use + padded_bytes, 2 * statistics_.capacity))) {
+      return nullptr;
+    }
+
+    offset = 0;
+  }
+
+  size_t end = offset + bytes;
+
+  if (end > cleared_) {
+    if (musaMemsetAsync(static_cast<char *>(buffer_) + cleared_, 0, end - cleared_, stream) != musaSuccess) {
+      return nullptr;
+    }
+
+    statistics_.bytes_cleared += end - cleared_;
+    cleared_ = end;
+  }
+
+  offset_ = end;
+
+  statistics_.in_use += padded_bytes;
+  statistics_.high_water_mark = std::max(statistics_.high_water_mark, statistics_.in_use);
+  ++statistics_.allocation_count;
+
+  return static_cast<char *>(buffer_) + offset;
+}
+
+/// Makes the whole buffer available to later allocations
+void WorkspaceArena::reset() {
+
+  for (void *buffer : retired_) {
+    musaFree(buffer);
+  }
+  retired_.clear();
+
+  offset_ = 0;
+  statistics_.in_use = 0;
+}
+
+/// Releases all buffers
+void WorkspaceArena::release() {
+
+  reset();
+
+  if (buffer_) {
+    musaFree(buffer_);
+  }
+
+  buffer_ = nullptr;
+  cleared_ = 0;
+  statistics_.capacity = 0;
+}
+
+/// Returns the current buffer
+void *WorkspaceArena::data() const {
+  return buffer_;
+}
+
+/// Returns the size of the current buffer in bytes
+size_t WorkspaceArena::capacity() const {
+  return statistics_.capacity;
+}
+
+/// Returns usage statistics
+WorkspaceArenaStatistics const &WorkspaceArena::statistics() const {
+  return statistics_;
+}
+
+/// Replaces the buffer by one of at least the given size
+bool WorkspaceArena::grow_(size_t bytes) {
+
+  size_t capacity = std::max(bytes, size_t(kMinimumCapacity));
+  capacity = (capacity + kAlignment - 1) / kAlignment * kAlignment;
+
+  void *buffer = nullptr;
+
+  if (musaMalloc(&buffer, capacity) != musaSuccess) {
+    return false;
+  }
+
+  if (buffer_) {
+    if (offset_) {
+      retired_.push_back(buffer_);
+    }
+    else {
+      musaFree(buffer_);
+    }
+  }
+
+  buffer_ = buffer;
+  offset_ = 0;
+  cleared_ = 0;
+
+  statistics_.capacity = capacity;
+  ++statistics_.growth_count;
+
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace mutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -126,6 +126,22 @@ SaveWorkspace from_string<SaveWorkspace>(std::string const &str);
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// State of the last-level cache at the start of each profiled iteration
+enum class CacheMode {
+  kWarm,        ///< a single copy of the operands is reused and may remain resident in L2
+  kCold,        ///< operands are evicted from L2 before each iteration
+  kInvalid
+};
+
+/// Converts a CacheMode enumerant to a string
+char const *to_string(CacheMode cache_mode, bool pretty = false);
+
+/// Parses a CacheMode enumerant from a string
+template <>
+CacheMode from_string<CacheMode>(std::string const &str);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Indicates the type of kernel argument
 // ArgumentType can be both ScalarType or NumericType. Thus, enums kScalar and kNumeric
 // 1) kScalar: e.g. of a Scalar ArgumentType is u32 is a Scalar type.
@@ -39,6 +39,7 @@
 #include <string>
 #include <memory>
 #include <algorithm>
+#include <future>
 #include <unordered_map>
 
 // MUTLASS Library includes
@@ -52,6 +53,7 @@
 #include "operation_profiler.h"
 #include "performance_result.h"
 #include "problem_space.h"
+#include "thread_pool.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -64,6 +66,12 @@ namespace profiler {
 class GemmOperationProfiler : public OperationProfiler {
 public:
 
+  /// Multiple of the L2 capacity touched between two uses of the same operands in cold mode
+  static int const kColdCacheFactor = 3;
+
+  /// Fraction of device memory the rotated copies of a problem may occupy in cold mode
+  static int const kColdCacheMemoryDivisor = 4;
+
   /// Problem structure obtained from problem space
   struct GemmProblem {
 
@@ -127,6 +135,13 @@ public:
     /// profiling to avoid camping in the last level cache.
     int problem_count;
 
+    /// Cache state in which the operation is currently profiled
+    CacheMode cache_mode;
+
+    /// Buffer overwritten before each iteration to evict the operands from L2 when a cold
+    /// cache is requested but problem_count copies of the problem do not fit in memory
+    DeviceAllocation l2_flush_buffer;
+
     library::GemmUniversalConfiguration configuration;
     library::GemmUniversalArguments arguments;
 
@@ -148,7 +163,34 @@ public:
     //
 
     GemmWorkspace(): 
-      A(nullptr), B(nullptr), C(nullptr), Computed(nullptr), Reference(nullptr), problem_count(1) { }
+      A(nullptr), B(nullptr), C(nullptr), Computed(nullptr), Reference(nullptr), problem_count(1),
+      cache_mode(CacheMode::kCold) { }
+  };
+
+  /// Result of the host reference for one problem and set of data types
+  struct HostReference {
+
+    /// Status returned by the reference operation
+    Status status;
+
+    /// Host copy of the reference output tensor
+    std::vector<uint8_t> D;
+
+    HostReference(): status(Status::kErrorNotSupported) { }
+  };
+
+  using HostReferenceFuture = std::shared_future<std::shared_ptr<HostReference const>>;
+
+  /// Host reference verification issued by verify_mutlass() and resolved after profiling
+  struct PendingVerification {
+
+    library::Provider provider;
+
+    /// Reference output, possibly still being computed
+    HostReferenceFuture reference;
+
+    /// Host copy of the output computed by MUTLASS before profiling overwrites it
+    std::vector<uint8_t> computed;
   };
 
 protected:
@@ -166,6 +208,18 @@ protected:
   /// MUTLASS parallel reduction operation to follow this* gemm operation
   library::Operation const *reduction_op_;
 
+  /// Host reference results keyed by problem and data types. Only the current problem is retained.
+  std::unordered_map<std::string, HostReferenceFuture> host_reference_cache_;
+
+  /// Problem to which the cached host references belong
+  std::string host_reference_problem_;
+
+  /// Host reference verifications awaiting resolution
+  std::vector<PendingVerification> pending_verifications_;
+
+  /// Threads computing host references, created on first use
+  std::unique_ptr<ThreadPool> host_reference_pool_;
+
 public:
   //
   // Methods
@@ -221,6 +275,15 @@ public:
     ProblemSpace const &problem_space,
     ProblemSpace::Problem const &problem);
 
+  /// Compares MUTLASS against host references computed while profiling
+  virtual bool resolve_verification(
+    Options const &options,
+    PerformanceReport &report,
+    DeviceContext &device_context,
+    library::Operation const *operation,
+    ProblemSpace const &problem_space,
+    ProblemSpace::Problem const &problem);
+
 protected:
 
   /// Initializes the performance result
@@ -248,15 +311,35 @@ protected:
     ProblemSpace const &problem_space,
     ProblemSpace::Problem const &problem);
 
+  /// Returns the host reference for the current problem, launching it if it is not cached
+  HostReferenceFuture host_reference_(
+    Options const &options,
+    library::GemmDescription const &gemm_desc);
+
+  /// Updates the disposition of a result from the outcomes of its verification providers
+  void update_disposition_(PerformanceResult &result) const;
+
+  /// Returns true if any of the requested verification providers ran for a result
+  bool is_any_verification_run_(Options const &options, PerformanceResult &result) const;
+
   /// Method to profile a MUTLASS Operation
   Status profile_mutlass_(
     double &runtime,
+    TimingStatistics &runtime_statistics,
     Options const &options,
     library::Operation const *operation,
     void *arguments,
     void *host_workspace,
     void *device_workspace);
 
+  /// Measures the runtime of a MUTLASS Operation replayed from a graph of captured launches
+  Status profile_mutlass_graph_(
+    double &graph_runtime,
+    Options const &options,
+    library::Operation const *operation,
+    void *host_workspace,
+    void *device_workspace);
+
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <musa_runtime.h>
 #include "mutlass/mutlass.h"
 
@@ -47,6 +49,13 @@ struct GpuTimer {
 
   musaEvent_t events[2];
 
+  /// Start and stop events of each timed iteration, stored as consecutive pairs. Events are
+  /// created on demand and reused across calls to reset_iterations().
+  std::vector<musaEvent_t> iteration_events;
+
+  /// Number of iterations recorded since the last reset
+  int iteration_count;
+
   //
   // Methods
   //
@@ -65,6 +74,21 @@ struct GpuTimer {
 
   /// Returns the duration in milliseconds
   double duration(int iterations = 1) const;
+
+  /// Discards all recorded iterations
+  void reset_iterations();
+
+  /// Records the start event of the next iteration in the stream
+  void start_iteration(musaStream_t stream = nullptr);
+
+  /// Records the stop event of the current iteration in the stream
+  void stop_iteration(musaStream_t stream = nullptr);
+
+  /// Waits until the stop event of the most recent iteration has completed
+  void synchronize_iterations() const;
+
+  /// Returns the duration in milliseconds of each recorded iteration starting at 'first'
+  std::vector<double> iteration_durations(int first = 0) const;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -38,6 +38,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
 #include <unordered_map>
 
 // MUTLASS includes
@@ -54,6 +55,7 @@
 #include "performance_result.h"
 #include "performance_report.h"
 #include "problem_space.h"
+#include "timing_statistics.h"
 #include "debug.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -67,6 +69,8 @@ namespace profiler {
 class OperationProfiler {
 public:
 
+  /// Number of iterations between convergence checks in adaptive profiling mode
+  static int const kAdaptiveCheckInterval = 32;
 
 protected:
   //
@@ -180,6 +184,16 @@ public:
     ProblemSpace const &problem_space,
     ProblemSpace::Problem const &problem) = 0;
 
+  /// Completes verification deferred by verify_mutlass() so that it overlaps with profiling.
+  /// Called once results have been measured and before they are reported.
+  virtual bool resolve_verification(
+    Options const &options,
+    PerformanceReport &report,
+    DeviceContext &device_context,
+    library::Operation const *operation,
+    ProblemSpace const &problem_space,
+    ProblemSpace::Problem const &problem);
+
 public:
 
   //
@@ -231,9 +245,25 @@ protected:
     library::OperationDescription const &operation_desc,
     ProblemSpace const &problem_space);
 
+  /// Runs the timed profiling loop shared by the operation profilers. Each iteration calls
+  /// prepare(iteration), outside of the per-iteration timing, and then run(), timed individually
+  /// if timed_iterations is set. In adaptive mode the loop stops once the median has converged.
+  ///
+  /// runtime is the mean of the per-iteration runtimes if per_iteration_runtime is set and the
+  /// duration of the whole loop divided by the number of iterations otherwise.
+  static Status profile_iterations_(
+    double &runtime,
+    TimingStatistics &runtime_statistics,
+    Options const &options,
+    std::function<Status(int)> const &prepare,
+    std::function<Status()> const &run,
+    bool timed_iterations,
+    bool per_iteration_runtime);
+
   /// Method to profile an initialized MUTLASS operation
   virtual Status profile_mutlass_(
     double &runtime,
+    TimingStatistics &runtime_statistics,
     Options const &options,
     library::Operation const *operation,
     void *arguments,
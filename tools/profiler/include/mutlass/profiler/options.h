@@ -167,6 +167,10 @@ public:
     /// Indicates when to save the workspace
     SaveWorkspace save_workspace;
 
+    /// Number of host threads computing host reference results concurrently with profiling.
+    /// Zero computes them synchronously.
+    int host_reference_threads;
+
     //
     // Methods
     //
@@ -189,6 +193,9 @@ public:
     /// Number of workspaces to rotate through to avoid cache-resident working sets
     int workspace_count;
 
+    /// Cache states in which each kernel is profiled. Each yields a separate result.
+    std::vector<CacheMode> cache_modes;
+
     /// Number of iterations to warmup each kernel prior to profiling
     int warmup_iterations;
 
@@ -198,6 +205,27 @@ public:
     /// Number of ms to sleep between profiling periods (ms)
     int sleep_duration;
 
+    /// If true, each iteration is bracketed by its own pair of events to report the
+    /// distribution of runtimes
+    bool timing_statistics;
+
+    /// If true, profiling stops once the confidence interval of the median runtime is
+    /// within adaptive_target rather than after a fixed number of iterations
+    bool adaptive;
+
+    /// Target half-width of the 95% confidence interval of the median, relative to the median
+    double adaptive_target;
+
+    /// Upper bound on the number of iterations profiled in adaptive mode
+    int adaptive_max_iterations;
+
+    /// If true, kernels are additionally timed by replaying a graph of captured launches,
+    /// which excludes the host launch overhead
+    bool graph_replay;
+
+    /// Number of launches captured into each graph when graph_replay is set
+    int graph_iterations;
+
     /// If true, profiling is actually conducted.
     bool enabled;
 
@@ -221,6 +249,9 @@ public:
 
     /// Returns the index of a provider if its enabled
     size_t index(library::Provider provider) const;
+
+    /// Returns true if kernels are profiled in the given cache state
+    bool cache_mode_enabled(CacheMode cache_mode) const;
   };
   
   /// Options related to reporting
@@ -235,6 +266,15 @@ public:
     /// Path to a file containing junit xml results
     std::string junit_output_path;
 
+    /// Path to a file containing JSON-lines results
+    std::string json_output_path;
+
+    /// Path to a JSON-lines report from a previous run to compare results against
+    std::string baseline_path;
+
+    /// Relative runtime increase or GFLOP/s decrease at which a result is flagged as regressed
+    double regression_threshold;
+
     /// Sequence of tags to attach to each result
     std::vector<std::pair<std::string, std::string>> pivot_tags;
 
@@ -0,0 +1,133 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Loads a previous JSON-lines performance report and compares results against it
+*/
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace mutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Performance of one (operation, problem) pair recorded in a baseline report
+struct BaselineResult {
+
+  /// Average runtime in ms
+  double runtime;
+
+  /// Math throughput in units of GFLOP/s
+  double gflops_per_sec;
+
+  BaselineResult(): runtime(0), gflops_per_sec(0) { }
+};
+
+/// Comparison of a result against its baseline
+struct BaselineComparison {
+
+  /// Relative change in runtime (positive is slower)
+  double runtime_change;
+
+  /// Relative change in math throughput (negative is slower)
+  double gflops_change;
+
+  /// True if either quantity regressed by more than the threshold
+  bool regressed;
+
+  BaselineComparison(): runtime_change(0), gflops_change(0), regressed(false) { }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Set of results from a previous JSON-lines report keyed by (provider, operation, problem).
+/// The cache mode of a result is treated as one of its problem arguments.
+class PerformanceBaseline {
+public:
+
+  using ArgumentVector = std::vector<std::pair<std::string, std::string>>;
+
+private:
+
+  /// Results indexed by key
+  std::unordered_map<std::string, BaselineResult> results_;
+
+public:
+
+  /// Builds the key joining a result to its baseline. Arguments are ordered by name so that
+  /// reports produced by different builds of the profiler may be compared.
+  static std::string make_key(
+    std::string const &provider,
+    std::string const &operation_name,
+    ArgumentVector const &arguments);
+
+  /// Compares a result against its baseline
+  static BaselineComparison compare(
+    BaselineResult const &baseline,
+    double runtime,
+    double gflops_per_sec,
+    double threshold);
+
+  /// Loads results from a JSON-lines report. If operation_kind is not empty, results of other
+  /// operation kinds are skipped. Returns false if the stream is malformed.
+  bool load(std::istream &in, std::string const &operation_kind = "");
+
+  /// Loads results from a JSON-lines report file. Returns false if it could not be read.
+  bool load(std::string const &path, std::string const &operation_kind = "");
+
+  /// Number of results in the baseline
+  size_t size() const { return results_.size(); }
+
+  /// Returns the baseline result for a key or nullptr if none exists
+  BaselineResult const *find(std::string const &key) const;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Escapes a string for inclusion in a JSON document
+std::string escape_json_string(std::string const &str);
+
+/// Formats a number for inclusion in a JSON document. JSON has no representation of infinities
+/// and NaNs, so they are written as null.
+std::string json_number(double value);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +42,7 @@
 #include "options.h"
 #include "enumerated_types.h"
 #include "performance_result.h"
+#include "performance_baseline.h"
 
 // MUTLASS Library includes
 #include "mutlass/library/library.h"
@@ -72,6 +73,24 @@ private:
   /// Output file containing junit results
   std::ofstream junit_output_file_;
 
+  /// Operation file name containing JSON-lines performance report of op_kind
+  std::string op_json_file_name_;
+
+  /// Output file containing JSON-lines results
+  std::ofstream json_output_file_;
+
+  /// Results of a previous run to compare against
+  PerformanceBaseline baseline_;
+
+  /// Number of results looked up in the baseline
+  size_t baseline_compared_count_;
+
+  /// Number of results joined to a baseline result
+  size_t baseline_match_count_;
+
+  /// Descriptions of results which regressed with respect to the baseline
+  std::vector<std::string> regressions_;
+
   /// Flag indicating the performance report is valid
   bool good_;
 
@@ -96,6 +115,15 @@ public:
   void sort_results(PerformanceResultVector &results);
   void append_results(PerformanceResultVector const &results);
 
+  /// Number of results which regressed with respect to the baseline
+  size_t regression_count() const { return regressions_.size(); }
+
+  /// True if results were compared against a baseline holding results of this operation kind
+  /// but none of them joined to it, in which case the baseline cannot have caught a regression
+  bool baseline_unmatched() const {
+    return baseline_.size() && baseline_compared_count_ && !baseline_match_count_;
+  }
+
 public:
 
   /// Prints the CSV header
@@ -104,6 +132,12 @@ public:
   /// Prints the CSV
   std::ostream & print_result_csv_(std::ostream &out, PerformanceResult const &result);
 
+  /// Prints the result as a single-line JSON object
+  std::ostream & print_result_json_(std::ostream &out, PerformanceResult const &result);
+
+  /// Compares the result against the baseline and records any regression
+  void compare_with_baseline_(PerformanceResult const &result);
+
   /// @defgroup jUnit Result Generation
   /// Functions related to generation of the jUnit results
   /// @{
@@ -41,6 +41,7 @@
 
 // MUTLASS Profiler includes
 #include "enumerated_types.h"
+#include "timing_statistics.h"
 
 // MUTLASS Library includes
 #include "mutlass/library/library.h"
@@ -75,6 +76,9 @@ struct PerformanceResult {
   /// Operation name
   std::string operation_name;
 
+  /// State of the last-level cache in which the operation was profiled
+  CacheMode cache_mode;
+
   /// Stringified vector of argument values
   std::vector<std::pair<std::string, std::string> > arguments;
 
@@ -87,6 +91,12 @@ struct PerformanceResult {
   /// Average runtime in ms
   double runtime;
 
+  /// Distribution of per-iteration runtimes
+  TimingStatistics runtime_statistics;
+
+  /// Average runtime in ms of one launch replayed from a graph. Zero if not measured.
+  double graph_runtime;
+
   //
   // Members
   //
@@ -98,9 +108,11 @@ struct PerformanceResult {
     provider(library::Provider::kInvalid), 
     disposition(Disposition::kNotRun),
     status(Status::kInvalid),
+    cache_mode(CacheMode::kWarm),
     bytes(0), 
     flops(0), 
-    runtime(0)
+    runtime(0),
+    graph_runtime(0)
   { }
 
   /// Returns true if the runtime is valid
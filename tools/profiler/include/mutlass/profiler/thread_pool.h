@@ -0,0 +1,120 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Fixed-size pool of host threads used to run work concurrently with device profiling
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Runs host tasks on a fixed number of worker threads in the order they were enqueued.
+///
+/// A pool without threads runs each task on the calling thread when it is enqueued.
+class ThreadPool {
+public:
+
+  using Task = std::function<void()>;
+
+private:
+
+  /// Worker threads
+  std::vector<std::thread> workers_;
+
+  /// Tasks not yet started
+  std::deque<Task> tasks_;
+
+  /// Guards tasks_ and stopping_
+  std::mutex mutex_;
+
+  /// Signals workers that a task is available or that the pool is stopping
+  std::condition_variable condition_;
+
+  /// Set when the pool is destroyed
+  bool stopping_;
+
+public:
+
+  /// Starts the given number of worker threads
+  explicit ThreadPool(int thread_count);
+
+  /// Completes all enqueued tasks and joins the worker threads
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+
+  /// Number of worker threads
+  int thread_count() const;
+
+  /// Enqueues a task
+  void enqueue(Task task);
+
+  /// Enqueues a callable and returns a future holding its result or exception
+  template <typename Function>
+  std::future<typename std::invoke_result<Function>::type> submit(Function function) {
+
+    using Result = typename std::invoke_result<Function>::type;
+
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+    std::future<Result> result = task->get_future();
+
+    enqueue([task]() { (*task)(); });
+
+    return result;
+  }
+
+private:
+
+  /// Body of each worker thread
+  void worker_();
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,105 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Host-side statistics over per-iteration kernel runtimes
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace mutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Summary of a distribution of per-iteration runtimes (all durations in ms)
+struct TimingStatistics {
+
+  /// Number of samples summarized
+  int64_t iterations;
+
+  /// Arithmetic mean
+  double mean;
+
+  /// Fastest iteration
+  double min;
+
+  /// Slowest iteration
+  double max;
+
+  /// Percentiles
+  double p50;
+  double p90;
+  double p99;
+
+  /// Sample standard deviation
+  double stddev;
+
+  //
+  // Methods
+  //
+
+  TimingStatistics():
+    iterations(0), mean(0), min(0), max(0), p50(0), p90(0), p99(0), stddev(0) { }
+
+  /// Returns true if at least one sample was summarized
+  bool good() const {
+    return iterations > 0;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes summary statistics over a set of samples
+TimingStatistics compute_timing_statistics(std::vector<double> samples);
+
+/// Returns the p-th percentile (0 <= p <= 100) of an ascending sequence, interpolating linearly
+/// between the two closest ranks
+double percentile(std::vector<double> const &sorted_samples, double p);
+
+/// Returns the half-width of the distribution-free confidence interval of the median, relative
+/// to the median. The bounds are the order statistics at ranks n/2 -/+ z * sqrt(n) / 2.
+///
+/// Returns a negative value if there are too few samples to bound the median.
+double median_confidence_interval(std::vector<double> samples, double z = 1.96);
+
+/// Returns true if the relative confidence interval of the median is within the given target
+bool median_confidence_satisfied(std::vector<double> const &samples, double target, double z = 1.96);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -222,6 +222,49 @@ SaveWorkspace from_string<SaveWorkspace>(std::string const &str) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+static struct {
+  char const *text;
+  char const *pretty;
+  CacheMode enumerant;
+}
+CacheMode_enumerants[] = {
+  {"warm", "Warm", CacheMode::kWarm},
+  {"cold", "Cold", CacheMode::kCold}
+};
+
+/// Converts a CacheMode enumerant to a string
+char const *to_string(CacheMode cache_mode, bool pretty) {
+
+  for (auto const & possible : CacheMode_enumerants) {
+    if (cache_mode == possible.enumerant) {
+      if (pretty) {
+        return possible.pretty;
+      }
+      else {
+        return possible.text;
+      }
+    }
+  }
+  
+  return pretty ? "Invalid" : "invalid";
+}
+
+/// Parses a CacheMode enumerant from a string
+template <>
+CacheMode from_string<CacheMode>(std::string const &str) {
+
+  for (auto const & possible : CacheMode_enumerants) {
+    if ((str.compare(possible.text) == 0) ||
+        (str.compare(possible.pretty) == 0)) {
+      return possible.enumerant;
+    }
+  }
+
+  return CacheMode::kInvalid;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 static struct {
   char const *text;
   char const *pretty;
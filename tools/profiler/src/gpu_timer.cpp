@@ -42,7 +42,7 @@ namespace profiler {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
-GpuTimer::GpuTimer() {
+GpuTimer::GpuTimer(): iteration_count(0) {
   musaError_t result;
 
   for (auto & event : events) {
@@ -57,6 +57,10 @@ GpuTimer::~GpuTimer() {
   for (auto & event : events) {
     musaEventDestroy(event);
   }
+
+  for (auto & event : iteration_events) {
+    musaEventDestroy(event);
+  }
 }
 
 /// Records a start event in the stream
@@ -108,6 +112,74 @@ double GpuTimer::duration(int iterations) const {
   return double(avg_ms) / double(iterations);
 }
 
+/// Discards all recorded iterations
+void GpuTimer::reset_iterations() {
+  iteration_count = 0;
+}
+
+/// Records the start event of the next iteration in the stream
+void GpuTimer::start_iteration(musaStream_t stream) {
+
+  size_t required = size_t(iteration_count + 1) * 2;
+
+  while (iteration_events.size() < required) {
+    musaEvent_t event;
+    if (musaEventCreate(&event) != musaSuccess) {
+      throw std::runtime_error("Failed to create MUSA event");
+    }
+    iteration_events.push_back(event);
+  }
+
+  musaError_t result = musaEventRecord(iteration_events[iteration_count * 2], stream);
+  if (result != musaSuccess) {
+    throw std::runtime_error("Failed to record iteration start event.");
+  }
+}
+
+/// Records the stop event of the current iteration in the stream
+void GpuTimer::stop_iteration(musaStream_t stream) {
+
+  musaError_t result = musaEventRecord(iteration_events[iteration_count * 2 + 1], stream);
+  if (result != musaSuccess) {
+    throw std::runtime_error("Failed to record iteration stop event.");
+  }
+
+  ++iteration_count;
+}
+
+/// Waits until the stop event of the most recent iteration has completed
+void GpuTimer::synchronize_iterations() const {
+
+  if (!iteration_count) {
+    return;
+  }
+
+  musaError_t result = musaEventSynchronize(iteration_events[iteration_count * 2 - 1]);
+  if (result != musaSuccess) {
+    throw std::runtime_error("Failed to synchronize with iteration stop event.");
+  }
+}
+
+/// Returns the duration in milliseconds of each recorded iteration starting at 'first'
+std::vector<double> GpuTimer::iteration_durations(int first) const {
+
+  std::vector<double> durations;
+
+  for (int idx = first; idx < iteration_count; ++idx) {
+
+    float ms;
+
+    musaError_t result = musaEventElapsedTime(&ms, iteration_events[idx * 2], iteration_events[idx * 2 + 1]);
+    if (result != musaSuccess) {
+      throw std::runtime_error("Failed to query elapsed time from MUSA events.");
+    }
+
+    durations.push_back(double(ms));
+  }
+
+  return durations;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 } // namespace profiler
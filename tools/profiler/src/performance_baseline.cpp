@@ -0,0 +1,399 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Loads a previous JSON-lines performance report and compares results against it
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "mutlass/profiler/performance_baseline.h"
+
+namespace mutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Minimal parser for the flat JSON objects written by PerformanceReport
+class JsonLineParser {
+private:
+
+  std::string const &text_;
+  size_t pos_;
+
+public:
+
+  explicit JsonLineParser(std::string const &text): text_(text), pos_(0) { }
+
+  void skip_whitespace() {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+  }
+
+  bool consume(char ch) {
+    skip_whitespace();
+    if (pos_ < text_.size() && text_[pos_] == ch) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  bool peek(char ch) {
+    skip_whitespace();
+    return pos_ < text_.size() && text_[pos_] == ch;
+  }
+
+  bool at_end() {
+    skip_whitespace();
+    return pos_ == text_.size();
+  }
+
+  bool parse_string(std::string &str) {
+    if (!consume('"')) {
+      return false;
+    }
+
+    str.clear();
+
+    while (pos_ < text_.size()) {
+      char ch = text_[pos_++];
+
+      if (ch == '"') {
+        return true;
+      }
+
+      if (ch == '\\') {
+        if (pos_ >= text_.size()) {
+          return false;
+        }
+
+        char esc = text_[pos_++];
+        switch (esc) {
+        case 'n': str.push_back('\n'); break;
+        case 't': str.push_back('\t'); break;
+        case 'r': str.push_back('\r'); break;
+        case 'b': str.push_back('\b'); break;
+        case 'f': str.push_back('\f'); break;
+        case 'u':
+          // Only the control characters emitted by escape_json_string() are expected
+          if (pos_ + 4 > text_.size()) {
+            return false;
+          }
+          str.push_back(char(std::strtol(text_.substr(pos_, 4).c_str(), nullptr, 16)));
+          pos_ += 4;
+          break;
+        default: str.push_back(esc); break;
+        }
+      }
+      else {
+        str.push_back(ch);
+      }
+    }
+
+    return false;
+  }
+
+  /// Parses a scalar (string, number, boolean or null) as text
+  bool parse_scalar(std::string &str) {
+    if (peek('"')) {
+      return parse_string(str);
+    }
+
+    size_t start = pos_;
+    while (pos_ < text_.size() && text_[pos_] != ',' && text_[pos_] != '}' && text_[pos_] != ']' &&
+      !std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+
+    str = text_.substr(start, pos_ - start);
+    return !str.empty();
+  }
+
+  /// Skips over any value
+  bool skip_value() {
+    if (peek('{') || peek('[')) {
+      char close = (text_[pos_] == '{' ? '}' : ']');
+      bool is_object = (close == '}');
+      ++pos_;
+
+      if (consume(close)) {
+        return true;
+      }
+
+      do {
+        if (is_object) {
+          std::string key;
+          if (!parse_string(key) || !consume(':')) {
+            return false;
+          }
+        }
+        if (!skip_value()) {
+          return false;
+        }
+      } while (consume(','));
+
+      return consume(close);
+    }
+
+    std::string ignored;
+    return parse_scalar(ignored);
+  }
+
+  /// Parses an object whose values are all scalars
+  bool parse_scalar_object(PerformanceBaseline::ArgumentVector &members) {
+    if (!consume('{')) {
+      return false;
+    }
+
+    if (consume('}')) {
+      return true;
+    }
+
+    do {
+      std::string key, value;
+      if (!parse_string(key) || !consume(':') || !parse_scalar(value)) {
+        return false;
+      }
+      members.emplace_back(key, value);
+    } while (consume(','));
+
+    return consume('}');
+  }
+};
+
+} // namespace anonymous
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Builds the key joining a result to its baseline
+std::string PerformanceBaseline::make_key(
+  std::string const &provider,
+  std::string const &operation_name,
+  ArgumentVector const &arguments) {
+
+  ArgumentVector sorted_arguments(arguments);
+  std::sort(sorted_arguments.begin(), sorted_arguments.end());
+
+  std::stringstream ss;
+
+  ss << provider << "|" << operation_name;
+
+  for (auto const &arg : sorted_arguments) {
+    ss << "|" << arg.first << "=" << arg.second;
+  }
+
+  return ss.str();
+}
+
+/// Compares a result against its baseline
+BaselineComparison PerformanceBaseline::compare(
+  BaselineResult const &baseline,
+  double runtime,
+  double gflops_per_sec,
+  double threshold) {
+
+  BaselineComparison comparison;
+
+  if (baseline.runtime > 0 && runtime > 0) {
+    comparison.runtime_change = runtime / baseline.runtime - 1.0;
+    comparison.regressed |= (comparison.runtime_change > threshold);
+  }
+
+  if (baseline.gflops_per_sec > 0) {
+    comparison.gflops_change = gflops_per_sec / baseline.gflops_per_sec - 1.0;
+    comparison.regressed |= (-comparison.gflops_change > threshold);
+  }
+
+  return comparison;
+}
+
+/// Loads results from a JSON-lines report
+bool PerformanceBaseline::load(std::istream &in, std::string const &operation_kind) {
+
+  std::string line;
+
+  while (std::getline(in, line)) {
+
+    JsonLineParser parser(line);
+
+    if (parser.at_end()) {
+      continue;
+    }
+
+    if (!parser.consume('{')) {
+      return false;
+    }
+
+    std::string provider;
+    std::string operation_name;
+    std::string result_operation_kind;
+    ArgumentVector arguments;
+    BaselineResult result;
+
+    // Reports written before the cache mode was recorded were measured cold
+    std::string cache_mode = "cold";
+
+    if (!parser.consume('}')) {
+      do {
+        std::string key;
+        if (!parser.parse_string(key) || !parser.consume(':')) {
+          return false;
+        }
+
+        bool ok = true;
+        std::string value;
+
+        if (key == "provider") {
+          ok = parser.parse_string(provider);
+        }
+        else if (key == "operation") {
+          ok = parser.parse_string(operation_name);
+        }
+        else if (key == "operation_kind") {
+          ok = parser.parse_string(result_operation_kind);
+        }
+        else if (key == "arguments") {
+          ok = parser.parse_scalar_object(arguments);
+        }
+        else if (key == "cache_mode") {
+          ok = parser.parse_string(cache_mode);
+        }
+        else if (key == "runtime") {
+          ok = parser.parse_scalar(value);
+          result.runtime = std::atof(value.c_str());
+        }
+        else if (key == "gflops_per_sec") {
+          ok = parser.parse_scalar(value);
+          result.gflops_per_sec = std::atof(value.c_str());
+        }
+        else {
+          ok = parser.skip_value();
+        }
+
+        if (!ok) {
+          return false;
+        }
+      } while (parser.consume(','));
+
+      if (!parser.consume('}')) {
+        return false;
+      }
+    }
+
+    bool kind_matches = operation_kind.empty() || result_operation_kind.empty() ||
+      result_operation_kind == operation_kind;
+
+    if (!operation_name.empty() && kind_matches) {
+      arguments.emplace_back("cache_mode", cache_mode);
+      results_[make_key(provider, operation_name, arguments)] = result;
+    }
+  }
+
+  return true;
+}
+
+/// Loads results from a JSON-lines report file
+bool PerformanceBaseline::load(std::string const &path, std::string const &operation_kind) {
+
+  std::ifstream in(path);
+
+  if (!in.good()) {
+    return false;
+  }
+
+  return load(in, operation_kind);
+}
+
+/// Returns the baseline result for a key or nullptr if none exists
+BaselineResult const *PerformanceBaseline::find(std::string const &key) const {
+  auto it = results_.find(key);
+  return it == results_.end() ? nullptr : &it->second;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Escapes a string for inclusion in a JSON document
+std::string escape_json_string(std::string const &str) {
+
+  std::stringstream ss;
+
+  for (char ch : str) {
+    switch (ch) {
+    case '"': ss << "\\\""; break;
+    case '\\': ss << "\\\\"; break;
+    case '\n': ss << "\\n"; break;
+    case '\t': ss << "\\t"; break;
+    case '\r': ss << "\\r"; break;
+    default:
+      if (static_cast<unsigned char>(ch) < 0x20) {
+        char buffer[8];
+        std::snprintf(buffer, sizeof(buffer), "\\u%04x", int(ch));
+        ss << buffer;
+      }
+      else {
+        ss << ch;
+      }
+      break;
+    }
+  }
+
+  return ss.str();
+}
+
+/// Formats a number for inclusion in a JSON document
+std::string json_number(double value) {
+
+  if (!std::isfinite(value)) {
+    return "null";
+  }
+
+  std::stringstream ss;
+  ss << value;
+  return ss.str();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -73,7 +73,8 @@ PerformanceReport::PerformanceReport(
   std::vector<std::string> const &argument_names,
   library::OperationKind const &op_kind
 ):
-  options_(options), argument_names_(argument_names), problem_index_(0), good_(true), op_kind_(op_kind) {
+  options_(options), argument_names_(argument_names), problem_index_(0), good_(true), op_kind_(op_kind),
+  baseline_compared_count_(0), baseline_match_count_(0) {
 
   // Strip '.csv' if present
   std::string base_path = options_.report.output_path;
@@ -85,6 +86,10 @@ PerformanceReport::PerformanceReport(
   base_path = base_path.substr(0, base_path.rfind(".junit"));
   op_junit_file_name_ = base_path + "." + to_string(op_kind_) + ".junit.xml";
 
+  base_path = options_.report.json_output_path;
+  base_path = base_path.substr(0, base_path.rfind(".jsonl"));
+  op_json_file_name_ = base_path + "." + to_string(op_kind_) + ".jsonl";
+
   //
   // Open output file for operation of PerformanceReport::op_kind
   //
@@ -134,6 +139,31 @@ PerformanceReport::PerformanceReport(
 
     print_junit_header_(junit_output_file_);
   }
+
+  if (!options_.report.json_output_path.empty()) {
+
+    json_output_file_.open(op_json_file_name_, options_.report.append ? std::ios::app : std::ios::out);
+
+    if (!json_output_file_.good()) {
+
+      std::cerr << "Could not open JSON output file at path '"
+         << options_.report.json_output_path << "'" << std::endl;
+
+      good_ = false;
+    }
+  }
+
+  if (!options_.report.baseline_path.empty()) {
+
+    // A report compares only the baseline results of its own operation kind
+    if (!baseline_.load(options_.report.baseline_path, library::to_string(op_kind_))) {
+
+      std::cerr << "Could not read baseline report at path '"
+         << options_.report.baseline_path << "'" << std::endl;
+
+      good_ = false;
+    }
+  }
 }
 
 void PerformanceReport::next_problem() {
@@ -153,12 +183,68 @@ void PerformanceReport::append_result(PerformanceResult result) {
     print_junit_result_(junit_output_file_, result);
   }
 
+  if (json_output_file_.is_open()) {
+    print_result_json_(json_output_file_, result) << std::endl;
+  }
+
   if (output_file_.is_open()) {
     print_result_csv_(output_file_, result) << std::endl;
   }
   else {
     concatenated_results_.push_back(result);
   }
+
+  if (baseline_.size()) {
+    compare_with_baseline_(result);
+  }
+}
+
+void PerformanceReport::compare_with_baseline_(PerformanceResult const &result) {
+
+  if (!result.good()) {
+    return;
+  }
+
+  ++baseline_compared_count_;
+
+  // Results profiled with a warm and a cold cache are distinct entries of the baseline
+  PerformanceBaseline::ArgumentVector key_arguments(result.arguments);
+  key_arguments.emplace_back("cache_mode", to_string(result.cache_mode));
+
+  BaselineResult const *baseline = baseline_.find(
+    PerformanceBaseline::make_key(library::to_string(result.provider), result.operation_name, key_arguments));
+
+  if (!baseline) {
+    return;
+  }
+
+  ++baseline_match_count_;
+
+  BaselineComparison comparison = PerformanceBaseline::compare(
+    *baseline,
+    result.runtime,
+    result.gflops_per_sec(),
+    options_.report.regression_threshold);
+
+  if (options_.report.verbose) {
+    std::cout
+      << "        Baseline: " << baseline->runtime << "  ms, " << baseline->gflops_per_sec << " GFLOP/s ("
+      << std::showpos << comparison.runtime_change * 100.0 << "% runtime, "
+      << comparison.gflops_change * 100.0 << "% GFLOP/s" << std::noshowpos << ")"
+      << (comparison.regressed ? "  " SHELL_COLOR_RED() "REGRESSED" SHELL_COLOR_END() : "") << "\n";
+  }
+
+  if (comparison.regressed) {
+
+    std::stringstream ss;
+
+    ss << "Problem " << result.problem_index << " " << library::to_string(result.provider)
+      << " " << result.operation_name << " (" << to_string(result.cache_mode) << " cache): " << result.runtime << " ms vs " << baseline->runtime
+      << " ms (" << std::showpos << comparison.runtime_change * 100.0 << "% runtime, "
+      << comparison.gflops_change * 100.0 << "% GFLOP/s)";
+
+    regressions_.push_back(ss.str());
+  }
 }
 
 void PerformanceReport::sort_results(PerformanceResultVector &results) {
@@ -223,6 +309,29 @@ PerformanceReport::~PerformanceReport() {
     junit_output_file_.close();
     std::cout << "\nWrote jUnit results to '" << op_junit_file_name_ << "'" << std::endl;
   }
+
+  if (json_output_file_.is_open()) {
+    json_output_file_.close();
+    std::cout << "\nWrote JSON results to '" << op_json_file_name_ << "'" << std::endl;
+  }
+
+  if (baseline_.size()) {
+
+    std::cout << "\nCompared " << baseline_match_count_ << " results against baseline '"
+      << options_.report.baseline_path << "' with threshold "
+      << options_.report.regression_threshold * 100.0 << "%: "
+      << regressions_.size() << " regressed" << std::endl;
+
+    for (auto const &regression : regressions_) {
+      std::cout << "  " << regression << std::endl;
+    }
+
+    if (baseline_unmatched()) {
+      std::cout << SHELL_COLOR_RED() << "Error: none of the " << baseline_compared_count_
+        << " results matched an entry of the baseline, so no regression could be detected."
+        << SHELL_COLOR_END() << std::endl;
+    }
+  }
 }
 
 static const char *disposition_status_color(Disposition disposition) {
@@ -269,6 +378,7 @@ std::ostream & PerformanceReport::print_result_pretty_(
     << "   OperationKind: " << shell_color_bright << library::to_string(result.op_kind) << shell_color_end << "\n"
     << "       Operation: " << result.operation_name << "\n\n"
     << "          Status: " << shell_color_bright << library::to_string(result.status, true) << shell_color_end << "\n"
+    << "      Cache mode: " << to_string(result.cache_mode, true) << "\n"
     << "    Verification: " << shell_color_bright << (options_.verification.enabled ? "ON":"OFF") << shell_color_end << "\n"
     << "     Disposition: " << _disposition_status_color(result.disposition) << to_string(result.disposition, true) << shell_color_end << "\n\n";
 
@@ -310,6 +420,24 @@ std::ostream & PerformanceReport::print_result_pretty_(
       << "          Memory: " << result.gbytes_per_sec() << " GiB/s\n"
       << "\n            Math: " << result.gflops_per_sec() << " GFLOP/s\n";
 
+    if (result.runtime_statistics.good()) {
+
+      TimingStatistics const &stats = result.runtime_statistics;
+
+      out
+        << "\n      Iterations: " << stats.iterations << "\n"
+        << "     Runtime min: " << stats.min << "  ms\n"
+        << "     Runtime p50: " << stats.p50 << "  ms\n"
+        << "     Runtime p90: " << stats.p90 << "  ms\n"
+        << "     Runtime p99: " << stats.p99 << "  ms\n"
+        << "  Runtime stddev: " << stats.stddev << "  ms\n";
+    }
+
+    if (result.graph_runtime > 0) {
+      out
+        << "\n Runtime (graph): " << result.graph_runtime << "  ms\n"
+        << " Launch overhead: " << (result.runtime - result.graph_runtime) << "  ms\n";
+    }
   }
 
   return out;
@@ -341,6 +469,14 @@ std::ostream & PerformanceReport::print_csv_header_(
     << ",Runtime"
     << ",GB/s"
     << ",GFLOPs"
+    << ",Iterations"
+    << ",Runtime_min"
+    << ",Runtime_p50"
+    << ",Runtime_p90"
+    << ",Runtime_p99"
+    << ",Runtime_stddev"
+    << ",Runtime_graph"
+    << ",CacheMode"
     ;
 
   return out;
@@ -391,6 +527,100 @@ std::ostream & PerformanceReport::print_result_csv_(
     ); 
   }
 
+  if (result.runtime_statistics.good()) {
+
+    TimingStatistics const &stats = result.runtime_statistics;
+
+    out
+      << "," << stats.iterations
+      << "," << stats.min
+      << "," << stats.p50
+      << "," << stats.p90
+      << "," << stats.p99
+      << "," << stats.stddev
+      ;
+  }
+  else {
+    out << std::string(6, ',');
+  }
+
+  out << ",";
+  if (result.graph_runtime > 0) {
+    out << result.graph_runtime;
+  }
+
+  out << "," << to_string(result.cache_mode);
+
+  return out;
+}
+
+/// Prints the result as a single-line JSON object
+std::ostream & PerformanceReport::print_result_json_(
+  std::ostream &out, 
+  PerformanceResult const &result) {
+
+  out << "{";
+
+  if (!options_.report.pivot_tags.empty()) {
+
+    out << "\"tags\":{";
+
+    int column_idx = 0;
+    for (auto const & tag : options_.report.pivot_tags) {
+      out << (column_idx++ ? "," : "")
+        << "\"" << escape_json_string(tag.first) << "\":\"" << escape_json_string(tag.second) << "\"";
+    }
+
+    out << "},";
+  }
+
+  out
+    << "\"problem\":" << result.problem_index
+    << ",\"provider\":\"" << library::to_string(result.provider) << "\""
+    << ",\"operation_kind\":\"" << library::to_string(result.op_kind) << "\""
+    << ",\"operation\":\"" << escape_json_string(result.operation_name) << "\""
+    << ",\"disposition\":\"" << to_string(result.disposition) << "\""
+    << ",\"status\":\"" << library::to_string(result.status) << "\""
+    << ",\"cache_mode\":\"" << to_string(result.cache_mode) << "\""
+    << ",\"arguments\":{";
+
+  int column_idx = 0;
+  for (auto const & arg : result.arguments) {
+    out << (column_idx++ ? "," : "")
+      << "\"" << escape_json_string(arg.first) << "\":\"" << escape_json_string(arg.second) << "\"";
+  }
+
+  out
+    << "}"
+    << ",\"bytes\":" << result.bytes
+    << ",\"flops\":" << result.flops
+    << ",\"runtime\":" << json_number(result.runtime);
+
+  if (result.good()) {
+    out
+      << ",\"gbytes_per_sec\":" << json_number(result.gbytes_per_sec())
+      << ",\"gflops_per_sec\":" << json_number(result.gflops_per_sec());
+  }
+
+  if (result.runtime_statistics.good()) {
+
+    TimingStatistics const &stats = result.runtime_statistics;
+
+    out
+      << ",\"iterations\":" << stats.iterations
+      << ",\"runtime_min\":" << json_number(stats.min)
+      << ",\"runtime_p50\":" << json_number(stats.p50)
+      << ",\"runtime_p90\":" << json_number(stats.p90)
+      << ",\"runtime_p99\":" << json_number(stats.p99)
+      << ",\"runtime_stddev\":" << json_number(stats.stddev);
+  }
+
+  if (result.graph_runtime > 0) {
+    out << ",\"graph_runtime\":" << json_number(result.graph_runtime);
+  }
+
+  out << "}";
+
   return out;
 }
 
@@ -0,0 +1,134 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Host-side statistics over per-iteration kernel runtimes
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "mutlass/profiler/timing_statistics.h"
+
+namespace mutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes summary statistics over a set of samples
+TimingStatistics compute_timing_statistics(std::vector<double> samples) {
+
+  TimingStatistics stats;
+
+  if (samples.empty()) {
+    return stats;
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  stats.iterations = int64_t(samples.size());
+  stats.min = samples.front();
+  stats.max = samples.back();
+
+  double sum = 0;
+  for (double x : samples) {
+    sum += x;
+  }
+  stats.mean = sum / double(samples.size());
+
+  if (samples.size() > 1) {
+    double sum_sq = 0;
+    for (double x : samples) {
+      sum_sq += (x - stats.mean) * (x - stats.mean);
+    }
+    stats.stddev = std::sqrt(sum_sq / double(samples.size() - 1));
+  }
+
+  stats.p50 = percentile(samples, 50);
+  stats.p90 = percentile(samples, 90);
+  stats.p99 = percentile(samples, 99);
+
+  return stats;
+}
+
+/// Returns the p-th percentile (0 <= p <= 100) of an ascending sequence
+double percentile(std::vector<double> const &sorted_samples, double p) {
+
+  if (sorted_samples.empty()) {
+    return 0;
+  }
+
+  p = std::min(std::max(p, 0.0), 100.0);
+
+  double rank = p / 100.0 * double(sorted_samples.size() - 1);
+  size_t lower = size_t(std::floor(rank));
+  size_t upper = std::min(lower + 1, sorted_samples.size() - 1);
+  double frac = rank - double(lower);
+
+  return sorted_samples[lower] + frac * (sorted_samples[upper] - sorted_samples[lower]);
+}
+
+/// Returns the half-width of the confidence interval of the median, relative to the median
+double median_confidence_interval(std::vector<double> samples, double z) {
+
+  int64_t n = int64_t(samples.size());
+  double half_span = z * std::sqrt(double(n)) / 2.0;
+
+  // 1-based ranks of the bounding order statistics
+  int64_t lower = int64_t(std::floor(double(n) / 2.0 - half_span));
+  int64_t upper = int64_t(std::ceil(double(n) / 2.0 + half_span)) + 1;
+
+  if (lower < 1 || upper > n) {
+    return -1;
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  double median = percentile(samples, 50);
+  if (!(median > 0)) {
+    return -1;
+  }
+
+  return (samples[upper - 1] - samples[lower - 1]) / 2.0 / median;
+}
+
+/// Returns true if the relative confidence interval of the median is within the given target
+bool median_confidence_satisfied(std::vector<double> const &samples, double target, double z) {
+  double interval = median_confidence_interval(samples, z);
+  return interval >= 0 && interval <= target;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
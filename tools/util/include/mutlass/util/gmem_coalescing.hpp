@@ -0,0 +1,230 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Host-side global memory coalescing analysis of MuTe tiled copies.
+
+    The analysis replays the addresses every thread of a TiledCopy touches in a global memory
+    tile with the runtime strides of the problem, one warp-wide memory instruction at a time,
+    and counts the memory transactions needed to serve them.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <set>
+
+#include "mute/tensor.hpp"
+#include "mute/atom/copy_atom.hpp"
+#include "mute/atom/mma_atom.hpp"
+
+#include "mutlass/mutlass.h"
+#include "mutlass/util/tiled_copy_trace.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace analysis {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Global memory transaction granularity being modeled
+struct GmemTransactionModel {
+  int transaction_bytes = 32;             ///< bytes fetched per memory transaction
+  int warp_size = NumThreadsPerWarp;      ///< threads issuing one memory instruction
+  int max_vector_bytes = 16;              ///< widest access a thread may issue
+  int64_t base_offset = 0;                ///< byte offset of the tile from a transaction boundary
+};
+
+/// Result of analyzing the global memory accesses of one TiledCopy
+struct GmemAccessReport {
+  int threads = 0;                        ///< threads of the TiledCopy
+  int instructions = 0;                   ///< warp-wide memory instructions issued
+  int transactions = 0;                   ///< transactions needed to serve them
+  int ideal_transactions = 0;             ///< transactions needed if every fetched byte were used
+  int64_t bytes_used = 0;                 ///< distinct bytes the threads access
+  int64_t bytes_fetched = 0;              ///< bytes the transactions move
+  int vector_bits = 0;                    ///< narrowest access width of any instruction
+
+  double transactions_per_instruction() const {
+    return instructions ? double(transactions) / double(instructions) : 0.0;
+  }
+
+  /// Fraction of the fetched bytes that are used
+  double efficiency() const {
+    return bytes_fetched ? double(bytes_used) / double(bytes_fetched) : 1.0;
+  }
+
+  bool coalesced() const {
+    return transactions == ideal_transactions;
+  }
+};
+
+inline std::ostream &operator<<(std::ostream &out, GmemAccessReport const &report) {
+  out << "threads=" << report.threads
+      << " instructions=" << report.instructions
+      << " transactions=" << report.transactions
+      << " ideal=" << report.ideal_transactions
+      << " bytes_used=" << report.bytes_used
+      << " bytes_fetched=" << report.bytes_fetched
+      << " vector_bits=" << report.vector_bits
+      << " efficiency=" << report.efficiency();
+  return out;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Replays the global memory side of a TiledCopy on a rank-2 gmem tile
+template <bool IsLoad, class TiledCopy, class GmemLayout>
+GmemAccessReport analyze_gmem_accesses(
+  TiledCopy const &tiled_copy,
+  GmemLayout const &gmem_layout,
+  GmemTransactionModel const &model) {
+
+  using namespace mute;
+  using Element = typename TiledCopy::ValType;
+
+  static_assert(sizeof_bits_v<Element> % 8 == 0, "Sub-byte elements are not supported.");
+
+  int const element_bytes = sizeof_bits_v<Element> / 8;
+  TiledCopyTrace offsets = trace_tiled_copy<IsLoad>(tiled_copy, gmem_layout);
+  int const num_threads = int(offsets.size());
+
+  GmemAccessReport report;
+  report.threads = num_threads;
+  report.vector_bits = model.max_vector_bytes * 8;
+
+  int const num_instructions = num_threads ? int(offsets[0].size()) : 0;
+  for (int warp_begin = 0; warp_begin < num_threads; warp_begin += model.warp_size) {
+    int const warp_end = std::min(num_threads, warp_begin + model.warp_size);
+
+    for (int inst = 0; inst < num_instructions; ++inst) {
+      int const vector = warp_vector_elements(
+        offsets, warp_begin, warp_end, inst, element_bytes, model.max_vector_bytes);
+      report.vector_bits = std::min(report.vector_bits, vector * element_bytes * 8);
+
+      int const values = int(offsets[warp_begin][inst].size());
+      for (int begin = 0; begin < values; begin += vector) {
+        int const access_bytes = vector * element_bytes;
+
+        std::set<int64_t> segments;
+        std::set<int64_t> bytes;
+        for (int thread_idx = warp_begin; thread_idx < warp_end; ++thread_idx) {
+          int64_t address = model.base_offset + offsets[thread_idx][inst][begin] * element_bytes;
+          for (int64_t byte = address; byte < address + access_bytes; ++byte) {
+            bytes.insert(byte);
+          }
+          segments.insert(address / model.transaction_bytes);
+          segments.insert((address + access_bytes - 1) / model.transaction_bytes);
+        }
+
+        int64_t const used = int64_t(bytes.size());
+        ++report.instructions;
+        report.transactions += int(segments.size());
+        report.ideal_transactions += int((used + model.transaction_bytes - 1) / model.transaction_bytes);
+        report.bytes_used += used;
+        report.bytes_fetched += int64_t(segments.size()) * model.transaction_bytes;
+      }
+    }
+  }
+
+  return report;
+}
+
+} // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Analyzes the global memory loads of a TiledCopy reading its source from gmem_layout, a
+/// rank-2 tile with the runtime strides of the problem
+template <class TiledCopy, class GmemLayout>
+GmemAccessReport analyze_gmem_load(
+  TiledCopy const &tiled_copy,
+  GmemLayout const &gmem_layout,
+  GmemTransactionModel const &model = {}) {
+
+  return detail::analyze_gmem_accesses<true>(tiled_copy, gmem_layout, model);
+}
+
+/// Analyzes the global memory stores of a TiledCopy writing its destination into gmem_layout
+template <class TiledCopy, class GmemLayout>
+GmemAccessReport analyze_gmem_store(
+  TiledCopy const &tiled_copy,
+  GmemLayout const &gmem_layout,
+  GmemTransactionModel const &model = {}) {
+
+  return detail::analyze_gmem_accesses<false>(tiled_copy, gmem_layout, model);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Global memory traffic of a collective mainloop
+struct MainloopGmemReport {
+  GmemAccessReport load_a;                ///< GmemTiledCopyA reading one (BLK_M,BLK_K) tile of A
+  GmemAccessReport load_b;                ///< GmemTiledCopyB reading one (BLK_N,BLK_K) tile of B
+
+  bool coalesced() const {
+    return load_a.coalesced() && load_b.coalesced();
+  }
+};
+
+/// Analyzes the global memory loads of a CollectiveMma for the runtime strides dA and dB
+template <class CollectiveMma>
+MainloopGmemReport analyze_mainloop_gmem(
+  typename CollectiveMma::StrideA const &dA,
+  typename CollectiveMma::StrideB const &dB,
+  GmemTransactionModel const &model = {}) {
+
+  using namespace mute;
+  using TileShape = typename CollectiveMma::TileShape;
+
+  auto tile_a = make_layout(make_shape(get<0>(TileShape{}), get<2>(TileShape{})),
+                            make_stride(get<0>(dA), get<1>(dA)));
+  auto tile_b = make_layout(make_shape(get<1>(TileShape{}), get<2>(TileShape{})),
+                            make_stride(get<0>(dB), get<1>(dB)));
+
+  MainloopGmemReport report;
+  report.load_a = analyze_gmem_load(typename CollectiveMma::GmemTiledCopyA{}, tile_a, model);
+  report.load_b = analyze_gmem_load(typename CollectiveMma::GmemTiledCopyB{}, tile_b, model);
+  return report;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace analysis
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,225 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Host simulation of a kernel grid.
+
+    launch_host_grid() runs the operator() of a kernel, such as gemm::kernel::GemmUniversal, for
+    every CTA of a grid on the host. Each thread of a CTA is a std::thread, __syncthreads() is a
+    barrier over the threads of the CTA, and shared memory is a host buffer. Threads are grouped
+    into mute::HostWarp warps, so warp-collective instructions with a host path, such as the MP22
+    MMAs, take part too. Together they give bit-level functional coverage of mainloops and
+    epilogues on machines without a device.
+
+    The simulation is compiled by the host compiler, which does not know the built-in variables of
+    a kernel. This header defines threadIdx, blockIdx, blockDim, gridDim and __syncthreads() for
+    the simulated threads, so it has to be included before any kernel header.
+*/
+
+#pragma once
+
+#if defined(__MUSACC__)
+#error "mutlass/util/host_grid.hpp simulates kernels on the host and cannot be compiled by mcc"
+#endif
+
+// The built-in variables below and the host MMA emulation have to be seen by every kernel header
+#if defined(MUTE_HOST_DEVICE) || defined(MUTLASS_HOST_DEVICE)
+#error "mutlass/util/host_grid.hpp must be included before any MuTe or MUTLASS header"
+#endif
+
+// Warp-collective MMAs of the simulated kernels run through their host emulation
+#if !defined(MUTE_ENABLE_HOST_MMA_EMULATION)
+#define MUTE_ENABLE_HOST_MMA_EMULATION
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include "musa_runtime.h"
+
+#include "mute/arch/host_warp.hpp"
+
+#include "mutlass/mutlass.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace simulation {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// How a grid is simulated
+struct HostGridOptions {
+  int concurrent_ctas = 1;      ///< CTAs simulated at the same time, each by its own threads
+  uint8_t smem_fill = 0xff;     ///< byte shared memory holds at the start of every CTA
+};
+
+namespace detail {
+
+// Base alignment of the shared memory buffer of a simulated CTA
+static constexpr uintptr_t HostSmemAlignment = 1024;
+
+// Threads, warps and shared memory simulating one CTA at a time
+struct HostCta {
+  mute::HostBarrier          barrier;
+  std::deque<mute::HostWarp> warps;
+  std::vector<char>          storage;
+  char*                      smem;
+
+  HostCta(int num_threads, int smem_size)
+    : barrier(num_threads),
+      storage(size_t(smem_size) + HostSmemAlignment) {
+    for (int lane = 0; lane < num_threads; lane += mute::HostWarp::NumLanes) {
+      warps.emplace_back(std::min(num_threads - lane, mute::HostWarp::NumLanes));
+    }
+    uintptr_t base = reinterpret_cast<uintptr_t>(storage.data());
+    smem = storage.data() + ((HostSmemAlignment - base % HostSmemAlignment) % HostSmemAlignment);
+  }
+};
+
+// CTA the calling host thread is simulating, if any
+inline HostCta*&
+host_cta() {
+  static thread_local HostCta* cta = nullptr;
+  return cta;
+}
+
+inline uint3
+unflatten(uint32_t idx, dim3 const& extent) {
+  return {idx % extent.x, idx / extent.x % extent.y, idx / (extent.x * extent.y)};
+}
+
+} // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace simulation
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Built-in variables of the simulated threads
+inline thread_local uint3 threadIdx{0, 0, 0};
+inline thread_local uint3 blockIdx{0, 0, 0};
+inline thread_local dim3  blockDim{1, 1, 1};
+inline thread_local dim3  gridDim{1, 1, 1};
+
+// Outside of a simulated grid, the calling thread is a CTA of its own
+inline void __syncthreads() {
+  if (auto* cta = mutlass::simulation::detail::host_cta()) {
+    cta->barrier.arrive_and_wait();
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace simulation {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Runs Operator{}(params, smem) for every CTA of grid, with block threads per CTA and smem_size
+/// bytes of shared memory. CTAs are simulated in order of their linear index, x fastest, and
+/// options.concurrent_ctas of them at the same time. Returns once the whole grid has finished.
+template <class Operator>
+void
+launch_host_grid(
+    typename Operator::Params const& params,
+    dim3 grid,
+    dim3 block,
+    int smem_size,
+    HostGridOptions const& options = {}) {
+
+  int const num_ctas = int(grid.x * grid.y * grid.z);
+  int const num_threads = int(block.x * block.y * block.z);
+  int const num_workers = std::max(1, std::min(options.concurrent_ctas, num_ctas));
+
+  std::deque<detail::HostCta> ctas;
+  for (int worker = 0; worker < num_workers; ++worker) {
+    ctas.emplace_back(num_threads, smem_size);
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(size_t(num_workers) * num_threads);
+  for (int worker = 0; worker < num_workers; ++worker) {
+    for (int thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+      threads.emplace_back([&, worker, thread_idx] {
+        detail::HostCta& cta = ctas[worker];
+        detail::host_cta() = &cta;
+        mute::host_lane() = {&cta.warps[thread_idx / mute::HostWarp::NumLanes],
+                             thread_idx % mute::HostWarp::NumLanes};
+        threadIdx = detail::unflatten(thread_idx, block);
+        blockDim = block;
+        gridDim = grid;
+
+        for (int cta_idx = worker; cta_idx < num_ctas; cta_idx += num_workers) {
+          if (thread_idx == 0) {
+            std::memset(cta.smem, options.smem_fill, size_t(smem_size));
+          }
+          blockIdx = detail::unflatten(cta_idx, grid);
+          cta.barrier.arrive_and_wait();
+
+          Operator op;
+          op(params, cta.smem);
+
+          // Shared memory is reused by the next CTA of this worker
+          cta.barrier.arrive_and_wait();
+        }
+
+        mute::host_lane() = {};
+        detail::host_cta() = nullptr;
+      });
+    }
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+/// Runs a kernel with the grid, block and shared memory size it would be launched with
+template <class Operator>
+void
+launch_host_kernel(typename Operator::Params const& params, HostGridOptions const& options = {}) {
+  launch_host_grid<Operator>(
+      params, Operator::get_grid_shape(params), Operator::get_block_shape(), Operator::SharedStorageSize, options);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace simulation
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
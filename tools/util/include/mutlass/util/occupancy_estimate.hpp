@@ -0,0 +1,232 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+/*! \file
+    \brief Host-side register footprint and occupancy estimate of MuTe collective mainloops.
+
+    The estimate sizes the register tensors a two-stage mainloop keeps live across its k-loop
+    (the accumulators, the MMA operand fragments of one k-tile and the register copy buffers
+    staging the next k-tile) from the types of the collective alone, and derives how many CTAs
+    of the kernel fit on one core. Everything is computed from static shapes, so the estimate is
+    available in constant expressions, before the kernel is ever compiled for the device.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <ostream>
+
+#include "mute/tensor.hpp"
+#include "mute/atom/copy_atom.hpp"
+#include "mute/atom/mma_atom.hpp"
+
+#include "mutlass/mutlass.h"
+#include "mutlass/gemm/kernel/gemm_smem_plan.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace analysis {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Resources of one core being modeled. Registers are counted in 32-bit words.
+struct OccupancyModel {
+  int registers_per_core = 128 * 1024;    ///< register file of one core
+  int max_registers_per_thread = 255;     ///< registers one thread may address before spilling
+  int register_allocation_unit = 8;       ///< granularity of the per-thread register allocation
+  int reserved_registers = 16;            ///< addresses, indices and loop state not modeled below
+  int smem_per_core = 72 * 1024;          ///< shared memory bytes of one core
+  int max_threads_per_core = 2048;        ///< resident threads of one core
+  int max_ctas_per_core = 16;             ///< resident CTAs of one core
+};
+
+/// Registers per thread a mainloop keeps live across its k-loop
+struct RegisterEstimate {
+  int accumulators = 0;                   ///< partition_fragment_C of the CTA tile
+  int fragment_a = 0;                     ///< MMA operand fragment of A for one k-tile
+  int fragment_b = 0;
+  int copy_buffer_a = 0;                  ///< registers staging the next k-tile of A to smem
+  int copy_buffer_b = 0;
+  int reserved = 0;
+
+  constexpr int total() const {
+    return accumulators + fragment_a + fragment_b + copy_buffer_a + copy_buffer_b + reserved;
+  }
+};
+
+inline std::ostream &operator<<(std::ostream &out, RegisterEstimate const &estimate) {
+  out << "accumulators=" << estimate.accumulators
+      << " fragment_a=" << estimate.fragment_a
+      << " fragment_b=" << estimate.fragment_b
+      << " copy_buffer_a=" << estimate.copy_buffer_a
+      << " copy_buffer_b=" << estimate.copy_buffer_b
+      << " reserved=" << estimate.reserved
+      << " total=" << estimate.total();
+  return out;
+}
+
+/// Resident CTAs of a kernel per core, and the resource limiting them
+struct OccupancyEstimate {
+  RegisterEstimate registers;
+  int registers_per_thread = 0;           ///< registers allocated per thread
+  int threads_per_cta = 0;
+  int smem_per_cta = 0;                   ///< shared memory bytes per CTA
+  int ctas_by_registers = 0;
+  int ctas_by_smem = 0;
+  int ctas_by_threads = 0;
+  int ctas_per_core = 0;
+  int max_threads_per_core = 0;
+
+  /// True if the live registers exceed what one thread may address
+  constexpr bool spills() const {
+    return registers.total() > registers_per_thread;
+  }
+
+  /// Fraction of the resident threads of a core that are occupied
+  constexpr double occupancy() const {
+    return max_threads_per_core ? double(ctas_per_core * threads_per_cta) / double(max_threads_per_core) : 0.0;
+  }
+
+  /// Name of the resource bounding ctas_per_core
+  constexpr char const *limiter() const {
+    return ctas_per_core == ctas_by_registers ? "registers"
+         : ctas_per_core == ctas_by_smem      ? "smem"
+         : ctas_per_core == ctas_by_threads   ? "threads"
+         :                                      "ctas";
+  }
+};
+
+inline std::ostream &operator<<(std::ostream &out, OccupancyEstimate const &estimate) {
+  out << "registers=" << estimate.registers.total()
+      << " allocated=" << estimate.registers_per_thread
+      << " spills=" << estimate.spills()
+      << " threads=" << estimate.threads_per_cta
+      << " smem=" << estimate.smem_per_cta
+      << " ctas=" << estimate.ctas_per_core
+      << " limiter=" << estimate.limiter()
+      << " occupancy=" << estimate.occupancy();
+  return out;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// 32-bit registers holding a register tensor of the given type
+template <class Tensor>
+constexpr int tensor_registers() {
+  using namespace mute;
+  using Element = typename remove_cvref_t<Tensor>::value_type;
+  return int(ceil_div(size_v<typename remove_cvref_t<Tensor>::layout_type> * sizeof_bits_v<Element>, 32));
+}
+
+constexpr int round_up(int value, int unit) {
+  return unit > 0 ? (value + unit - 1) / unit * unit : value;
+}
+
+} // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Estimates the registers per thread a CollectiveMma, e.g. one a CollectiveBuilder produced, keeps
+/// live across its k-loop. Every thread partitions the tiles alike, so thread 0 stands for all.
+template <class CollectiveMma>
+constexpr RegisterEstimate estimate_mainloop_registers(OccupancyModel const &model = {}) {
+  using namespace mute;
+  using TileShape = typename CollectiveMma::TileShape;
+  using TiledMma = typename CollectiveMma::TiledMma;
+  using ElementA = typename CollectiveMma::ElementA;
+  using ElementB = typename CollectiveMma::ElementB;
+
+  using SmemTensorA = decltype(make_tensor(make_smem_ptr(static_cast<ElementA*>(nullptr)),
+                                           typename CollectiveMma::SmemLayoutA{}));
+  using SmemTensorB = decltype(make_tensor(make_smem_ptr(static_cast<ElementB*>(nullptr)),
+                                           typename CollectiveMma::SmemLayoutB{}));
+  using ThrMma = decltype(TiledMma{}.get_thread_slice(0));
+
+  using Accumulators = decltype(partition_fragment_C(TiledMma{}, take<0,2>(TileShape{})));
+  using FragmentA = decltype(declval<ThrMma>().partition_fragment_A(declval<SmemTensorA>()));
+  using FragmentB = decltype(declval<ThrMma>().partition_fragment_B(declval<SmemTensorB>()));
+  using CopyBufferA = decltype(make_fragment_like(
+    typename CollectiveMma::GmemTiledCopyA{}.get_slice(0).partition_D(declval<SmemTensorA>())));
+  using CopyBufferB = decltype(make_fragment_like(
+    typename CollectiveMma::GmemTiledCopyB{}.get_slice(0).partition_D(declval<SmemTensorB>())));
+
+  RegisterEstimate estimate;
+  estimate.accumulators = detail::tensor_registers<Accumulators>();
+  estimate.fragment_a = detail::tensor_registers<FragmentA>();
+  estimate.fragment_b = detail::tensor_registers<FragmentB>();
+  estimate.copy_buffer_a = detail::tensor_registers<CopyBufferA>();
+  estimate.copy_buffer_b = detail::tensor_registers<CopyBufferB>();
+  estimate.reserved = model.reserved_registers;
+  return estimate;
+}
+
+/// Estimates the occupancy of a kernel running the CollectiveMma and CollectiveEpilogue. Like
+/// GemmUniversal, the kernel launches size(TiledMma) threads per CTA and lays out the shared
+/// storage of both collectives by their GemmSmemPlan.
+template <class CollectiveMma, class CollectiveEpilogue = void>
+constexpr OccupancyEstimate estimate_occupancy(OccupancyModel const &model = {}) {
+  using namespace mute;
+
+  int smem_per_cta = int(sizeof(typename CollectiveMma::SharedStorage));
+  if constexpr (not is_void_v<CollectiveEpilogue>) {
+    smem_per_cta = mutlass::gemm::kernel::GemmSmemPlan<
+      CollectiveMma, CollectiveEpilogue, CollectiveMma::SmemAlignmentBytes>::SharedStorageSize;
+  }
+
+  OccupancyEstimate estimate;
+  estimate.registers = estimate_mainloop_registers<CollectiveMma>(model);
+  estimate.registers_per_thread = std::min(
+    detail::round_up(estimate.registers.total(), model.register_allocation_unit),
+    model.max_registers_per_thread);
+  estimate.threads_per_cta = int(size(typename CollectiveMma::TiledMma{}));
+  estimate.smem_per_cta = smem_per_cta;
+  estimate.max_threads_per_core = model.max_threads_per_core;
+
+  estimate.ctas_by_registers = model.registers_per_core /
+    std::max(1, estimate.registers_per_thread * estimate.threads_per_cta);
+  estimate.ctas_by_smem = smem_per_cta > 0 ? model.smem_per_core / smem_per_cta : model.max_ctas_per_core;
+  estimate.ctas_by_threads = model.max_threads_per_core / std::max(1, estimate.threads_per_cta);
+  estimate.ctas_per_core = std::min({estimate.ctas_by_registers, estimate.ctas_by_smem,
+                                     estimate.ctas_by_threads, model.max_ctas_per_core});
+  return estimate;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace analysis
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,142 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+  \brief Reference implementation of multi-head attention forward.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "mutlass/mutlass.h"
+
+namespace mutlass  {
+namespace reference {
+namespace host {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes O = softmax(softmax_scale * Q K^T) V for every sequence and head, accumulating in
+/// double precision.
+//
+// Q and O hold num_heads and K and V hold num_heads_kv rows of head_dim contiguous elements per
+// token, with the tokens packed. Sequence b spans tokens [cu_seqlens[b], cu_seqlens[b + 1]).
+// Query head h reads key and value head h / (num_heads / num_heads_kv). If causal, query i of a
+// sequence sees key j iff j <= i + seqlen_k - seqlen_q. Queries seeing no key produce zeros and
+// a logsumexp of -infinity. If lse is not null, it receives the logsumexp of the scaled scores
+// of each query at [token * num_heads + head].
+template <
+  typename Element,
+  typename ElementAccumulator
+>
+void FmhaForward(
+  Element const *Q,
+  Element const *K,
+  Element const *V,
+  Element *O,
+  int const *cu_seqlens_q,
+  int const *cu_seqlens_k,
+  int batch_count,
+  int num_heads,
+  int num_heads_kv,
+  int head_dim,
+  ElementAccumulator softmax_scale,
+  bool causal,
+  ElementAccumulator *lse = nullptr) {
+
+  int group_size = num_heads / num_heads_kv;
+  std::vector<double> scores;
+  std::vector<double> output(head_dim);
+
+  for (int b = 0; b < batch_count; ++b) {
+    int seqlen_q = cu_seqlens_q[b + 1] - cu_seqlens_q[b];
+    int seqlen_k = cu_seqlens_k[b + 1] - cu_seqlens_k[b];
+    scores.resize(seqlen_k);
+
+    for (int h = 0; h < num_heads; ++h) {
+      int h_kv = h / group_size;
+
+      for (int i = 0; i < seqlen_q; ++i) {
+        int64_t token_q = cu_seqlens_q[b] + i;
+        Element const *q = Q + (token_q * num_heads + h) * head_dim;
+
+        int visible = causal ? std::min(seqlen_k, std::max(0, i + seqlen_k - seqlen_q + 1)) : seqlen_k;
+
+        double max = -std::numeric_limits<double>::infinity();
+        for (int j = 0; j < visible; ++j) {
+          int64_t token_k = cu_seqlens_k[b] + j;
+          Element const *k = K + (token_k * num_heads_kv + h_kv) * head_dim;
+
+          double dot = 0;
+          for (int d = 0; d < head_dim; ++d) {
+            dot += double(q[d]) * double(k[d]);
+          }
+          scores[j] = dot * double(softmax_scale);
+          max = std::max(max, scores[j]);
+        }
+
+        double sum = 0;
+        std::fill(output.begin(), output.end(), 0.0);
+        for (int j = 0; j < visible; ++j) {
+          int64_t token_k = cu_seqlens_k[b] + j;
+          Element const *v = V + (token_k * num_heads_kv + h_kv) * head_dim;
+
+          double p = std::exp(scores[j] - max);
+          sum += p;
+          for (int d = 0; d < head_dim; ++d) {
+            output[d] += p * double(v[d]);
+          }
+        }
+
+        Element *o = O + (token_q * num_heads + h) * head_dim;
+        for (int d = 0; d < head_dim; ++d) {
+          o[d] = Element(visible > 0 ? output[d] / sum : 0.0);
+        }
+
+        if (lse) {
+          lse[token_q * num_heads + h] = ElementAccumulator(
+            visible > 0 ? max + std::log(sum) : -std::numeric_limits<double>::infinity());
+        }
+      }
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace host
+} // namespace reference
+} // namespace mutlass
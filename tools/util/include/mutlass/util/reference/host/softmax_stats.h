@@ -0,0 +1,152 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+  \brief Reference implementation of the row softmax statistics of a matrix, both per N-tile
+    and for whole rows.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "mutlass/mutlass.h"
+#include "mutlass/tensor_view.h"
+#include "mutlass/epilogue/thread/softmax_stats.h"
+
+namespace mutlass  {
+namespace reference {
+namespace host {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes the maximum and the sum of exp(x - maximum) of each row of an M-by-N matrix over the
+/// columns of each tile of tile_n columns. The statistics of row m and N-tile n are written to
+/// index m + M * n of partial_max and partial_sum.
+template <
+  typename Element,
+  typename Layout,
+  typename ElementStats
+>
+void SoftmaxStatsPartials(
+  TensorView<Element, Layout> view,
+  int tile_n,
+  ElementStats *partial_max,
+  ElementStats *partial_sum) {
+
+  int M = view.extent().row();
+  int N = view.extent().column();
+  int tiles_n = (N + tile_n - 1) / tile_n;
+
+  for (int n_tile = 0; n_tile < tiles_n; ++n_tile) {
+    int n_begin = n_tile * tile_n;
+    int n_end = std::min(N, n_begin + tile_n);
+
+    for (int m = 0; m < M; ++m) {
+      ElementStats max = -std::numeric_limits<ElementStats>::infinity();
+      for (int n = n_begin; n < n_end; ++n) {
+        max = std::max(max, ElementStats(view.at({m, n})));
+      }
+
+      ElementStats sum = ElementStats(0);
+      for (int n = n_begin; n < n_end; ++n) {
+        sum += std::exp(ElementStats(view.at({m, n})) - max);
+      }
+
+      partial_max[m + int64_t(M) * n_tile] = max;
+      partial_sum[m + int64_t(M) * n_tile] = sum;
+    }
+  }
+}
+
+/// Combines the statistics of tiles_n partials of each of M rows, laid out as written by
+/// SoftmaxStatsPartials, into the statistics of whole rows.
+template <typename ElementStats>
+void SoftmaxStatsCombine(
+  ElementStats const *partial_max,
+  ElementStats const *partial_sum,
+  int M,
+  int tiles_n,
+  ElementStats *row_max,
+  ElementStats *row_sum) {
+
+  using SoftmaxStats = mutlass::epilogue::thread::SoftmaxStats<ElementStats>;
+
+  for (int m = 0; m < M; ++m) {
+    SoftmaxStats stats;
+    for (int n_tile = 0; n_tile < tiles_n; ++n_tile) {
+      int64_t offset = m + int64_t(M) * n_tile;
+      stats = SoftmaxStats::combine(stats, SoftmaxStats(partial_max[offset], partial_sum[offset]));
+    }
+    row_max[m] = stats.max;
+    row_sum[m] = stats.sum;
+  }
+}
+
+/// Computes the maximum and the sum of exp(x - maximum) of each whole row of an M-by-N matrix
+/// directly, accumulating in double precision.
+template <
+  typename Element,
+  typename Layout,
+  typename ElementStats
+>
+void SoftmaxStatsRows(
+  TensorView<Element, Layout> view,
+  ElementStats *row_max,
+  ElementStats *row_sum) {
+
+  int M = view.extent().row();
+  int N = view.extent().column();
+
+  for (int m = 0; m < M; ++m) {
+    double max = -std::numeric_limits<double>::infinity();
+    for (int n = 0; n < N; ++n) {
+      max = std::max(max, double(view.at({m, n})));
+    }
+
+    double sum = 0;
+    for (int n = 0; n < N; ++n) {
+      sum += std::exp(double(view.at({m, n})) - max);
+    }
+
+    row_max[m] = ElementStats(max);
+    row_sum[m] = ElementStats(sum);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace host
+} // namespace reference
+} // namespace mutlass
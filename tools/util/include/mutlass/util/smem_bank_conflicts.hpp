@@ -0,0 +1,308 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Host-side shared memory bank conflict analysis of MuTe tiled copies.
+
+    The analysis replays the addresses every thread of a TiledCopy touches in a shared memory
+    layout, one warp-wide memory instruction at a time, and counts the wavefronts the banks need
+    to serve them. It runs entirely on the host and works with any layout MuTe can evaluate,
+    including Swizzle-composed layouts.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "mute/tensor.hpp"
+#include "mute/atom/copy_atom.hpp"
+#include "mute/atom/mma_atom.hpp"
+
+#include "mutlass/mutlass.h"
+#include "mutlass/util/tiled_copy_trace.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace analysis {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Banking of the shared memory being modeled
+struct SmemBankModel {
+  int num_banks = 32;                     ///< banks serving one wavefront
+  int bank_bytes = 4;                     ///< width of one bank word
+  int warp_size = NumThreadsPerWarp;      ///< threads issuing one memory instruction
+  int max_vector_bytes = 16;              ///< widest access a thread may issue
+};
+
+/// Result of analyzing the shared memory accesses of one TiledCopy
+struct SmemAccessReport {
+  int threads = 0;                        ///< threads of the TiledCopy
+  int instructions = 0;                   ///< warp-wide memory instructions issued
+  int wavefronts = 0;                     ///< wavefronts needed to serve them
+  int ideal_wavefronts = 0;               ///< wavefronts needed without bank conflicts
+  int max_ways = 0;                       ///< worst n-way bank conflict of any phase
+  int vector_bits = 0;                    ///< narrowest access width of any instruction
+  int bytes = 0;                          ///< bytes moved per CTA
+
+  /// Wavefronts lost to bank conflicts
+  int bank_conflicts() const {
+    return wavefronts - ideal_wavefronts;
+  }
+
+  bool conflict_free() const {
+    return wavefronts == ideal_wavefronts;
+  }
+
+  /// Fraction of the shared memory bandwidth that is used
+  double efficiency() const {
+    return wavefronts ? double(ideal_wavefronts) / double(wavefronts) : 1.0;
+  }
+};
+
+inline std::ostream &operator<<(std::ostream &out, SmemAccessReport const &report) {
+  out << "threads=" << report.threads
+      << " instructions=" << report.instructions
+      << " wavefronts=" << report.wavefronts
+      << " ideal=" << report.ideal_wavefronts
+      << " conflicts=" << report.bank_conflicts()
+      << " max_ways=" << report.max_ways
+      << " vector_bits=" << report.vector_bits
+      << " efficiency=" << report.efficiency();
+  return out;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Per-thread byte offsets of one copy instruction, and the bytes each of them accesses
+struct WarpAccess {
+  std::vector<int64_t> offsets;           ///< indexed by lane, -1 if the lane is idle
+  int bytes = 0;
+};
+
+/// Accumulates the wavefronts of one warp-wide access into a report.
+///
+/// Lanes are served in phases of as many consecutive lanes as their accesses fill the banks
+/// once. Within a phase, lanes reading the same bank word are served together and distinct
+/// words in the same bank are serialized.
+inline void account_warp_access(
+  SmemAccessReport &report,
+  WarpAccess const &access,
+  SmemBankModel const &model) {
+
+  int const lanes = int(access.offsets.size());
+  int const lanes_per_phase = std::max(1, std::min(lanes,
+    model.num_banks * model.bank_bytes / std::max(access.bytes, model.bank_bytes)));
+
+  ++report.instructions;
+
+  std::vector<std::unordered_set<int64_t>> bank_words(model.num_banks);
+  for (int phase_begin = 0; phase_begin < lanes; phase_begin += lanes_per_phase) {
+    for (auto &words : bank_words) {
+      words.clear();
+    }
+
+    int distinct_words = 0;
+    for (int lane = phase_begin; lane < std::min(lanes, phase_begin + lanes_per_phase); ++lane) {
+      int64_t offset = access.offsets[lane];
+      if (offset < 0) {
+        continue;
+      }
+      int64_t first_word = offset / model.bank_bytes;
+      int64_t last_word = (offset + access.bytes - 1) / model.bank_bytes;
+      for (int64_t word = first_word; word <= last_word; ++word) {
+        distinct_words += int(bank_words[word % model.num_banks].insert(word).second);
+      }
+    }
+
+    if (distinct_words == 0) {
+      continue;
+    }
+
+    int ways = 0;
+    for (auto const &words : bank_words) {
+      ways = std::max(ways, int(words.size()));
+    }
+
+    report.wavefronts += ways;
+    report.ideal_wavefronts += (distinct_words + model.num_banks - 1) / model.num_banks;
+    report.max_ways = std::max(report.max_ways, ways);
+  }
+}
+
+/// Accounts the shared memory accesses of a traced TiledCopy, one warp-wide instruction at a time
+inline SmemAccessReport analyze_smem_trace(
+  TiledCopyTrace const &offsets,
+  int element_bytes,
+  SmemBankModel const &model) {
+
+  int const num_threads = int(offsets.size());
+
+  SmemAccessReport report;
+  report.threads = num_threads;
+  report.vector_bits = model.max_vector_bytes * 8;
+
+  int const num_instructions = num_threads ? int(offsets[0].size()) : 0;
+  for (int warp_begin = 0; warp_begin < num_threads; warp_begin += model.warp_size) {
+    int const warp_end = std::min(num_threads, warp_begin + model.warp_size);
+
+    for (int inst = 0; inst < num_instructions; ++inst) {
+      int const vector = warp_vector_elements(
+        offsets, warp_begin, warp_end, inst, element_bytes, model.max_vector_bytes);
+      report.vector_bits = std::min(report.vector_bits, vector * element_bytes * 8);
+
+      int const values = int(offsets[warp_begin][inst].size());
+      for (int begin = 0; begin < values; begin += vector) {
+        WarpAccess access;
+        access.bytes = vector * element_bytes;
+        access.offsets.resize(warp_end - warp_begin);
+        for (int thread_idx = warp_begin; thread_idx < warp_end; ++thread_idx) {
+          access.offsets[thread_idx - warp_begin] = offsets[thread_idx][inst][begin] * element_bytes;
+        }
+        report.bytes += access.bytes * (warp_end - warp_begin);
+        account_warp_access(report, access, model);
+      }
+    }
+  }
+
+  return report;
+}
+
+/// Replays the shared memory side of a TiledCopy on a rank-2 smem layout
+template <bool IsLoad, class TiledCopy, class SmemLayout>
+SmemAccessReport analyze_smem_accesses(
+  TiledCopy const &tiled_copy,
+  SmemLayout const &smem_layout,
+  SmemBankModel const &model) {
+
+  using namespace mute;
+  using Element = typename TiledCopy::ValType;
+
+  static_assert(sizeof_bits_v<Element> % 8 == 0, "Sub-byte elements are not supported.");
+
+  return analyze_smem_trace(trace_tiled_copy<IsLoad>(tiled_copy, smem_layout), sizeof_bits_v<Element> / 8, model);
+}
+
+} // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Analyzes the shared memory stores of a TiledCopy writing its destination into smem_layout
+template <class TiledCopy, class SmemLayout>
+SmemAccessReport analyze_smem_store(
+  TiledCopy const &tiled_copy,
+  SmemLayout const &smem_layout,
+  SmemBankModel const &model = {}) {
+
+  return detail::analyze_smem_accesses<false>(tiled_copy, smem_layout, model);
+}
+
+/// Analyzes the shared memory loads of a TiledCopy reading its source from smem_layout
+template <class TiledCopy, class SmemLayout>
+SmemAccessReport analyze_smem_load(
+  TiledCopy const &tiled_copy,
+  SmemLayout const &smem_layout,
+  SmemBankModel const &model = {}) {
+
+  return detail::analyze_smem_accesses<true>(tiled_copy, smem_layout, model);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Shared memory traffic of a collective mainloop
+struct MainloopSmemReport {
+  SmemAccessReport store_a;               ///< GmemTiledCopyA writing sA
+  SmemAccessReport load_a;                ///< SmemCopyAtomA reading sA for the TiledMma
+  SmemAccessReport store_b;
+  SmemAccessReport load_b;
+
+  bool conflict_free() const {
+    return store_a.conflict_free() && load_a.conflict_free() &&
+           store_b.conflict_free() && load_b.conflict_free();
+  }
+};
+
+/// Analyzes the shared memory traffic of a CollectiveMma, e.g. one a CollectiveBuilder produced
+template <class CollectiveMma>
+MainloopSmemReport analyze_mainloop_smem(SmemBankModel const &model = {}) {
+  using namespace mute;
+  using TiledMma = typename CollectiveMma::TiledMma;
+
+  MainloopSmemReport report;
+  report.store_a = analyze_smem_store(typename CollectiveMma::GmemTiledCopyA{},
+                                      typename CollectiveMma::SmemLayoutA{}, model);
+  report.store_b = analyze_smem_store(typename CollectiveMma::GmemTiledCopyB{},
+                                      typename CollectiveMma::SmemLayoutB{}, model);
+  report.load_a = analyze_smem_load(make_tiled_copy_A(typename CollectiveMma::SmemCopyAtomA{}, TiledMma{}),
+                                    typename CollectiveMma::SmemLayoutA{}, model);
+  report.load_b = analyze_smem_load(make_tiled_copy_B(typename CollectiveMma::SmemCopyAtomB{}, TiledMma{}),
+                                    typename CollectiveMma::SmemLayoutB{}, model);
+  return report;
+}
+
+/// Shared memory traffic of an epilogue staging the accumulators through shared memory
+struct EpilogueSmemReport {
+  SmemAccessReport store;                 ///< CopyAtomR2S writing the accumulators
+  SmemAccessReport load;                  ///< TiledCopyS2R reading them back
+
+  bool conflict_free() const {
+    return store.conflict_free() && load.conflict_free();
+  }
+};
+
+/// Analyzes the shared memory traffic of an epilogue such as Mp22EpilogueVectorized
+template <class Epilogue, class TiledMma>
+EpilogueSmemReport analyze_epilogue_smem(TiledMma const &tiled_mma, SmemBankModel const &model = {}) {
+  using namespace mute;
+
+  EpilogueSmemReport report;
+  report.store = analyze_smem_store(make_tiled_copy_C(typename Epilogue::CopyAtomR2S{}, tiled_mma),
+                                    typename Epilogue::SmemLayout{}, model);
+  report.load = analyze_smem_load(typename Epilogue::TiledCopyS2R{},
+                                  typename Epilogue::SmemLayout{}, model);
+  return report;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace analysis
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,242 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Host-side search for the shared memory swizzle of a MuTe tile.
+
+    Enumerates the mute::Swizzle<B,M,S> functions that fit a shared memory tile, replays the
+    tile's store and load TiledCopy through each of them and ranks them by the wavefronts both
+    accesses need together. Swizzles that would narrow the vectorized accesses of either copy are
+    rejected. The result is printed as the SmemSwizzle type the MP22 CollectiveBuilder accepts.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mute/tensor.hpp"
+#include "mute/atom/copy_atom.hpp"
+#include "mute/atom/mma_atom.hpp"
+
+#include "mutlass/mutlass.h"
+#include "mutlass/util/smem_bank_conflicts.hpp"
+#include "mutlass/util/tiled_copy_trace.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace analysis {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Runtime counterpart of mute::Swizzle<bits, base, shift>
+struct SwizzleParams {
+  int bits = 0;                           ///< number of bits in the mask
+  int base = 4;                           ///< number of least-significant bits kept constant
+  int shift = 3;                          ///< distance to shift the mask
+
+  /// Applies the swizzle to an element offset, as mute::Swizzle::apply does
+  int64_t operator()(int64_t offset) const {
+    int64_t const yyy_msk = ((int64_t(1) << bits) - 1) << (base + shift);
+    return offset ^ ((offset & yyy_msk) >> shift);
+  }
+
+  /// Number of low offset bits the swizzle permutes within
+  int footprint_bits() const {
+    return bits ? base + shift + bits : 0;
+  }
+
+  bool operator==(SwizzleParams const &rhs) const {
+    return bits == rhs.bits && base == rhs.base && shift == rhs.shift;
+  }
+};
+
+inline std::ostream &operator<<(std::ostream &out, SwizzleParams const &swizzle) {
+  return out << "mute::Swizzle<" << swizzle.bits << "," << swizzle.base << "," << swizzle.shift << ">";
+}
+
+/// Shared memory traffic of one tile under one swizzle
+struct SwizzleCandidate {
+  SwizzleParams swizzle;
+  SmemAccessReport store;                 ///< TiledCopy writing the tile
+  SmemAccessReport load;                  ///< TiledCopy reading it back
+
+  int wavefronts() const {
+    return store.wavefronts + load.wavefronts;
+  }
+
+  int bank_conflicts() const {
+    return store.bank_conflicts() + load.bank_conflicts();
+  }
+};
+
+/// Swizzles evaluated for one tile
+struct SwizzleSearchResult {
+  SwizzleCandidate unswizzled;            ///< the tile as given
+  std::vector<SwizzleCandidate> ranked;   ///< admissible swizzles, best first, unswizzled included
+
+  SwizzleCandidate const &best() const {
+    return ranked.front();
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+inline TiledCopyTrace swizzle_trace(TiledCopyTrace trace, SwizzleParams const &swizzle) {
+  for (auto &thread_trace : trace) {
+    for (auto &inst : thread_trace) {
+      for (auto &offset : inst) {
+        offset = swizzle(offset);
+      }
+    }
+  }
+  return trace;
+}
+
+} // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Searches the swizzle to compose with smem_layout, an unswizzled rank-2 shared memory tile that
+/// store_copy writes and load_copy reads. Swizzles up to max_bits wide are considered if they
+/// permute offsets within the tile, i.e. 2^(B+M+S) divides its cosize.
+template <class StoreTiledCopy, class LoadTiledCopy, class SmemLayout>
+SwizzleSearchResult search_smem_swizzle(
+  StoreTiledCopy const &store_copy,
+  LoadTiledCopy const &load_copy,
+  SmemLayout const &smem_layout,
+  SmemBankModel const &model = {},
+  int max_bits = 3) {
+
+  using namespace mute;
+  using Element = typename StoreTiledCopy::ValType;
+
+  static_assert(is_same_v<Element, typename LoadTiledCopy::ValType>,
+                "The store and load must move the same element type.");
+  static_assert(not is_composed_layout<SmemLayout>::value, "The tile must not be swizzled already.");
+  static_assert(sizeof_bits_v<Element> % 8 == 0, "Sub-byte elements are not supported.");
+
+  int const element_bytes = sizeof_bits_v<Element> / 8;
+  TiledCopyTrace const store_trace = trace_tiled_copy<false>(store_copy, smem_layout);
+  TiledCopyTrace const load_trace = trace_tiled_copy<true>(load_copy, smem_layout);
+
+  auto evaluate = [&](SwizzleParams const &swizzle) {
+    SwizzleCandidate candidate;
+    candidate.swizzle = swizzle;
+    candidate.store = detail::analyze_smem_trace(detail::swizzle_trace(store_trace, swizzle), element_bytes, model);
+    candidate.load = detail::analyze_smem_trace(detail::swizzle_trace(load_trace, swizzle), element_bytes, model);
+    return candidate;
+  };
+
+  SwizzleSearchResult result;
+  result.unswizzled = evaluate(SwizzleParams{});
+  result.ranked.push_back(result.unswizzled);
+
+  int64_t const footprint = int64_t(cosize(smem_layout));
+  for (int bits = 1; bits <= max_bits; ++bits) {
+    for (int shift = bits; bits + shift < 63 && (footprint % (int64_t(1) << (bits + shift))) == 0; ++shift) {
+      for (int base = 0; (footprint % (int64_t(1) << (bits + shift + base))) == 0; ++base) {
+        SwizzleCandidate candidate = evaluate(SwizzleParams{bits, base, shift});
+        if (candidate.store.vector_bits < result.unswizzled.store.vector_bits ||
+            candidate.load.vector_bits < result.unswizzled.load.vector_bits) {
+          continue;
+        }
+        result.ranked.push_back(candidate);
+      }
+    }
+  }
+
+  // Fewest wavefronts first, then the swizzle permuting the fewest bits
+  std::stable_sort(result.ranked.begin(), result.ranked.end(),
+    [](SwizzleCandidate const &a, SwizzleCandidate const &b) {
+      if (a.wavefronts() != b.wavefronts()) {
+        return a.wavefronts() < b.wavefronts();
+      }
+      if (a.swizzle.footprint_bits() != b.swizzle.footprint_bits()) {
+        return a.swizzle.footprint_bits() < b.swizzle.footprint_bits();
+      }
+      return a.swizzle.bits < b.swizzle.bits;
+    });
+
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Swizzles searched for the A and B tiles of a collective mainloop
+struct MainloopSwizzleSearch {
+  SwizzleSearchResult a;
+  SwizzleSearchResult b;
+};
+
+/// Searches the swizzles of the A and B shared memory tiles of a CollectiveMma built without
+/// swizzles, e.g. one a CollectiveBuilder produced with SmemSwizzleAuto
+template <class CollectiveMma>
+MainloopSwizzleSearch search_mainloop_swizzle(SmemBankModel const &model = {}, int max_bits = 3) {
+  using namespace mute;
+  using TiledMma = typename CollectiveMma::TiledMma;
+
+  // One pipeline stage of each operand
+  auto smem_layout_a = take<0,2>(typename CollectiveMma::SmemLayoutA{});
+  auto smem_layout_b = take<0,2>(typename CollectiveMma::SmemLayoutB{});
+
+  MainloopSwizzleSearch search;
+  search.a = search_smem_swizzle(typename CollectiveMma::GmemTiledCopyA{},
+                                 make_tiled_copy_A(typename CollectiveMma::SmemCopyAtomA{}, TiledMma{}),
+                                 smem_layout_a, model, max_bits);
+  search.b = search_smem_swizzle(typename CollectiveMma::GmemTiledCopyB{},
+                                 make_tiled_copy_B(typename CollectiveMma::SmemCopyAtomB{}, TiledMma{}),
+                                 smem_layout_b, model, max_bits);
+  return search;
+}
+
+/// SmemSwizzle type that makes the MP22 CollectiveBuilder compose swizzle_a and swizzle_b with its
+/// shared memory atoms, for use as its SmemSwizzleType parameter
+inline std::string smem_swizzle_type(SwizzleParams const &swizzle_a, SwizzleParams const &swizzle_b) {
+  std::ostringstream out;
+  out << "mutlass::gemm::collective::SmemSwizzle<" << swizzle_a << ", " << swizzle_b << ">";
+  return out.str();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace analysis
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
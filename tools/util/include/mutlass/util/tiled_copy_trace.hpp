@@ -0,0 +1,145 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Moore Threads Technology Co., Ltd("Moore Threads"). All rights reserved.
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Replays the per-thread element offsets a MuTe TiledCopy accesses in a layout.
+
+    Shared by the host-side shared memory and global memory access analyses.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "mute/tensor.hpp"
+#include "mute/atom/copy_atom.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace mutlass {
+namespace analysis {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Element offsets accessed by a TiledCopy, indexed [thread][instruction][value]. An instruction
+/// is one call of the copy atom, its values are those the atom moves for one thread.
+using TiledCopyTrace = std::vector<std::vector<std::vector<int64_t>>>;
+
+/// Maps every thread's partition of the rank-2 tile described by layout through layout. If
+/// IsSource, the source partitioning of tiled_copy is replayed, otherwise the destination one.
+template <bool IsSource, class TiledCopy, class Layout>
+TiledCopyTrace trace_tiled_copy(TiledCopy const &tiled_copy, Layout const &layout) {
+  using namespace mute;
+
+  static_assert(rank_v<Layout> == 2, "The layout must be rank 2.");
+
+  int const num_threads = size<0>(typename TiledCopy::TiledLayout_TV{});
+
+  // Coordinates of the tile each thread partition refers to
+  Tensor coord = make_identity_tensor(product_each(shape(layout)));
+
+  TiledCopyTrace trace(num_threads);
+  for (int thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+    auto thr_copy = tiled_copy.get_thread_slice(thread_idx);
+    Tensor part = [&]() {
+      if constexpr (IsSource) {
+        return thr_copy.partition_S(coord);
+      }
+      else {
+        return thr_copy.partition_D(coord);
+      }
+    }();
+    Tensor part_flat = group_modes<1, rank_v<decltype(part)>>(part);       // (CPY,REST)
+
+    auto &thread_trace = trace[thread_idx];
+    thread_trace.resize(size<1>(part_flat));
+    for (int inst = 0; inst < size<1>(part_flat); ++inst) {
+      for (int v = 0; v < size<0>(part_flat); ++v) {
+        auto c = part_flat(v, inst);
+        thread_trace[inst].push_back(int64_t(layout(get<0>(c), get<1>(c))));
+      }
+    }
+  }
+
+  return trace;
+}
+
+/// Width, in elements, of the accesses a thread issues for one copy instruction. The values are
+/// vectorized when their offsets are contiguous and aligned to the vector width; the register
+/// side is assumed contiguous.
+inline int vector_elements(std::vector<int64_t> const &offsets, int element_bytes, int max_vector_bytes) {
+  int const values = int(offsets.size());
+  int width = 1;
+  for (int candidate = 2; candidate <= values && candidate * element_bytes <= max_vector_bytes; candidate *= 2) {
+    if (values % candidate != 0) {
+      break;
+    }
+    bool vectorizes = true;
+    for (int begin = 0; vectorizes && begin < values; begin += candidate) {
+      vectorizes = (offsets[begin] % candidate) == 0;
+      for (int i = 1; vectorizes && i < candidate; ++i) {
+        vectorizes = offsets[begin + i] == offsets[begin] + i;
+      }
+    }
+    if (!vectorizes) {
+      break;
+    }
+    width = candidate;
+  }
+  return width;
+}
+
+/// Vector width, in elements, of one instruction issued by threads [thread_begin, thread_end)
+/// together. All of them execute the same instruction, so it is only as wide as the narrowest.
+inline int warp_vector_elements(
+  TiledCopyTrace const &trace,
+  int thread_begin,
+  int thread_end,
+  int inst,
+  int element_bytes,
+  int max_vector_bytes) {
+
+  int vector = std::max(1, max_vector_bytes / element_bytes);
+  for (int thread_idx = thread_begin; thread_idx < thread_end; ++thread_idx) {
+    vector = std::min(vector, vector_elements(trace[thread_idx][inst], element_bytes, max_vector_bytes));
+  }
+  return std::max(vector, 1);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace analysis
+} // namespace mutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////